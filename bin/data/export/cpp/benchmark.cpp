@@ -0,0 +1,180 @@
+// headless benchmark - built when SED_BENCHMARK is defined (see the *_benchmark target in CMakeLists.txt)
+// usage: app_benchmark [--frames N] [--warmup N] [--width W] [--height H] [--timestep seconds] [--output file.json]
+// no display needed with SDL_VIDEODRIVER=offscreen (or run it under xvfb-run)
+#ifdef SED_BENCHMARK
+#include <algorithm>
+
+struct BenchmarkSettings {
+	int Frames = 300;
+	int Warmup = 10;
+	int Width = 1280, Height = 720;
+	float TimeStep = 1.0f / 60.0f;
+	std::string Output = "";
+};
+struct BenchmarkStats {
+	double Mean = 0, Median = 0, Min = 0, Max = 0;
+};
+
+class BenchmarkTimer {
+public:
+	static const int Latency = 4; // query results are read a few frames later to avoid stalls
+
+	int Frame = 0;
+
+	void Init(const BenchmarkSettings& settings)
+	{
+		m_warmup = settings.Warmup;
+		m_queries.resize(Latency * sedPassCount);
+		if (!m_queries.empty())
+			glGenQueries(m_queries.size(), m_queries.data());
+		m_passTimes.resize(sedPassCount);
+	}
+	bool IsRunning(const BenchmarkSettings& settings) { return Frame < settings.Warmup + settings.Frames; }
+
+	void BeginFrame() { m_frameStart = std::chrono::high_resolution_clock::now(); }
+	void BeginPass(int index) { glBeginQuery(GL_TIME_ELAPSED, m_queries[(Frame % Latency) * sedPassCount + index]); }
+	void EndPass(int index) { glEndQuery(GL_TIME_ELAPSED); }
+	void EndFrame()
+	{
+		double cpuTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_frameStart).count();
+		if (Frame >= m_warmup)
+			m_cpuTimes.push_back(cpuTime);
+
+		Frame++;
+
+		// the next frame reuses these queries
+		if (Frame >= Latency)
+			m_collect(Frame - Latency);
+	}
+	void Finish()
+	{
+		for (int i = std::max(0, Frame - Latency + 1); i < Frame; i++)
+			m_collect(i);
+		if (!m_queries.empty())
+			glDeleteQueries(m_queries.size(), m_queries.data());
+	}
+
+	std::string ToJSON(const BenchmarkSettings& settings)
+	{
+		std::string ret = "{\n";
+		ret += "\t\"frames\": " + std::to_string(settings.Frames) + ",\n";
+		ret += "\t\"warmup\": " + std::to_string(settings.Warmup) + ",\n";
+		ret += "\t\"width\": " + std::to_string(settings.Width) + ",\n";
+		ret += "\t\"height\": " + std::to_string(settings.Height) + ",\n";
+		ret += "\t\"timeStep\": " + std::to_string(settings.TimeStep) + ",\n";
+		ret += "\t\"renderer\": \"" + m_escape((const char*)glGetString(GL_RENDERER)) + "\",\n";
+		ret += "\t\"version\": \"" + m_escape((const char*)glGetString(GL_VERSION)) + "\",\n";
+		ret += "\t\"cpuFrameTime\": " + m_statsToJSON(m_cpuTimes) + ",\n";
+		ret += "\t\"gpuFrameTime\": " + m_statsToJSON(m_gpuTimes) + ",\n";
+		ret += "\t\"passes\": [\n";
+		for (int i = 0; i < sedPassCount; i++) {
+			ret += "\t\t{ \"name\": \"" + m_escape(sedPassNames[i]) + "\", \"gpuTime\": " + m_statsToJSON(m_passTimes[i]) + " }";
+			ret += (i == sedPassCount - 1) ? "\n" : ",\n";
+		}
+		ret += "\t]\n";
+		ret += "}\n";
+		return ret;
+	}
+
+private:
+	void m_collect(int frame)
+	{
+		if (frame < m_warmup)
+			return;
+
+		double total = 0.0;
+		for (int i = 0; i < sedPassCount; i++) {
+			GLuint64 ns = 0;
+			glGetQueryObjectui64v(m_queries[(frame % Latency) * sedPassCount + i], GL_QUERY_RESULT, &ns);
+			m_passTimes[i].push_back(ns / 1000000.0);
+			total += ns / 1000000.0;
+		}
+		m_gpuTimes.push_back(total);
+	}
+	std::string m_statsToJSON(std::vector<double> times)
+	{
+		BenchmarkStats stats;
+		if (!times.empty()) {
+			std::sort(times.begin(), times.end());
+			for (double t : times)
+				stats.Mean += t;
+			stats.Mean /= times.size();
+			stats.Median = times[times.size() / 2];
+			stats.Min = times.front();
+			stats.Max = times.back();
+		}
+
+		return "{ \"mean\": " + std::to_string(stats.Mean) + ", \"median\": " + std::to_string(stats.Median) + ", \"min\": " + std::to_string(stats.Min) + ", \"max\": " + std::to_string(stats.Max) + " }";
+	}
+	std::string m_escape(const char* str)
+	{
+		std::string ret;
+		for (; str != nullptr && *str != 0; str++) {
+			if (*str == '"' || *str == '\\')
+				ret += '\\';
+			ret += *str;
+		}
+		return ret;
+	}
+
+	int m_warmup = 0;
+	std::vector<GLuint> m_queries;
+	std::vector<std::vector<double>> m_passTimes; // in milliseconds
+	std::vector<double> m_gpuTimes, m_cpuTimes;
+	std::chrono::time_point<std::chrono::high_resolution_clock> m_frameStart;
+};
+BenchmarkTimer sedBenchmark;
+
+bool ParseBenchmarkArguments(int argc, char* argv[], BenchmarkSettings& settings)
+{
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--frames" && hasValue)
+			settings.Frames = std::max(1, atoi(argv[++i]));
+		else if (arg == "--warmup" && hasValue)
+			settings.Warmup = std::max(0, atoi(argv[++i]));
+		else if (arg == "--width" && hasValue)
+			settings.Width = std::max(1, atoi(argv[++i]));
+		else if (arg == "--height" && hasValue)
+			settings.Height = std::max(1, atoi(argv[++i]));
+		else if (arg == "--timestep" && hasValue)
+			settings.TimeStep = atof(argv[++i]);
+		else if (arg == "--output" && hasValue)
+			settings.Output = argv[++i];
+		else {
+			printf("Unknown argument: %s\n", arg.c_str());
+			printf("usage: %s [--frames N] [--warmup N] [--width W] [--height H] [--timestep seconds] [--output file.json]\n", argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+GLuint CreateBenchmarkTarget(int width, int height, GLuint& color, GLuint& depth)
+{
+	glGenTextures(1, &color);
+	glBindTexture(GL_TEXTURE_2D, color);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+	glGenTextures(1, &depth);
+	glBindTexture(GL_TEXTURE_2D, depth);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	GLuint fbo = 0;
+	glGenFramebuffers(1, &fbo);
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depth, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	return fbo;
+}
+
+#define BENCHMARK_BEGIN_PASS(index) sedBenchmark.BeginPass(index)
+#define BENCHMARK_END_PASS(index) sedBenchmark.EndPass(index)
+#else
+#define BENCHMARK_BEGIN_PASS(index)
+#define BENCHMARK_END_PASS(index)
+#endif
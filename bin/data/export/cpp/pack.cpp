@@ -0,0 +1,94 @@
+// packed assets
+std::vector<char> sedPack;
+bool sedUseSPIRV = false;
+
+bool LoadPack(const std::string& filename, size_t expectedSize)
+{
+	FILE* file = fopen(filename.c_str(), "rb");
+	if (file == nullptr) {
+		printf("Failed to open %s\n", filename.c_str());
+		return false;
+	}
+
+	sedPack.resize(expectedSize);
+	size_t readSize = fread(sedPack.data(), 1, expectedSize, file);
+	fclose(file);
+
+	if (readSize != expectedSize || memcmp(sedPack.data(), "SEDPACK1", 8) != 0) {
+		printf("%s is corrupted or doesn't belong to this executable\n", filename.c_str());
+		return false;
+	}
+
+	return true;
+}
+GLuint LoadPackedTexture(size_t offset, size_t size, int width, int height)
+{
+	// pixels are stored already decoded (RGBA8) and compressed with zlib
+	std::vector<char> pixels(width * height * 4);
+	if (stbi_zlib_decode_buffer(pixels.data(), pixels.size(), sedPack.data() + offset, size) != (int)pixels.size()) {
+		printf("Failed to decompress a texture\n");
+		return 0;
+	}
+
+	GLuint ret = 0;
+	glGenTextures(1, &ret);
+	glBindTexture(GL_TEXTURE_2D, ret);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return ret;
+}
+GLuint CreatePackedSPIRVShader(GLenum type, size_t offset, size_t size, const char* entry)
+{
+	GLuint shader = glCreateShader(type);
+	glShaderBinary(1, &shader, GL_SHADER_BINARY_FORMAT_SPIR_V_ARB, sedPack.data() + offset, size);
+	glSpecializeShaderARB(shader, entry, 0, nullptr, nullptr);
+
+	GLint success = 0;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success) {
+		glDeleteShader(shader);
+		return 0;
+	}
+
+	return shader;
+}
+GLuint CreatePackedShader(size_t vsOffset, size_t vsSize, const char* vsEntry, size_t psOffset, size_t psSize, const char* psEntry, size_t vsSrcOffset, size_t vsSrcSize, size_t psSrcOffset, size_t psSrcSize, bool& usesSPIRV)
+{
+	usesSPIRV = false;
+
+	// SPIR-V - no compilation at startup
+	if (sedUseSPIRV && vsSize != 0 && psSize != 0) {
+		GLuint vs = CreatePackedSPIRVShader(GL_VERTEX_SHADER, vsOffset, vsSize, vsEntry);
+		GLuint ps = CreatePackedSPIRVShader(GL_FRAGMENT_SHADER, psOffset, psSize, psEntry);
+
+		if (vs != 0 && ps != 0) {
+			GLuint ret = glCreateProgram();
+			glAttachShader(ret, vs);
+			glAttachShader(ret, ps);
+			glLinkProgram(ret);
+
+			GLint success = 0;
+			glGetProgramiv(ret, GL_LINK_STATUS, &success);
+
+			glDeleteShader(vs);
+			glDeleteShader(ps);
+
+			if (success) {
+				usesSPIRV = true;
+				return ret;
+			}
+			glDeleteProgram(ret);
+		} else {
+			if (vs != 0) glDeleteShader(vs);
+			if (ps != 0) glDeleteShader(ps);
+		}
+	}
+
+	// GLSL fallback
+	std::string vsCode(sedPack.data() + vsSrcOffset, vsSrcSize);
+	std::string psCode(sedPack.data() + psSrcOffset, psSrcSize);
+	return CreateShader(vsCode.c_str(), psCode.c_str());
+}
@@ -1,6 +1,9 @@
 #include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include <GL/glew.h>
 #include <SDL2/SDL.h>
@@ -33,10 +36,31 @@ GLuint LoadTexture(const std::string& filename);
 
 const GLenum FBO_Buffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3, GL_COLOR_ATTACHMENT4, GL_COLOR_ATTACHMENT5, GL_COLOR_ATTACHMENT6, GL_COLOR_ATTACHMENT7, GL_COLOR_ATTACHMENT8, GL_COLOR_ATTACHMENT9, GL_COLOR_ATTACHMENT10, GL_COLOR_ATTACHMENT11, GL_COLOR_ATTACHMENT12, GL_COLOR_ATTACHMENT13, GL_COLOR_ATTACHMENT14, GL_COLOR_ATTACHMENT15 };
 
-int main()
+[$$pack$$]
+
+[$$benchmark$$]
+
+int main(int argc, char* argv[])
 {
 	stbi_set_flip_vertically_on_load(1);
 
+	// required:
+	float sedWindowWidth = 800, sedWindowHeight = 600;
+	float sedMouseX = 0, sedMouseY = 0;
+	GLuint sedOutputFBO = 0; // passes that render to the window use this framebuffer
+
+	Uint32 windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
+
+#ifdef SED_BENCHMARK
+	BenchmarkSettings benchSettings;
+	if (!ParseBenchmarkArguments(argc, argv, benchSettings))
+		return 1;
+
+	sedWindowWidth = benchSettings.Width;
+	sedWindowHeight = benchSettings.Height;
+	windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN;
+#endif
+
 	// init sdl2
 	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_AUDIO) < 0) {
 		printf("Failed to initialize SDL2\n");
@@ -49,7 +73,7 @@ int main()
 	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1); // double buffering
 
 	// open window
-	SDL_Window* wnd = SDL_CreateWindow("ShaderProject", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 800, 600, SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
+	SDL_Window* wnd = SDL_CreateWindow("ShaderProject", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, sedWindowWidth, sedWindowHeight, windowFlags);
 	SDL_SetWindowMinimumSize(wnd, 200, 200);
 
 	// get GL context
@@ -65,9 +89,12 @@ int main()
 		return 0;
 	}
 
-	// required:
-	float sedWindowWidth = 800, sedWindowHeight = 600;
-	float sedMouseX = 0, sedMouseY = 0;
+#ifdef SED_BENCHMARK
+	// render offscreen
+	GLuint benchColor = 0, benchDepth = 0;
+	sedOutputFBO = CreateBenchmarkTarget(sedWindowWidth, sedWindowHeight, benchColor, benchDepth);
+	sedBenchmark.Init(benchSettings);
+#endif
 
 	std::chrono::time_point<std::chrono::system_clock> timerStart = std::chrono::system_clock::now();
 
@@ -92,9 +119,14 @@ int main()
 			}
 		}
 
+#ifdef SED_BENCHMARK
+		run = run && sedBenchmark.IsRunning(benchSettings);
+		sedBenchmark.BeginFrame();
+#endif
+
 		if (!run) break;
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glBindFramebuffer(GL_FRAMEBUFFER, sedOutputFBO);
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 		glViewport(0, 0, sedWindowWidth, sedWindowHeight);
@@ -104,13 +136,34 @@ int main()
 
 			float curTime
 			= std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - timerStart).count() / 1000000.0f;
+#ifdef SED_BENCHMARK
+		// fixed time step so that every run renders the same frames
+		sedBenchmark.EndFrame();
+		curTime = sedBenchmark.Frame * benchSettings.TimeStep;
+#endif
 		sysTimeDelta = curTime - sysTime;
 		sysTime = curTime;
 		sysFrameIndex++;
 
+#ifdef SED_BENCHMARK
+		glFlush();
+#else
 		SDL_GL_SwapWindow(wnd);
+#endif
 	}
 
+#ifdef SED_BENCHMARK
+	sedBenchmark.Finish();
+
+	std::string benchResults = sedBenchmark.ToJSON(benchSettings);
+	printf("%s", benchResults.c_str());
+	if (!benchSettings.Output.empty()) {
+		std::ofstream benchWriter(benchSettings.Output);
+		benchWriter << benchResults;
+		benchWriter.close();
+	}
+#endif
+
 	// sdl2
 	SDL_GL_DeleteContext(glContext);
 	SDL_DestroyWindow(wnd);
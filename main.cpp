@@ -7,7 +7,7 @@
 #include <SHADERed/Objects/CommandLineOptionParser.h>
 #include <SHADERed/Objects/Logger.h>
 #include <SHADERed/Objects/Settings.h>
-#include <glslang/Public/ShaderLang.h>
+#include <SHADERed/Objects/StartupTrace.h>
 
 #include <chrono>
 #include <filesystem>
@@ -42,6 +42,9 @@ void SetDpiAware();
 
 int main(int argc, char* argv[])
 {
+	ed::StartupTrace& startupTrace = ed::StartupTrace::Instance();
+	startupTrace.Begin("command line & directories");
+
 	srand(time(NULL));
 
 	std::filesystem::path cmdDir = std::filesystem::current_path();
@@ -56,8 +59,10 @@ int main(int argc, char* argv[])
 
 	ed::CommandLineOptionParser coptsParser;
 	coptsParser.Parse(cmdDir, argc - 1, argv + 1);
-	if (!coptsParser.LaunchUI)
-		return 0;
+	if (!coptsParser.LaunchUI && !coptsParser.Validate)
+		return coptsParser.ExitCode;
+	if (coptsParser.TraceStartup)
+		startupTrace.Enable(coptsParser.TraceStartupFile);
 
 #if defined(__linux__) || defined(__unix__)
 	bool linuxUseHomeDir = false;
@@ -113,6 +118,14 @@ int main(int argc, char* argv[])
 	// create data directory on startup
 	if (!std::filesystem::exists("./data/"))
 		std::filesystem::create_directory("./data/");
+
+	// --validate doesn't open a window but still uses the HLSL/Vulkan GLSL extensions from the settings
+	if (coptsParser.Validate) {
+		ed::Settings::Instance().Load();
+		ed::Settings::Instance().General.PipeLogsToTerminal = false; // the report can go to stdout
+		coptsParser.RunValidator();
+		return coptsParser.ExitCode;
+	}
 	if (!ed::Settings::Instance().LinuxHomeDirectory.empty() && !std::filesystem::exists(ed::Settings::Instance().LinuxHomeDirectory + "data/"))
 		std::filesystem::create_directory(ed::Settings::Instance().LinuxHomeDirectory + "data/");
 
@@ -133,24 +146,22 @@ int main(int argc, char* argv[])
 	stbi_flip_vertically_on_write(1);
 	stbi_set_flip_vertically_on_load(1);
 
-	// start glslang process
-	bool glslangInit = glslang::InitializeProcess();
-	ed::Logger::Get().Log("Initializing glslang...");
+	startupTrace.End();
 
-	if (glslangInit)
-		ed::Logger::Get().Log("Finished glslang initialization");
-	else
-		ed::Logger::Get().Log("Failed to initialize glslang", true);
+	// glslang is initialized on the first compile (see ShaderCompiler)
 
 	// init sdl2
+	startupTrace.Begin("SDL2");
 	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_AUDIO) < 0) {
 		ed::Logger::Get().Log("Failed to initialize SDL2", true);
 		ed::Logger::Get().Save();
 		return 0;
 	} else
 		ed::Logger::Get().Log("Initialized SDL2");
+	startupTrace.End();
 
 	// load window size
+	startupTrace.Begin("window");
 	std::string preloadDatPath = "data/preload.dat";
 	if (!ed::Settings::Instance().LinuxHomeDirectory.empty() && std::filesystem::exists(ed::Settings::Instance().LinuxHomeDirectory + preloadDatPath))
 		preloadDatPath = ed::Settings::Instance().LinuxHomeDirectory + preloadDatPath;
@@ -211,7 +222,10 @@ int main(int argc, char* argv[])
 	if (fullscreen)
 		SDL_SetWindowFullscreen(wnd, SDL_WINDOW_FULLSCREEN_DESKTOP);
 
+	startupTrace.End();
+
 	// get GL context
+	startupTrace.Begin("OpenGL context & GLEW");
 	SDL_GLContext glContext = SDL_GL_CreateContext(wnd);
 	SDL_GL_MakeCurrent(wnd, glContext);
 	glEnable(GL_DEPTH_TEST);
@@ -225,20 +239,27 @@ int main(int argc, char* argv[])
 		return 0;
 	} else
 		ed::Logger::Get().Log("Initialized GLEW");
+	startupTrace.End();
 
 	// create engine
+	startupTrace.Begin("EditorEngine");
 	ed::EditorEngine engine(wnd, &glContext);
 	ed::Logger::Get().Log("Creating EditorEngine...");
 	engine.Create();
 	ed::Logger::Get().Log("Created EditorEngine");
+	startupTrace.End();
 
 	// set window icon:
+	startupTrace.Begin("window icon");
 	SetIcon(wnd);
+	startupTrace.End();
 
 	// open an item if given in arguments
 	if (!coptsParser.ProjectFile.empty()) {
 		ed::Logger::Get().Log("Opening a file provided through argument " + coptsParser.ProjectFile);
+		startupTrace.Begin("open " + coptsParser.ProjectFile);
 		engine.UI().Open(coptsParser.ProjectFile);
+		startupTrace.End();
 	}
 
 	engine.UI().SetPerformanceMode(perfMode);
@@ -251,6 +272,7 @@ int main(int argc, char* argv[])
 	bool run = true;
 	bool minimized = false;
 	bool hasFocus = true;
+	bool firstFrame = true;
 	while (run) {
 		while (SDL_PollEvent(&event)) {
 			if (event.type == SDL_QUIT) {
@@ -310,6 +332,7 @@ int main(int argc, char* argv[])
 		if (!run) break;
 
 		float delta = timer.Restart();
+		bool splashScreen = engine.UI().IsSplashScreenActive();
 		engine.Update(delta);
 
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -319,6 +342,16 @@ int main(int argc, char* argv[])
 		engine.Render();
 		SDL_GL_SwapWindow(wnd);
 
+		// first frame with the actual UI (splash screen doesn't accept input)
+		if (!startupTrace.IsFinished()) {
+			if (!splashScreen) {
+				startupTrace.Finish();
+				run = !coptsParser.QuitAfterStartup;
+			} else if (firstFrame)
+				startupTrace.Mark("first frame (splash screen)");
+		}
+		firstFrame = false;
+
 		if (minimized && delta * 1000 < 33)
 			std::this_thread::sleep_for(std::chrono::milliseconds(33 - (int)(delta * 1000)));
 		else if (!hasFocus && ed::Settings::Instance().Preview.LostFocusLimitFPS && delta * 1000 < 16)
@@ -21,9 +21,9 @@ namespace ed {
 			Vertices = vertices;
 			Indices = indices;
 			Textures = textures;
-			m_setup();
+			VAO = VBO = EBO = 0;
 		}
-		void Model::Mesh::m_setup()
+		void Model::Mesh::Upload()
 		{
 			glGenVertexArrays(1, &VAO);
 			glGenBuffers(1, &VBO);
@@ -73,6 +73,26 @@ namespace ed {
 		}
 
 		bool Model::LoadFromFile(const std::string& path)
+		{
+			bool ret = ImportFromFile(path);
+			if (ret)
+				Upload();
+			return ret;
+		}
+		bool Model::LoadFromMemory(const char* data, size_t size, const std::string& path)
+		{
+			bool ret = ImportFromMemory(data, size, path);
+			if (ret)
+				Upload();
+			return ret;
+		}
+		void Model::Upload()
+		{
+			for (auto& mesh : Meshes)
+				if (mesh.VAO == 0)
+					mesh.Upload();
+		}
+		bool Model::ImportFromFile(const std::string& path)
 		{
 			ed::Logger::Get().Log("Loading a 3D model " + path);
 
@@ -94,6 +114,27 @@ namespace ed {
 
 			return true;
 		}
+		bool Model::ImportFromMemory(const char* data, size_t size, const std::string& path)
+		{
+			ed::Logger::Get().Log("Loading a 3D model " + path + " from memory");
+
+			std::string hint = path.substr(path.find_last_of('.') + 1);
+
+			Assimp::Importer importer;
+			const aiScene* scene = importer.ReadFileFromMemory(data, size, aiProcess_Triangulate | aiProcess_FlipUVs, hint.c_str());
+
+			if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+				ed::Logger::Get().Log("Assimp has detected an error \"" + std::string(importer.GetErrorString()) + "\"", true);
+				return false;
+			}
+
+			Directory = path.substr(0, path.find_last_of("/\\"));
+			m_processNode(scene->mRootNode, scene);
+
+			m_findBounds();
+
+			return true;
+		}
 		void Model::m_findBounds()
 		{
 			m_minBound = glm::vec3(std::numeric_limits<float>::infinity());
@@ -34,11 +34,9 @@ namespace ed {
 				Mesh(const std::string& name, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const std::vector<Texture>& textures);
 
 				void Draw(bool instanced = false, int iCount = 0);
+				void Upload(); // creates the GPU buffers
 
 				unsigned int VAO, VBO, EBO;
-
-			private:
-				void m_setup();
 			};
 
 			~Model();
@@ -48,6 +46,12 @@ namespace ed {
 
 			std::vector<std::string> GetMeshNames();
 			bool LoadFromFile(const std::string& path);
+			bool LoadFromMemory(const char* data, size_t size, const std::string& path); // path is only used as a format hint
+
+			// Import*() only read the mesh data (safe to call from worker threads), Upload() must then be called on the GL thread
+			bool ImportFromFile(const std::string& path);
+			bool ImportFromMemory(const char* data, size_t size, const std::string& path);
+			void Upload();
 			void Draw(bool instanced = false, int iCount = 0);
 			void Draw(const std::string& mesh);
 
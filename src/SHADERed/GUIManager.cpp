@@ -9,7 +9,10 @@
 #include <SHADERed/Objects/Names.h>
 #include <SHADERed/Objects/Settings.h>
 #include <SHADERed/Objects/SPIRVParser.h>
+#include <SHADERed/Objects/SPIRVReflectionCache.h>
 #include <SHADERed/Objects/ShaderCompiler.h>
+#include <SHADERed/Objects/StartupTrace.h>
+#include <SHADERed/Objects/StreamingUploader.h>
 #include <SHADERed/Objects/SystemVariableManager.h>
 #include <SHADERed/Objects/ThemeContainer.h>
 #include <SHADERed/UI/CodeEditorUI.h>
@@ -67,6 +70,7 @@ namespace ed {
 		m_data = objects;
 		m_wnd = wnd;
 		m_gl = gl;
+		m_progressContext = nullptr;
 		m_settingsBkp = new Settings();
 		m_previewSaveSize = glm::ivec2(1920, 1080);
 		m_savePreviewPopupOpened = false;
@@ -103,6 +107,8 @@ namespace ed {
 		m_expcppImage = true;
 		m_expcppMemoryShaders = true;
 		m_expcppCopyImages = true;
+		m_expcppPackAssets = false;
+		m_expcppBenchmark = false;
 		memset(&m_expcppProjectName[0], 0, 64 * sizeof(char));
 		strcpy(m_expcppProjectName, "ShaderProject");
 		m_expcppSavePath = "./export.cpp";
@@ -130,8 +136,10 @@ namespace ed {
 		if (!ed::Settings::Instance().LinuxHomeDirectory.empty())
 			m_uiIniFile = ed::Settings::Instance().LinuxHomeDirectory + m_uiIniFile;
 
+		StartupTrace::Instance().Begin("settings & templates");
 		Settings::Instance().Load();
 		m_loadTemplateList();
+		StartupTrace::Instance().End();
 
 		SDL_GetWindowSize(m_wnd, &m_width, &m_height);
 
@@ -141,6 +149,7 @@ namespace ed {
 		SDL_GL_SetSwapInterval(Settings::Instance().General.VSync);
 
 		// Initialize imgui
+		StartupTrace::Instance().Begin("Dear ImGui");
 		ImGui::CreateContext();
 
 		ImGuiIO& io = ImGui::GetIO();
@@ -161,8 +170,10 @@ namespace ed {
 		ImGui_ImplSDL2_InitForOpenGL(m_wnd, *m_gl);
 
 		ImGui::StyleColorsDark();
+		StartupTrace::Instance().End();
 
 		Logger::Get().Log("Creating various UI view objects");
+		StartupTrace::Instance().Begin("UI views");
 
 		m_views.push_back(new PreviewUI(this, objects, "Preview"));
 		m_views.push_back(new PinnedUI(this, objects, "Pinned"));
@@ -180,8 +191,12 @@ namespace ed {
 		m_debugViews.push_back(new DebugVectorWatchUI(this, objects, "Vector watch"));
 		m_debugViews.push_back(new DebugImmediateUI(this, objects, "Immediate"));
 
+		StartupTrace::Instance().End();
+
+		StartupTrace::Instance().Begin("keyboard shortcuts");
 		KeyboardShortcuts::Instance().Load();
 		m_setupShortcuts();
+		StartupTrace::Instance().End();
 
 		m_options = new OptionsUI(this, objects, "Options");
 		m_createUI = new CreateItemUI(this, objects);
@@ -205,9 +220,14 @@ namespace ed {
 
 		ImGui::GetStyle().ScaleAllSizes(Settings::Instance().DPIScale);
 
+		StartupTrace::Instance().Begin("theme");
 		((OptionsUI*)m_options)->ApplyTheme();
+		StartupTrace::Instance().End();
 
 		FunctionVariableManager::Instance().Initialize(&objects->Pipeline);
+		m_data->Parser.GetLoader().SetProgressCallback([&](const std::string& status, float progress) {
+			m_renderLoadingProgress(status, progress);
+		});
 		m_data->Renderer.Pause(Settings::Instance().Preview.PausedOnStartup);
 
 		m_kbInfo.SetText(std::string(KEYBOARD_KEYCODES_TEXT));
@@ -218,6 +238,7 @@ namespace ed {
 		m_kbInfo.SetReadOnly(true);
 
 		// load snippets
+		StartupTrace::Instance().Begin("snippets & bookmarks");
 		((CodeEditorUI*)Get(ViewID::Code))->LoadSnippets();
 
 		// load file dialog bookmarks
@@ -227,9 +248,12 @@ namespace ed {
 		std::ifstream bookmarksFile(bookmarksFileLoc);
 		std::string bookmarksString((std::istreambuf_iterator<char>(bookmarksFile)), std::istreambuf_iterator<char>());
 		igfd::ImGuiFileDialog::Instance()->DeserializeBookmarks(bookmarksString);
+		StartupTrace::Instance().End();
 
 		// setup splash screen
+		StartupTrace::Instance().Begin("splash screen");
 		m_splashScreenLoad();
+		StartupTrace::Instance().End();
 
 		// load recents
 		std::string currentInfoPath = "info.dat";
@@ -252,6 +276,7 @@ namespace ed {
 	GUIManager::~GUIManager()
 	{
 		glDeleteShader(Magnifier::Shader);
+		StreamingUploader::Instance().Release();
 
 		for (int i = 0; i < m_onlineShaderThumbnail.size(); i++)
 			glDeleteTextures(1, &m_onlineShaderThumbnail[i]);
@@ -284,6 +309,9 @@ namespace ed {
 		delete m_createUI;
 		delete m_settingsBkp;
 
+		if (m_progressContext != nullptr)
+			ImGui::DestroyContext(m_progressContext);
+
 		ImGui_ImplSDL2_Shutdown();
 		ImGui_ImplOpenGL3_Shutdown();
 		ImGui::DestroyContext();
@@ -322,7 +350,7 @@ namespace ed {
 
 				const std::vector<std::string> imgExt = { "png", "jpeg", "jpg", "bmp", "gif", "psd", "pic", "pnm", "hdr", "tga" };
 				const std::vector<std::string> sndExt = { "ogg", "wav", "flac", "aiff", "raw" }; // TODO: more file ext
-				const std::vector<std::string> projExt = { "sprj" };
+				const std::vector<std::string> projExt = { "sprj", "sprjz" };
 
 				if (std::count(projExt.begin(), projExt.end(), ext) > 0) {
 					bool cont = true;
@@ -501,6 +529,7 @@ namespace ed {
 			((CodeEditorUI*)Get(ViewID::Code))->EmptyTrackedFiles();
 		}
 		((CodeEditorUI*)Get(ViewID::Code))->UpdateAutoRecompileItems();
+		m_data->Renderer.FinishAsyncRecompiles();
 
 		// parse
 		if (!m_data->Renderer.SPIRVQueue.empty()) {
@@ -511,12 +540,16 @@ namespace ed {
 
 				PipelineItem* spvItem = spvQueue[i];
 
+				// parsed once the background SPIR-V arrives (it is queued again)
+				if (m_data->Renderer.IsSPIRVPending(spvItem))
+					continue;
+
 				if (i + 1 < spvQueue.size())
 					if (std::count(spvQueue.begin() + i + 1, spvQueue.end(), spvItem) > 0)
 						hasDups = true;
 			
 				if (!hasDups) {
-					SPIRVParser spvParser;
+					SPIRVReflectionCache& reflection = SPIRVReflectionCache::Instance();
 					if (spvItem->Type == PipelineItem::ItemType::ShaderPass) {
 						pipe::ShaderPass* pass = (pipe::ShaderPass*)spvItem->Data;
 						std::vector<std::string> allUniforms;
@@ -525,39 +558,39 @@ namespace ed {
 
 						if (pass->PSSPV.size() > 0) {
 							int langID = -1;
-							IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->PSPath, m_data->Plugins.Plugins());
+							IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->PSPath, &m_data->Plugins);
 
 							deleteUnusedVariables &= (plugin == nullptr || (plugin != nullptr && plugin->CustomLanguage_SupportsAutoUniforms(langID)));
 
-							spvParser.Parse(pass->PSSPV);
+							std::shared_ptr<const SPIRVParser> spvParser = reflection.Get(pass->PSSPV);
 							TextEditor* tEdit = codeEditor->Get(spvItem, ed::ShaderStage::Pixel);
-							if (tEdit != nullptr) codeEditor->FillAutocomplete(tEdit, spvParser);
+							if (tEdit != nullptr) codeEditor->FillAutocomplete(tEdit, *spvParser);
 							if (settings.General.AutoUniforms && (plugin == nullptr || (plugin != nullptr && plugin->CustomLanguage_SupportsAutoUniforms(langID))))
-								m_autoUniforms(pass->Variables, spvParser, allUniforms);
+								m_autoUniforms(pass->Variables, *spvParser, allUniforms);
 						}
 						if (pass->VSSPV.size() > 0) {
 							int langID = -1;
-							IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->VSPath, m_data->Plugins.Plugins());
+							IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->VSPath, &m_data->Plugins);
 
 							deleteUnusedVariables &= (plugin == nullptr || (plugin != nullptr && plugin->CustomLanguage_SupportsAutoUniforms(langID)));
 
-							spvParser.Parse(pass->VSSPV);
+							std::shared_ptr<const SPIRVParser> spvParser = reflection.Get(pass->VSSPV);
 							TextEditor* tEdit = codeEditor->Get(spvItem, ed::ShaderStage::Vertex);
-							if (tEdit != nullptr) codeEditor->FillAutocomplete(tEdit, spvParser);
+							if (tEdit != nullptr) codeEditor->FillAutocomplete(tEdit, *spvParser);
 							if (settings.General.AutoUniforms && (plugin == nullptr || (plugin != nullptr && plugin->CustomLanguage_SupportsAutoUniforms(langID))))
-								m_autoUniforms(pass->Variables, spvParser, allUniforms);
+								m_autoUniforms(pass->Variables, *spvParser, allUniforms);
 						}
 						if (pass->GSSPV.size() > 0) {
 							int langID = -1;
-							IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->GSPath, m_data->Plugins.Plugins());
+							IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->GSPath, &m_data->Plugins);
 
 							deleteUnusedVariables &= (plugin == nullptr || (plugin != nullptr && plugin->CustomLanguage_SupportsAutoUniforms(langID)));
 
-							spvParser.Parse(pass->GSSPV);
+							std::shared_ptr<const SPIRVParser> spvParser = reflection.Get(pass->GSSPV);
 							TextEditor* tEdit = codeEditor->Get(spvItem, ed::ShaderStage::Geometry);
-							if (tEdit != nullptr) codeEditor->FillAutocomplete(tEdit, spvParser);
+							if (tEdit != nullptr) codeEditor->FillAutocomplete(tEdit, *spvParser);
 							if (settings.General.AutoUniforms && (plugin == nullptr || (plugin != nullptr && plugin->CustomLanguage_SupportsAutoUniforms(langID))))
-								m_autoUniforms(pass->Variables, spvParser, allUniforms);
+								m_autoUniforms(pass->Variables, *spvParser, allUniforms);
 						}
 
 						if (settings.General.AutoUniforms && deleteUnusedVariables && settings.General.AutoUniformsDelete && pass->VSSPV.size() > 0 && pass->PSSPV.size() > 0 && ((pass->GSUsed && pass->GSSPV.size()>0) || !pass->GSUsed))
@@ -568,13 +601,13 @@ namespace ed {
 
 						if (pass->SPV.size() > 0) {
 							int langID = -1;
-							IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->Path, m_data->Plugins.Plugins());
+							IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->Path, &m_data->Plugins);
 
-							spvParser.Parse(pass->SPV);
+							std::shared_ptr<const SPIRVParser> spvParser = reflection.Get(pass->SPV);
 							TextEditor* tEdit = codeEditor->Get(spvItem, ed::ShaderStage::Compute);
-							if (tEdit != nullptr) codeEditor->FillAutocomplete(tEdit, spvParser);
+							if (tEdit != nullptr) codeEditor->FillAutocomplete(tEdit, *spvParser);
 							if (settings.General.AutoUniforms && (plugin == nullptr || (plugin != nullptr && plugin->CustomLanguage_SupportsAutoUniforms(langID)))) {
-								m_autoUniforms(pass->Variables, spvParser, allUniforms);
+								m_autoUniforms(pass->Variables, *spvParser, allUniforms);
 								if (settings.General.AutoUniformsDelete)
 									m_deleteUnusedUniforms(pass->Variables, allUniforms);
 							}
@@ -592,8 +625,7 @@ namespace ed {
 								unsigned int* spv = pass->Owner->PipelineItem_GetSPIRV(pass->Type, pass->PluginData, (plugin::ShaderStage)k);
 								std::vector<unsigned int> spvVec(spv, spv + spvSize);
 
-								spvParser.Parse(spvVec);
-								codeEditor->FillAutocomplete(tEdit, spvParser);
+								codeEditor->FillAutocomplete(tEdit, *reflection.Get(spvVec));
 							}
 						}
 					}
@@ -650,7 +682,7 @@ namespace ed {
 					}
 
 					if (cont)
-						igfd::ImGuiFileDialog::Instance()->OpenModal("OpenProjectDlg", "Open SHADERed project", "SHADERed project (*.sprj){.sprj},.*", ".");
+						igfd::ImGuiFileDialog::Instance()->OpenModal("OpenProjectDlg", "Open SHADERed project", "SHADERed project (*.sprj;*.sprjz){.sprj,.sprjz},.*", ".");
 				}
 				if (ImGui::BeginMenu("Open Recent")) {
 					int recentCount = 0;
@@ -1118,6 +1150,7 @@ namespace ed {
 					m_saveAsPreHandle();
 
 				std::string file = igfd::ImGuiFileDialog::Instance()->GetFilepathName();
+				((ObjectPreviewUI*)m_objectPrev)->SyncBuffers();
 				m_data->Parser.SaveAs(file, true);
 
 				// cache opened code editors
@@ -1269,7 +1302,7 @@ namespace ed {
 							ImGui::Text("%d download(s)", pluginInfo.Downloads);
 							ImGui::Text("by: %s", pluginInfo.Owner.c_str());
 
-							if (m_data->Plugins.GetPlugin(pluginInfo.ID) == nullptr && std::count(m_onlineInstalledPlugins.begin(), m_onlineInstalledPlugins.end(), pluginInfo.ID) == 0) {
+							if (!m_data->Plugins.IsInstalled(pluginInfo.ID) && std::count(m_onlineInstalledPlugins.begin(), m_onlineInstalledPlugins.end(), pluginInfo.ID) == 0) {
 								ImGui::PushID(i);
 								if (ImGui::Button("DOWNLOAD")) {
 									m_onlineInstalledPlugins.push_back(pluginInfo.ID); // since PluginManager's GetPlugin won't register it immediately
@@ -2070,7 +2103,7 @@ namespace ed {
 		}
 
 		// Export as C++ app
-		ImGui::SetNextWindowSize(ImVec2(Settings::Instance().CalculateSize(450), Settings::Instance().CalculateSize(300)));
+		ImGui::SetNextWindowSize(ImVec2(Settings::Instance().CalculateSize(450), Settings::Instance().CalculateSize(350)));
 		if (ImGui::BeginPopupModal("Export as C++ project##main_export_as_cpp")) {
 			// output file
 			ImGui::TextWrapped("Output file: %s", m_expcppSavePath.c_str());
@@ -2113,6 +2146,16 @@ namespace ed {
 			ImGui::SameLine();
 			ImGui::Checkbox("##expcpp_copy_images", &m_expcppCopyImages);
 
+			// packed assets
+			ImGui::Text("Pack assets and precompile shaders: ");
+			ImGui::SameLine();
+			ImGui::Checkbox("##expcpp_pack_assets", &m_expcppPackAssets);
+
+			// benchmark
+			ImGui::Text("Generate benchmark target: ");
+			ImGui::SameLine();
+			ImGui::Checkbox("##expcpp_benchmark", &m_expcppBenchmark);
+
 			// backend
 			ImGui::Text("Backend: ");
 			ImGui::SameLine();
@@ -2129,7 +2172,7 @@ namespace ed {
 
 			// export || cancel
 			if (ImGui::Button("Export")) {
-				m_expcppError = !ExportCPP::Export(m_data, m_expcppSavePath, !m_expcppMemoryShaders, m_expcppCmakeFiles, m_expcppProjectName, m_expcppCmakeModules, m_expcppImage, m_expcppCopyImages);
+				m_expcppError = !ExportCPP::Export(m_data, m_expcppSavePath, !m_expcppMemoryShaders, m_expcppCmakeFiles, m_expcppProjectName, m_expcppCmakeModules, m_expcppImage, m_expcppCopyImages, m_expcppPackAssets, m_expcppBenchmark);
 				if (!m_expcppError)
 					ImGui::CloseCurrentPopup();
 			}
@@ -2237,6 +2280,8 @@ namespace ed {
 		if (m_splashScreenFrame < 5)
 			m_splashScreenFrame++;
 		else if (!m_splashScreenLoaded) {
+			StartupTrace::Instance().Begin("online checks");
+
 			// check for updates
 			if (Settings::Instance().General.CheckUpdates) {
 				m_data->API.CheckForApplicationUpdates([&]() {
@@ -2274,10 +2319,14 @@ namespace ed {
 			// check the changelog
 			m_checkChangelog();
 
+			StartupTrace::Instance().End();
+
 			// load plugins
+			StartupTrace::Instance().Begin("plugins");
 			m_data->Plugins.Init(m_data, this);
+			StartupTrace::Instance().End();
 
-			m_onlineExcludeGodot = m_data->Plugins.GetPlugin("GodotShaders") == nullptr;
+			m_onlineExcludeGodot = !m_data->Plugins.IsInstalled("GodotShaders");
 
 			m_splashScreenLoaded = true;
 			m_isIncompatPluginsOpened = !m_data->Plugins.GetIncompatiblePlugins().empty();
@@ -2292,6 +2341,49 @@ namespace ed {
 			}
 		}
 	}
+	void GUIManager::m_renderLoadingProgress(const std::string& status, float progress)
+	{
+		ImGuiContext* mainContext = ImGui::GetCurrentContext();
+		if (m_progressContext == nullptr) {
+			m_progressContext = ImGui::CreateContext(ImGui::GetIO().Fonts);
+			ImGui::SetCurrentContext(m_progressContext);
+			ImGui::GetIO().IniFilename = nullptr;
+			ImGui::StyleColorsDark();
+		} else
+			ImGui::SetCurrentContext(m_progressContext);
+
+		int wndWidth = 0, wndHeight = 0, fbWidth = 0, fbHeight = 0;
+		SDL_GetWindowSize(m_wnd, &wndWidth, &wndHeight);
+		SDL_GL_GetDrawableSize(m_wnd, &fbWidth, &fbHeight);
+
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize = ImVec2((float)wndWidth, (float)wndHeight);
+		io.DisplayFramebufferScale = ImVec2(wndWidth > 0 ? (float)fbWidth / wndWidth : 1.0f, wndHeight > 0 ? (float)fbHeight / wndHeight : 1.0f);
+		io.DeltaTime = ProjectLoader::FrameBudget;
+
+		ImGui::NewFrame();
+
+		float width = std::min<float>(400.0f * Settings::Instance().DPIScale, wndWidth * 0.8f);
+		ImGui::SetNextWindowPos(ImVec2(wndWidth / 2.0f, wndHeight / 2.0f), ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+		ImGui::SetNextWindowSize(ImVec2(width, 0.0f), ImGuiCond_Always);
+		ImGui::Begin("##loading_project", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoInputs);
+		ImGui::TextUnformatted(status.c_str());
+		ImGui::ProgressBar(progress, ImVec2(-1.0f, 0.0f));
+		ImGui::End();
+
+		ImGui::Render();
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, fbWidth, fbHeight);
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+		SDL_GL_SwapWindow(m_wnd);
+		SDL_PumpEvents(); // keep the window responsive
+
+		ImGui::SetCurrentContext(mainContext);
+	}
 	void GUIManager::m_splashScreenLoad()
 	{
 		stbi_set_flip_vertically_on_load(0);
@@ -2452,7 +2544,7 @@ namespace ed {
 			}
 
 			if (cont)
-				igfd::ImGuiFileDialog::Instance()->OpenModal("OpenProjectDlg", "Open SHADERed project", "SHADERed project (*.sprj){.sprj},.*", ".");
+				igfd::ImGuiFileDialog::Instance()->OpenModal("OpenProjectDlg", "Open SHADERed project", "SHADERed project (*.sprj;*.sprjz){.sprj,.sprjz},.*", ".");
 		}
 		ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
 		m_tooltip("Open a project");
@@ -2835,7 +2927,7 @@ namespace ed {
 
 		return ShaderVariable::ValueType::Count;
 	}
-	void GUIManager::m_autoUniforms(ShaderVariableContainer& varManager, SPIRVParser& spv, std::vector<std::string>& uniformList)
+	void GUIManager::m_autoUniforms(ShaderVariableContainer& varManager, const SPIRVParser& spv, std::vector<std::string>& uniformList)
 	{
 		PinnedUI* pinUI = ((PinnedUI*)Get(ViewID::Pinned));
 		std::vector<ShaderVariable*> vars = varManager.GetVariables();
@@ -2905,7 +2997,7 @@ namespace ed {
 						} else {
 							// branch
 							if (spv.UserTypes.count(type.TypeName) > 0) {
-								const std::vector<SPIRVParser::Variable>& mems = spv.UserTypes[type.TypeName];
+								const std::vector<SPIRVParser::Variable>& mems = spv.UserTypes.at(type.TypeName);
 								for (int m = 0; m < mems.size(); m++) {
 									std::string memName = std::string(name.c_str()) + "." + mems[m].Name; // hack for \0
 									curType.push(mems[m]);
@@ -2973,10 +3065,14 @@ namespace ed {
 			return false;
 		}
 
-		m_data->Parser.Save();
-
+		// shaders go first since .sprjz projects pack them when saving the project
 		((CodeEditorUI*)Get(ViewID::Code))->SaveAll();
 
+		// buffer views only read the visible rows
+		((ObjectPreviewUI*)m_objectPrev)->SyncBuffers();
+
+		m_data->Parser.Save();
+
 		std::vector<PipelineItem*> passes = m_data->Pipeline.GetList();
 		for (PipelineItem*& pass : passes)
 			m_data->Renderer.Recompile(pass->Name);
@@ -2990,7 +3086,7 @@ namespace ed {
 		m_saveAsRestoreCache = restoreCached;
 		m_saveAsHandle = handle;
 		m_saveAsPreHandle = preHandle;
-		igfd::ImGuiFileDialog::Instance()->OpenModal("SaveProjectDlg", "Save project", "SHADERed project (*.sprj){.sprj},.*", ".");
+		igfd::ImGuiFileDialog::Instance()->OpenModal("SaveProjectDlg", "Save project", "SHADERed project (*.sprj){.sprj},SHADERed project archive (*.sprjz){.sprjz},.*", ".");
 	}
 	void GUIManager::Open(const std::string& file)
 	{
@@ -3068,7 +3164,7 @@ namespace ed {
 			}
 
 			if (cont)
-				igfd::ImGuiFileDialog::Instance()->OpenModal("OpenProjectDlg", "Open SHADERed project", "SHADERed project (*.sprj){.sprj},.*", ".");
+				igfd::ImGuiFileDialog::Instance()->OpenModal("OpenProjectDlg", "Open SHADERed project", "SHADERed project (*.sprj;*.sprjz){.sprj,.sprjz},.*", ".");
 		});
 		KeyboardShortcuts::Instance().SetCallback("Project.New", [=]() {
 			this->ResetWorkspace();
@@ -15,6 +15,7 @@
 #include <vector>
 
 class ImFont;
+struct ImGuiContext;
 
 namespace ed {
 	class InterfaceManager;
@@ -76,6 +77,7 @@ namespace ed {
 		inline void SetPerformanceMode(bool mode) { m_perfModeFake = mode; }
 		inline void SetMinimalMode(bool mode) { m_minimalMode = mode; }
 		inline bool IsMinimalMode() { return m_minimalMode; }
+		inline bool IsSplashScreenActive() { return m_splashScreen; }
 
 		void AddNotification(int id, const char* text, const char* btnText, std::function<void(int, IPlugin1*)> fn, IPlugin1* plugin = nullptr);
 
@@ -92,7 +94,7 @@ namespace ed {
 
 		void m_imguiHandleEvent(const SDL_Event& e);
 
-		void m_autoUniforms(ShaderVariableContainer& vars, SPIRVParser& spv, std::vector<std::string>& uniformList);
+		void m_autoUniforms(ShaderVariableContainer& vars, const SPIRVParser& spv, std::vector<std::string>& uniformList);
 		void m_deleteUnusedUniforms(ShaderVariableContainer& vars, const std::vector<std::string>& spv);
 
 		void m_addProjectToRecents(const std::string& file);
@@ -174,6 +176,8 @@ namespace ed {
 		bool m_expcppImage;
 		bool m_expcppMemoryShaders;
 		bool m_expcppCopyImages;
+		bool m_expcppPackAssets;
+		bool m_expcppBenchmark;
 		char m_expcppProjectName[64];
 		std::string m_expcppSavePath;
 
@@ -190,6 +194,10 @@ namespace ed {
 		eng::Timer m_splashScreenTimer;
 		bool m_splashScreenLoaded;
 
+		// drawn while the project is loading (Open() is called in the middle of a frame, so it uses its own ImGui context)
+		void m_renderLoadingProgress(const std::string& status, float progress);
+		ImGuiContext* m_progressContext;
+
 		bool m_savePreviewSeq;
 		float m_savePreviewSeqDuration;
 		int m_savePreviewSeqFPS;
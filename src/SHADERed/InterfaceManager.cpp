@@ -202,6 +202,7 @@ namespace ed {
 		// return old info
 		Renderer.Render(false, pixel.Pass); // render everything up to the pixel.Pass object
 
+		Renderer.RequireSPIRV(pixel.Pass);
 		Debugger.PrepareVertexShader(pixel.Pass, pixel.Object);
 		for (int i = 0; i < pixel.VertexCount; i++) {
 			Debugger.SetVertexShaderInput(pixel.Pass, pixel.Vertex[i], pixel.VertexID + i, pixel.InstanceID, (BufferObject*)pixel.InstanceBuffer);
@@ -401,21 +402,21 @@ namespace ed {
 				pipe::ShaderPass* pass = (pipe::ShaderPass*)i->Data;
 				int langID = -1;
 
-				IPlugin1* plugin = ed::ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->VSPath, Plugins.Plugins());
+				IPlugin1* plugin = ed::ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->VSPath, &Plugins);
 				ret &= (plugin != nullptr && plugin->CustomLanguage_IsDebuggable(langID)) || plugin == nullptr;
 
-				plugin = ed::ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->PSPath, Plugins.Plugins());
+				plugin = ed::ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->PSPath, &Plugins);
 				ret &= (plugin != nullptr && plugin->CustomLanguage_IsDebuggable(langID)) || plugin == nullptr;
 
 				if (pass->GSUsed) {
-					plugin = ed::ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->GSPath, Plugins.Plugins());
+					plugin = ed::ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->GSPath, &Plugins);
 					ret &= (plugin != nullptr && plugin->CustomLanguage_IsDebuggable(langID)) || plugin == nullptr;
 				}
 			} else if (i->Type == PipelineItem::ItemType::ComputePass) {
 				pipe::ComputePass* pass = (pipe::ComputePass*)i->Data;
 				int langID = -1;
 
-				IPlugin1* plugin = ed::ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->Path, Plugins.Plugins());
+				IPlugin1* plugin = ed::ShaderCompiler::GetPluginLanguageFromExtension(&langID, pass->Path, &Plugins);
 				ret &= (plugin != nullptr && plugin->CustomLanguage_IsDebuggable(langID)) || plugin == nullptr;
 			}
 		}
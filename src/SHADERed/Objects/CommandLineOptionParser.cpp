@@ -1,6 +1,8 @@
 #include <SHADERed/Objects/CommandLineOptionParser.h>
+#include <SHADERed/Objects/ProjectValidator.h>
 #include <string.h>
 #include <filesystem>
+#include <fstream>
 #include <vector>
 
 namespace ed {
@@ -13,6 +15,12 @@ namespace ed {
 		LaunchUI = true;
 		ProjectFile = "";
 		WindowWidth = WindowHeight = 0;
+		TraceStartup = false;
+		TraceStartupFile = "";
+		QuitAfterStartup = false;
+		Validate = false;
+		ValidateOutput = "";
+		ExitCode = 0;
 	}
 	void CommandLineOptionParser::Parse(const std::filesystem::path& cmdDir, int argc, char* argv[])
 	{
@@ -51,6 +59,34 @@ namespace ed {
 			else if (strcmp(argv[i], "--performance") == 0 || strcmp(argv[i], "-p") == 0) {
 				PerformanceMode = true;
 			}
+			// --trace-startup [file.json]
+			else if (strcmp(argv[i], "--trace-startup") == 0) {
+				TraceStartup = true;
+				if (i + 1 < argc && std::filesystem::path(argv[i + 1]).extension() == ".json") {
+					TraceStartupFile = (cmdDir / argv[i + 1]).generic_string();
+					i++;
+				}
+			}
+			// --quit-after-startup
+			else if (strcmp(argv[i], "--quit-after-startup") == 0) {
+				QuitAfterStartup = true;
+			}
+			// --validate <project|directory>...
+			else if (strcmp(argv[i], "--validate") == 0) {
+				while (i + 1 < argc && argv[i + 1][0] != '-') {
+					ValidatePaths.push_back((cmdDir / argv[i + 1]).generic_string());
+					i++;
+				}
+				Validate = true;
+				LaunchUI = false;
+			}
+			// --validate-output <file.json>
+			else if (strcmp(argv[i], "--validate-output") == 0) {
+				if (i + 1 < argc) {
+					ValidateOutput = (cmdDir / argv[i + 1]).generic_string();
+					i++;
+				}
+			}
 			// --help, -h
 			else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
 				static const std::vector<std::pair<std::string, std::string>> opts = {
@@ -61,6 +97,10 @@ namespace ed {
 					{ "--fullscreen | -fs", "launch SHADERed in fullscreen mode" },
 					{ "--maxmimized | -max", "maximize SHADERed's window" },
 					{ "--performance | -p", "launch SHADERed in performance mode" },
+					{ "--trace-startup [file.json]", "log the timeline of the startup (and write it to a chrome://tracing file)" },
+					{ "--quit-after-startup", "quit once the first interactive frame is rendered" },
+					{ "--validate <project|dir>...", "compile every pass of the projects (directories are searched for .sprj/.sprjz) without a GPU and print a JSON report" },
+					{ "--validate-output <file.json>", "write the --validate report to a file instead of stdout" },
 				};
 
 				int maxSize = 0;
@@ -77,4 +117,27 @@ namespace ed {
 				ProjectFile = (cmdDir / argv[i]).generic_string();
 		}
 	}
+	void CommandLineOptionParser::RunValidator()
+	{
+		if (ValidatePaths.empty()) {
+			printf("--validate needs at least one project file or directory\n");
+			ExitCode = 2;
+			return;
+		}
+
+		ProjectValidator validator;
+		validator.Run(ValidatePaths);
+
+		ValidationReport& results = validator.GetReport();
+		std::string report = results.ToJSON();
+		if (ValidateOutput.empty())
+			printf("%s", report.c_str());
+		else {
+			std::ofstream out(ValidateOutput);
+			out << report;
+			out.close();
+		}
+
+		ExitCode = results.GetExitCode();
+	}
 }
\ No newline at end of file
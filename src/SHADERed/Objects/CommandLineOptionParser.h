@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <filesystem>
+#include <vector>
 
 namespace ed {
 	class CommandLineOptionParser {
@@ -8,6 +9,7 @@ namespace ed {
 		CommandLineOptionParser();
 
 		void Parse(const std::filesystem::path& cmdDir, int argc, char* argv[]);
+		void RunValidator(); // --validate, sets ExitCode - the settings must be loaded first (shader extensions)
 
 		bool LaunchUI;
 
@@ -17,5 +19,14 @@ namespace ed {
 		int WindowWidth, WindowHeight;
 		bool MinimalMode;
 		std::string ProjectFile;
+
+		bool TraceStartup;
+		std::string TraceStartupFile; // empty -> only log the timeline
+		bool QuitAfterStartup;
+
+		bool Validate;
+		std::vector<std::string> ValidatePaths; // projects or directories, validated without launching the UI
+		std::string ValidateOutput;				// empty -> stdout
+		int ExitCode;
 	};
 }
\ No newline at end of file
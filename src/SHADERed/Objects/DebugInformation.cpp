@@ -1,4 +1,5 @@
 #include <SHADERed/Objects/DebugInformation.h>
+#include <SHADERed/Objects/SPIRVReflectionCache.h>
 #include <SHADERed/Objects/SystemVariableManager.h>
 
 #include <iomanip>
@@ -296,15 +297,17 @@ namespace ed {
 		m_msgs = msgs;
 		m_workgroup = nullptr;
 
-		m_vmContext = spvm_context_initialize();
-		m_vmGLSL = spvm_build_glsl450_ext();
+		m_vmContext = nullptr;
+		m_vmGLSL = nullptr;
 	}
 	DebugInformation::~DebugInformation()
 	{
 		m_resetVM();
 
-		free(m_vmGLSL);
-		spvm_context_deinitialize(m_vmContext);
+		if (m_vmContext != nullptr) {
+			free(m_vmGLSL);
+			spvm_context_deinitialize(m_vmContext);
+		}
 	}
 	
 	void DebugInformation::m_resetVM()
@@ -349,9 +352,19 @@ namespace ed {
 		}
 
 	}
+	void DebugInformation::m_initVM()
+	{
+		if (m_vmContext != nullptr)
+			return;
+
+		m_vmContext = spvm_context_initialize();
+		m_vmGLSL = spvm_build_glsl450_ext();
+	}
 	void DebugInformation::m_setupVM(std::vector<unsigned int>& spv)
 	{
 		m_spv = spv;
+
+		m_initVM();
 		
 		// create program & state
 		m_shader = spvm_program_create(m_vmContext, (spvm_source)m_spv.data(), m_spv.size());
@@ -1304,6 +1317,7 @@ namespace ed {
 		}
 
 		// create program & state
+		m_initVM();
 		m_shaderImmediate = spvm_program_create(m_vmContext, (spvm_source)m_spvImmediate.data(), m_spvImmediate.size());
 		m_vmImmediate = _spvm_state_create_base(m_shaderImmediate, m_stage == ShaderStage::Pixel, 0);
 		
@@ -1834,12 +1848,8 @@ namespace ed {
 		m_numGroupsY = data->WorkY;
 		m_numGroupsZ = data->WorkZ;
 
-		if (data->SPV.size() > 0) {
-			SPIRVParser parser;
-			parser.Parse(data->SPV);
-			if (parser.BarrierUsed)
-				m_setupWorkgroup();
-		}
+		if (data->SPV.size() > 0 && SPIRVReflectionCache::Instance().Get(data->SPV)->BarrierUsed)
+			m_setupWorkgroup();
 	}
 
 	void DebugInformation::PrepareDebugger()
@@ -158,6 +158,7 @@ namespace ed {
 		void m_setThreadID(spvm_state_t state, int x, int y, int z, int numGroupsX, int numGroupsY, int numGroupsZ);
 		
 		void m_copyUniforms(PipelineItem* pass, PipelineItem* item, PixelInformation* px = nullptr);
+		void m_initVM(); // spvm context is created on the first debug session
 		void m_setupVM(std::vector<unsigned int>& spv);
 		void m_resetVM();
 		spvm_state_t m_vm;
@@ -1,14 +1,19 @@
 #include <SHADERed/Engine/GeometryFactory.h>
 #include <SHADERed/Objects/Export/ExportCPP.h>
+#include <SHADERed/Objects/MinizHeader.h>
 #include <SHADERed/Objects/Names.h>
 #include <SHADERed/Objects/ShaderCompiler.h>
 #include <SHADERed/Objects/SystemVariableManager.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include <string>
 #include <vector>
 
+#include <stb/stb_image.h>
+
 #define HARRAYSIZE(a) (sizeof(a) / sizeof(*a)) // TODO: define this somewhere else....
 
 namespace ed {
@@ -72,6 +77,22 @@ namespace ed {
 	{
 		return "ShaderSource_" + getFilename(filename);
 	}
+	std::string getLocationName(const std::string& passName, const std::string& varName)
+	{
+		return passName + "_" + varName + "_Loc";
+	}
+
+	// packed assets - returns the offset of the data in the pack
+	size_t addToPack(std::string& pack, const void* data, size_t size)
+	{
+		while (pack.size() % 4 != 0)
+			pack += '\0';
+
+		size_t offset = pack.size();
+		pack.append((const char*)data, size);
+		return offset;
+	}
+
 	std::string getTopologyName(GLuint topology)
 	{
 		static const char* names[] = {
@@ -229,7 +250,7 @@ namespace ed {
 	{
 		std::string ret = "";
 
-		std::string locSrc = "glGetUniformLocation(" + passName + "_SP, \"" + std::string(var->Name) + "\")";
+		std::string locSrc = getLocationName(passName, var->Name); // resolved in the init section
 
 		std::string systemName = getSystemVariableName(var);
 		bool isSystem = var->System != ed::SystemShaderVariable::None;
@@ -322,7 +343,7 @@ namespace ed {
 		return ret;
 	}
 
-	bool ExportCPP::Export(InterfaceManager* data, const std::string& outPath, bool externalShaders, bool exportCmakeFiles, const std::string& cmakeProject, bool copyCMakeModules, bool copySTBImage, bool copyImages)
+	bool ExportCPP::Export(InterfaceManager* data, const std::string& outPath, bool externalShaders, bool exportCmakeFiles, const std::string& cmakeProject, bool copyCMakeModules, bool copySTBImage, bool copyImages, bool packAssets, bool benchmark)
 	{
 		bool usesGeometry[pipe::GeometryItem::GeometryType::Count] = { false };
 		bool usesTextures = false;
@@ -339,6 +360,12 @@ namespace ed {
 		if (copySTBImage && !std::filesystem::exists("data/export/cpp/stb_image.h"))
 			return false;
 
+		if (packAssets && !std::filesystem::exists("data/export/cpp/pack.cpp"))
+			return false;
+
+		if (benchmark && !std::filesystem::exists("data/export/cpp/benchmark.cpp"))
+			return false;
+
 		std::filesystem::path parentPath = std::filesystem::path(outPath).parent_path();
 
 		// copy CMakeLists.txt
@@ -347,6 +374,18 @@ namespace ed {
 			replaceSections(cmakeLists, "project_name", cmakeProject);
 			replaceSections(cmakeLists, "project_file", std::filesystem::path(outPath).filename().string());
 
+			size_t locBenchTarget = findSection(cmakeLists, "benchmark_target");
+			if (locBenchTarget != std::string::npos) {
+				std::string benchTarget = "";
+				if (benchmark) {
+					benchTarget += "\n# headless benchmark\n";
+					benchTarget += "add_executable(" + cmakeProject + "_benchmark ${SOURCES})\n";
+					benchTarget += "target_compile_definitions(" + cmakeProject + "_benchmark PRIVATE SED_BENCHMARK)\n";
+					benchTarget += "list(APPEND TARGETS " + cmakeProject + "_benchmark)\n";
+				}
+				insertSection(cmakeLists, locBenchTarget, benchTarget);
+			}
+
 			std::ofstream outCmake(parentPath / "CMakeLists.txt");
 			outCmake << cmakeLists;
 			outCmake.close();
@@ -392,6 +431,53 @@ namespace ed {
 			}
 		}
 
+		// GLSL source code of a shader
+		auto getGLSLSource = [&](int index) -> std::string {
+			std::string shdrSource = data->Parser.LoadProjectFile(allShaderFiles[index]);
+			ShaderLanguage shdrLanguage = ShaderCompiler::GetShaderLanguageFromExtension(allShaderFiles[index].c_str());
+			if (shdrLanguage != ShaderLanguage::GLSL) {
+				std::vector<ed::ShaderMacro> tempMacros;
+				std::vector<unsigned int> tempSPV;
+
+				ShaderCompiler::CompileSourceToSPIRV(tempSPV, shdrLanguage, allShaderFiles[index], shdrSource, allShaderTypes[index], allShaderEntries[index], tempMacros, nullptr, nullptr);
+				shdrSource = ShaderCompiler::ConvertToGLSL(tempSPV, shdrLanguage, allShaderTypes[index], false, nullptr);
+			}
+			return shdrSource;
+		};
+
+		// packed assets: textures (decoded and compressed), SPIR-V and GLSL source code in a single file
+		std::string pack = "SEDPACK1";
+		std::string packName = std::filesystem::path(outPath).stem().string() + ".pak";
+		std::vector<size_t> packSourceOffset(allShaderFiles.size(), 0), packSourceSize(allShaderFiles.size(), 0);
+		std::map<std::string, int> spvLocations;
+		int spvNextLocation = 0;
+
+		size_t locPack = findSection(templateSrc, "pack");
+		if (locPack != std::string::npos)
+			insertSection(templateSrc, locPack, packAssets ? loadFile("data/export/cpp/pack.cpp") : "");
+
+		// benchmark: pass names + timers
+		size_t locBenchmark = findSection(templateSrc, "benchmark");
+		if (locBenchmark != std::string::npos) {
+			std::string benchSrc = "";
+			if (benchmark) {
+				int passCount = 0;
+				benchSrc += "const char* sedPassNames[] = { ";
+				for (int i = 0; i < pipeItems.size(); i++) {
+					if (pipeItems[i]->Type == ed::PipelineItem::ItemType::ShaderPass) {
+						benchSrc += (passCount == 0 ? "\"" : ", \"") + std::string(pipeItems[i]->Name) + "\"";
+						passCount++;
+					}
+				}
+				if (passCount == 0)
+					benchSrc += "nullptr";
+				benchSrc += " };\n";
+				benchSrc += "const int sedPassCount = " + std::to_string(passCount) + ";\n\n";
+				benchSrc += loadFile("data/export/cpp/benchmark.cpp");
+			}
+			insertSection(templateSrc, locBenchmark, benchSrc);
+		}
+
 		// store shaders in the generated file
 		size_t locShaders = findSection(templateSrc, "shaders");
 		std::string indent = getSectionIndent(templateSrc, "shaders");
@@ -399,17 +485,14 @@ namespace ed {
 			std::string shadersSrc = "";
 
 			for (int i = 0; i < allShaderFiles.size(); i++) {
-				if (externalShaders) {
+				if (packAssets) {
+					// fallback for the drivers without GL_ARB_gl_spirv
+					std::string shdrSource = getGLSLSource(i);
+					packSourceOffset[i] = addToPack(pack, shdrSource.data(), shdrSource.size());
+					packSourceSize[i] = shdrSource.size();
+				} else if (externalShaders) {
 				} else {
-					std::string shdrSource = data->Parser.LoadProjectFile(allShaderFiles[i]);
-					ShaderLanguage shdrLanguage = ShaderCompiler::GetShaderLanguageFromExtension(allShaderFiles[i].c_str());
-					if (shdrLanguage != ShaderLanguage::GLSL) {
-						std::vector<ed::ShaderMacro> tempMacros;
-						std::vector<unsigned int> tempSPV;
-
-						ShaderCompiler::CompileSourceToSPIRV(tempSPV, shdrLanguage, allShaderFiles[i], shdrSource, allShaderTypes[i], allShaderEntries[i], tempMacros, nullptr, nullptr);
-						shdrSource = ShaderCompiler::ConvertToGLSL(tempSPV, shdrLanguage, allShaderTypes[i], false, nullptr);
-					}
+					std::string shdrSource = getGLSLSource(i);
 
 					shadersSrc += "std::string " + getShaderFilename(allShaderFiles[i]) + " = R\"(\n";
 					shadersSrc += shdrSource + "\n";
@@ -427,8 +510,16 @@ namespace ed {
 		if (locInit != std::string::npos) {
 			std::string initSrc = "";
 
+			// packed assets
+			if (packAssets) {
+				initSrc += indent + "// packed assets\n";
+				initSrc += indent + "if (!LoadPack(\"" + packName + "\", [$$pack_size$$]))\n";
+				initSrc += indent + "\treturn 0;\n";
+				initSrc += indent + "sedUseSPIRV = GLEW_ARB_gl_spirv;\n\n";
+			}
+
 			// external shaders
-			if (externalShaders) {
+			if (externalShaders && !packAssets) {
 				initSrc += indent + "// shaders\n";
 				for (int i = 0; i < allShaderFiles.size(); i++) {
 					std::string shdrFile = std::filesystem::path(allShaderFiles[i]).filename().string();
@@ -436,15 +527,7 @@ namespace ed {
 					initSrc += indent + "std::string " + getShaderFilename(allShaderFiles[i]) + " = LoadFile(\"" + shdrFile + "\");\n";
 
 					// copy the shader
-					std::string shdrSource = data->Parser.LoadProjectFile(allShaderFiles[i]);
-					ShaderLanguage shdrLanguage = ShaderCompiler::GetShaderLanguageFromExtension(allShaderFiles[i].c_str());
-					if (shdrLanguage != ShaderLanguage::GLSL) {
-						std::vector<ed::ShaderMacro> tempMacros;
-						std::vector<unsigned int> tempSPV;
-
-						ShaderCompiler::CompileSourceToSPIRV(tempSPV, shdrLanguage, allShaderFiles[i], shdrSource, allShaderTypes[i], allShaderEntries[i], tempMacros, nullptr, nullptr);
-						shdrSource = ShaderCompiler::ConvertToGLSL(tempSPV, shdrLanguage, allShaderTypes[i], false, nullptr);
-					}
+					std::string shdrSource = getGLSLSource(i);
 
 					std::ofstream shaderWriter(shdrFile);
 					shaderWriter << shdrSource;
@@ -520,6 +603,27 @@ namespace ed {
 					}
 					texName = getFilename(texName);
 
+					if (packAssets) {
+						// store decoded pixels so that the exported app doesn't have to decode the image
+						int width = 0, height = 0, channels = 0;
+						stbi_set_flip_vertically_on_load(1);
+						unsigned char* pixels = stbi_load(data->Parser.GetProjectPath(actualName).c_str(), &width, &height, &channels, 4);
+
+						if (pixels != nullptr) {
+							sed_mz_ulong pixelsSize = width * height * 4;
+							sed_mz_ulong compSize = sed_mz_compressBound(pixelsSize);
+							std::vector<unsigned char> compData(compSize);
+							sed_mz_compress2(compData.data(), &compSize, pixels, pixelsSize, sed_mz_BEST_COMPRESSION);
+							stbi_image_free(pixels);
+
+							size_t offset = addToPack(pack, compData.data(), compSize);
+							initSrc += indent + "GLuint " + texName + " = LoadPackedTexture(" + std::to_string(offset) + ", " + std::to_string(compSize) + ", " + std::to_string(width) + ", " + std::to_string(height) + ");\n\n";
+						} else
+							initSrc += indent + "GLuint " + texName + " = 0; // failed to load " + actualName + "\n\n";
+
+						continue;
+					}
+
 					initSrc += indent + "GLuint " + texName + " = LoadTexture(\"" + std::filesystem::path(actualName).filename().string() + "\");\n\n";
 
 					if (copyImages)
@@ -532,8 +636,62 @@ namespace ed {
 				if (pipeItems[i]->Type == ed::PipelineItem::ItemType::ShaderPass) {
 					pipe::ShaderPass* pass = (pipe::ShaderPass*)pipeItems[i]->Data;
 
+					std::string passName = pipeItems[i]->Name;
+					const auto& samplers = pass->Variables.GetSamplerList();
+
 					// load shaders
-					initSrc += indent + "GLuint " + std::string(pipeItems[i]->Name) + "_SP = CreateShader(" + getShaderFilename(pass->VSPath) + ".c_str(), " + getShaderFilename(pass->PSPath) + ".c_str());\n\n";
+					bool usesSPIRV = false;
+					if (packAssets) {
+						int vsIndex = std::find(allShaderFiles.begin(), allShaderFiles.end(), pass->VSPath) - allShaderFiles.begin();
+						int psIndex = std::find(allShaderFiles.begin(), allShaderFiles.end(), pass->PSPath) - allShaderFiles.begin();
+
+						// SPIR-V is generated per pass since the sampler bindings depend on the pass
+						std::vector<ed::ShaderMacro> tempMacros;
+						std::vector<unsigned int> vsSPV, psSPV;
+						std::string vsEntry, psEntry;
+						std::vector<std::string> spvSamplers = samplers;
+						ShaderLanguage vsLang = ShaderCompiler::GetShaderLanguageFromExtension(pass->VSPath);
+						ShaderLanguage psLang = ShaderCompiler::GetShaderLanguageFromExtension(pass->PSPath);
+
+						usesSPIRV = vsLang != ShaderLanguage::Plugin && psLang != ShaderLanguage::Plugin
+							&& ShaderCompiler::CompileSourceToSPIRV(vsSPV, vsLang, pass->VSPath, data->Parser.LoadProjectFile(pass->VSPath), ShaderStage::Vertex, pass->VSEntry, tempMacros, nullptr, nullptr, true)
+							&& ShaderCompiler::CompileSourceToSPIRV(psSPV, psLang, pass->PSPath, data->Parser.LoadProjectFile(pass->PSPath), ShaderStage::Pixel, pass->PSEntry, tempMacros, nullptr, nullptr, true)
+							&& ShaderCompiler::PrepareGLSPIRV(vsSPV, spvLocations, spvNextLocation, spvSamplers, vsEntry)
+							&& ShaderCompiler::PrepareGLSPIRV(psSPV, spvLocations, spvNextLocation, spvSamplers, psEntry)
+							&& spvSamplers.size() == samplers.size(); // every sampler needs a texture unit
+
+						std::string spvArgs = "0, 0, \"main\", 0, 0, \"main\"";
+						if (usesSPIRV) {
+							size_t vsOffset = addToPack(pack, vsSPV.data(), vsSPV.size() * sizeof(unsigned int));
+							size_t psOffset = addToPack(pack, psSPV.data(), psSPV.size() * sizeof(unsigned int));
+							spvArgs = std::to_string(vsOffset) + ", " + std::to_string(vsSPV.size() * sizeof(unsigned int)) + ", \"" + vsEntry + "\", " + std::to_string(psOffset) + ", " + std::to_string(psSPV.size() * sizeof(unsigned int)) + ", \"" + psEntry + "\"";
+						}
+						std::string srcArgs = std::to_string(packSourceOffset[vsIndex]) + ", " + std::to_string(packSourceSize[vsIndex]) + ", " + std::to_string(packSourceOffset[psIndex]) + ", " + std::to_string(packSourceSize[psIndex]);
+
+						initSrc += indent + "bool " + passName + "_SPIRV = false;\n";
+						initSrc += indent + "GLuint " + passName + "_SP = CreatePackedShader(" + spvArgs + ", " + srcArgs + ", " + passName + "_SPIRV);\n";
+					} else
+						initSrc += indent + "GLuint " + passName + "_SP = CreateShader(" + getShaderFilename(pass->VSPath) + ".c_str(), " + getShaderFilename(pass->PSPath) + ".c_str());\n";
+
+					// uniform locations - no glGetUniformLocation calls while rendering
+					for (const auto& var : pass->Variables.GetVariables()) {
+						std::string getLocation = "glGetUniformLocation(" + passName + "_SP, \"" + std::string(var->Name) + "\")";
+						if (usesSPIRV) {
+							int location = spvLocations.count(var->Name) ? spvLocations[var->Name] : -1;
+							initSrc += indent + "GLint " + getLocationName(passName, var->Name) + " = " + passName + "_SPIRV ? " + std::to_string(location) + " : " + getLocation + ";\n";
+						} else
+							initSrc += indent + "GLint " + getLocationName(passName, var->Name) + " = " + getLocation + ";\n";
+					}
+
+					// texture units don't change - SPIR-V shaders already have the bindings
+					const auto& srvs = data->Objects.GetBindList(pipeItems[i]);
+					if (srvs.size() > 0) {
+						initSrc += indent + "glUseProgram(" + passName + "_SP);\n";
+						for (int j = 0; j < srvs.size() && j < samplers.size(); j++)
+							initSrc += indent + "glUniform1i(glGetUniformLocation(" + passName + "_SP, \"" + samplers[j] + "\"), " + std::to_string(j) + ");\n";
+						initSrc += indent + "glUseProgram(0);\n";
+					}
+					initSrc += "\n";
 
 					// framebuffers
 					if (pass->RTCount == 1 && pass->RenderTextures[0] == data->Renderer.GetTexture()) {
@@ -622,6 +780,7 @@ namespace ed {
 
 			GLuint previousTexture[MAX_RENDER_TEXTURES] = { 0 }; // dont clear the render target if we use it two times in a row
 			GLuint previousDepth = 0;
+			int passIndex = 0;
 
 			for (int i = 0; i < pipeItems.size(); i++) {
 				if (pipeItems[i]->Type == ed::PipelineItem::ItemType::ShaderPass) {
@@ -629,11 +788,13 @@ namespace ed {
 
 					// use the program
 					renderSrc += indent + "// " + std::string(pipeItems[i]->Name) + " shader pass\n";
+					if (benchmark)
+						renderSrc += indent + "BENCHMARK_BEGIN_PASS(" + std::to_string(passIndex) + ");\n";
 					renderSrc += indent + "glUseProgram(" + std::string(pipeItems[i]->Name) + "_SP);\n\n";
 
 					// FBO
 					if (pass->RTCount == 1 && pass->RenderTextures[0] == data->Renderer.GetTexture())
-						renderSrc += indent + "glBindFramebuffer(GL_FRAMEBUFFER, 0);\n";
+						renderSrc += indent + "glBindFramebuffer(GL_FRAMEBUFFER, sedOutputFBO);\n";
 					else {
 						renderSrc += indent + "glBindFramebuffer(GL_FRAMEBUFFER, " + std::string(pipeItems[i]->Name) + "_FBO);\n";
 						renderSrc += indent + "glDrawBuffers(" + std::to_string(pass->RTCount) + ", FBO_Buffers);\n";
@@ -688,10 +849,7 @@ namespace ed {
 						else if (data->Objects.IsRenderTexture(actualName))
 							renderSrc += indent + "glBindTexture(GL_TEXTURE_2D, " + texName + "_Color);\n";
 						else
-							renderSrc += indent + "glBindTexture(GL_TEXTURE_2D, " + texName + ");\n";
-
-						std::string unitName = pass->Variables.GetSamplerList()[j];
-						renderSrc += indent + "glUniform1i(glGetUniformLocation(" + std::string(pipeItems[i]->Name) + "_SP, \"" + unitName + "\"), " + std::to_string(j) + ");\n\n";
+							renderSrc += indent + "glBindTexture(GL_TEXTURE_2D, " + texName + ");\n\n";
 					}
 
 					// bind variables
@@ -716,7 +874,7 @@ namespace ed {
 									} else {
 										renderSrc += indent + "sysGeometryTransform = glm::translate(glm::mat4(1), glm::vec3(" + std::to_string(geoData->Position.x) + "f, " + std::to_string(geoData->Position.y) + "f, " + std::to_string(geoData->Position.z) + "f)) *" + "glm::yawPitchRoll(" + std::to_string(geoData->Rotation.y) + "f, " + std::to_string(geoData->Rotation.x) + "f, " + std::to_string(geoData->Rotation.z) + "f) * " + "glm::scale(glm::mat4(1.0f), glm::vec3(" + std::to_string(geoData->Scale.x) + "f, " + std::to_string(geoData->Scale.y) + "f, " + std::to_string(geoData->Scale.z) + "f));\n";
 									}
-									renderSrc += indent + "glUniformMatrix4fv(glGetUniformLocation(" + std::string(pipeItems[i]->Name) + "_SP, \"" + std::string(var->Name) + "\"), 1, GL_FALSE, glm::value_ptr(sysGeometryTransform));\n";
+									renderSrc += indent + "glUniformMatrix4fv(" + getLocationName(pipeItems[i]->Name, var->Name) + ", 1, GL_FALSE, glm::value_ptr(sysGeometryTransform));\n";
 									break;
 								}
 							}
@@ -727,14 +885,27 @@ namespace ed {
 								renderSrc += indent + "glDrawArrays(" + getTopologyName(geoData->Topology) + ", 0, " + std::to_string(eng::GeometryFactory::VertexCount[geoData->Type]) + ");\n";
 							renderSrc += "\n";
 						}
+					}
+
+					if (benchmark) {
+						renderSrc += indent + "BENCHMARK_END_PASS(" + std::to_string(passIndex) + ");\n";
 						renderSrc += "\n";
 					}
+					passIndex++;
 				}
 			}
 
 			insertSection(templateSrc, locRender, renderSrc);
 		}
 
+		if (packAssets) {
+			replaceSections(templateSrc, "pack_size", std::to_string(pack.size()));
+
+			std::ofstream packWriter(parentPath / packName, std::ios::binary);
+			packWriter.write(pack.data(), pack.size());
+			packWriter.close();
+		}
+
 		std::ofstream fileWriter(outPath);
 		fileWriter << templateSrc;
 		fileWriter.close();
@@ -4,6 +4,6 @@
 namespace ed {
 	class ExportCPP {
 	public:
-		static bool Export(InterfaceManager* data, const std::string& outPath, bool externalShaders, bool exportCmakeFiles, const std::string& cmakeProject, bool copyCMakeModules, bool copySTBImage, bool copyImages);
+		static bool Export(InterfaceManager* data, const std::string& outPath, bool externalShaders, bool exportCmakeFiles, const std::string& cmakeProject, bool copyCMakeModules, bool copySTBImage, bool copyImages, bool packAssets, bool benchmark);
 	};
 }
\ No newline at end of file
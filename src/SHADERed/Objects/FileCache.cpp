@@ -0,0 +1,114 @@
+#include <SHADERed/Objects/FileCache.h>
+
+#include <fstream>
+
+namespace ed {
+	const size_t FileCache::MaxFileSize = 4 * 1024 * 1024;
+	const size_t FileCache::MaxTotalSize = 64 * 1024 * 1024;
+
+	FileCache::FileCache()
+	{
+		m_totalSize = 0;
+		m_hits = 0;
+		m_misses = 0;
+	}
+
+	bool FileCache::Read(const std::string& path, std::string& content)
+	{
+		std::string key = m_canonical(path);
+
+		std::error_code ec;
+		std::filesystem::directory_entry file(key, ec);
+		if (ec || !file.is_regular_file(ec))
+			return false;
+
+		std::filesystem::file_time_type time = file.last_write_time(ec);
+		uintmax_t size = file.file_size(ec);
+
+		// cache hit
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			auto it = m_files.find(key);
+			if (it != m_files.end()) {
+				if (!ec && it->second.Time == time && it->second.Size == size) {
+					m_hits++;
+					content = it->second.Content;
+					return true;
+				}
+
+				m_totalSize -= it->second.Content.size();
+				m_files.erase(it);
+			}
+		}
+		m_misses++;
+
+		std::ifstream in(key);
+		if (!in.is_open())
+			return false;
+
+		content.assign((std::istreambuf_iterator<char>(in)), (std::istreambuf_iterator<char>()));
+		in.close();
+
+		if (ec || size > MaxFileSize)
+			return true;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_totalSize + content.size() > MaxTotalSize) {
+			m_files.clear();
+			m_totalSize = 0;
+		}
+
+		Entry& entry = m_files[key];
+		m_totalSize -= entry.Content.size(); // another thread might have been faster
+		entry.Time = time;
+		entry.Size = size;
+		entry.Content = content;
+		m_totalSize += content.size();
+
+		return true;
+	}
+
+	void FileCache::Invalidate(const std::string& path)
+	{
+		std::string key = m_canonical(path);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		auto it = m_files.find(key);
+		if (it != m_files.end()) {
+			m_totalSize -= it->second.Content.size();
+			m_files.erase(it);
+		}
+	}
+	void FileCache::Clear()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_files.clear();
+		m_totalSize = 0;
+	}
+
+	float FileCache::GetHitRate()
+	{
+		size_t hits = m_hits, total = hits + m_misses;
+		return total == 0 ? 0.0f : hits / (float)total;
+	}
+	size_t FileCache::GetFileCount()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_files.size();
+	}
+	size_t FileCache::GetTotalSize()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_totalSize;
+	}
+
+	std::string FileCache::m_canonical(const std::string& path)
+	{
+		std::error_code ec;
+		std::filesystem::path ret = std::filesystem::weakly_canonical(path, ec);
+		if (ec)
+			return std::filesystem::path(path).lexically_normal().generic_string();
+
+		return ret.generic_string();
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ed {
+	// process-wide cache of text file contents (shaders, includes) - entries are keyed by
+	// the canonical path and revalidated with the file's modification time and size
+	class FileCache {
+	public:
+		FileCache();
+
+		static FileCache& Instance()
+		{
+			static FileCache ret;
+			return ret;
+		}
+
+		static const size_t MaxFileSize; // bigger files (models, etc...) are read but not cached
+		static const size_t MaxTotalSize;
+
+		// returns false if the file can't be opened
+		bool Read(const std::string& path, std::string& content);
+
+		void Invalidate(const std::string& path);
+		void Clear();
+
+		inline size_t GetHitCount() { return m_hits; }
+		inline size_t GetMissCount() { return m_misses; }
+		float GetHitRate();
+		size_t GetFileCount();
+		size_t GetTotalSize();
+
+	private:
+		struct Entry {
+			std::filesystem::file_time_type Time;
+			uintmax_t Size;
+			std::string Content;
+		};
+
+		std::string m_canonical(const std::string& path);
+
+		std::mutex m_mutex;
+		std::unordered_map<std::string, Entry> m_files;
+		size_t m_totalSize;
+		std::atomic<size_t> m_hits, m_misses;
+	};
+}
@@ -37,10 +37,11 @@
 #pragma once
 
 #include <algorithm>
-#include <fstream>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#include <SHADERed/Objects/FileCache.h>
 #include <glslang/Public/ShaderLang.h>
 
 namespace ed {
@@ -109,10 +110,10 @@ namespace ed {
 			for (auto it = directoryStack.rbegin(); it != directoryStack.rend(); ++it) {
 				std::string path = *it + '/' + headerName;
 				std::replace(path.begin(), path.end(), '\\', '/');
-				std::ifstream file(path, std::ios_base::binary | std::ios_base::ate);
-				if (file) {
+				std::string content;
+				if (FileCache::Instance().Read(path, content)) {
 					directoryStack.push_back(getDirectory(path));
-					return newIncludeResult(path, file, (int)file.tellg());
+					return newIncludeResult(path, content);
 				}
 			}
 
@@ -127,12 +128,11 @@ namespace ed {
 		}
 
 		// Do actual reading of the file, filling in a new include result.
-		virtual IncludeResult* newIncludeResult(const std::string& path, std::ifstream& file, int length) const
+		virtual IncludeResult* newIncludeResult(const std::string& path, const std::string& source) const
 		{
-			char* content = new tUserDataElement[length];
-			file.seekg(0, file.beg);
-			file.read(content, length);
-			return new IncludeResult(path, content, length, content);
+			char* content = new tUserDataElement[source.size()];
+			memcpy(content, source.data(), source.size());
+			return new IncludeResult(path, content, source.size(), content);
 		}
 
 		// If no path markers, return current working directory.
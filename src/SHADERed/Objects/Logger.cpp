@@ -1,65 +1,110 @@
 #include <SHADERed/Objects/Logger.h>
 #include <SHADERed/Objects/Settings.h>
-#include <ctime>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 
 namespace ed {
-	void Logger::Log(const std::string& msg, bool error, const std::string& file, int line)
+	const size_t Logger::Capacity = 4096; // has to be a power of two
+	const size_t Logger::TailSize = 512;
+	const float Logger::RepeatWindow = 5.0f;
+
+	Logger::Logger()
 	{
-		if (!Settings::Instance().General.Log)
-			return;
+		Stack = nullptr;
 
-		time_t now = time(0);
-		tm* ltm = localtime(&now);
+		m_ring = new Slot[Capacity];
+		for (size_t i = 0; i < Capacity; i++)
+			m_ring[i].Sequence.store(i, std::memory_order_relaxed);
+		m_enqueuePos = 0;
+		m_dequeuePos = 0;
 
-		std::stringstream data;
+		m_level = Level::Info;
+		m_dropped = 0;
+		m_running = false;
 
-		// time
-		data << "[" << std::setw(2) << std::setfill('0') << ltm->tm_hour << ":" << std::setw(2) << std::setfill('0') << ltm->tm_min << ":" << std::setw(2) << std::setfill('0') << ltm->tm_sec << "] ";
+		m_formatTime = 0;
+		m_hasLast = false;
+		m_lastRepeat = 0;
+		m_droppedReported = 0;
+	}
+	Logger::~Logger()
+	{
+		if (m_running) {
+			m_running = false;
+			m_wake.notify_one();
+			m_thread.join();
+		}
 
-		// file and line
-		if (file.size() != 0)
-			data << "<" << file;
+		m_drain();
 
-		if (line != -1) {
-			if (file.size() == 0)
-				data << "<";
-			else
-				data << " ";
-			data << "at line " << line;
-		}
+		delete[] m_ring;
+	}
 
-		if (file.size() != 0 || line != -1)
-			data << "> ";
+	void Logger::Log(const std::string& msg, bool error, const std::string& file, int line)
+	{
+		Log(error ? Level::Error : Level::Info, msg, file, line);
+	}
+	void Logger::Log(Level level, const std::string& msg, const std::string& file, int line)
+	{
+		if (!Settings::Instance().General.Log || level < m_level)
+			return;
 
-		// error
-		if (error)
-			data << "(ERROR) ";
+		std::call_once(m_startFlag, [&]() { m_start(); });
 
-		// message
-		data << msg;
+		// claim a slot
+		Slot* slot = nullptr;
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+		for (int attempt = 0; slot == nullptr;) {
+			Slot* cur = &m_ring[pos & (Capacity - 1)];
+			size_t seq = cur->Sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
 
-		if (Settings::Instance().General.PipeLogsToTerminal)
-			std::cout << data.str() << std::endl;
+			if (diff == 0) {
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					slot = cur;
+			} else if (diff < 0) {
+				// full - give the background thread a chance before dropping the message
+				if (attempt++ == 16) {
+					m_dropped++;
+					return;
+				}
+				m_wake.notify_one();
+				std::this_thread::yield();
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			} else
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+		}
+
+		slot->Data.Type = level;
+		slot->Data.Time = time(0);
+		slot->Data.Text = msg;
+		slot->Data.File = file;
+		slot->Data.Line = line;
+		slot->Data.Stream = Settings::Instance().General.StreamLogs;
+		slot->Data.Pipe = Settings::Instance().General.PipeLogsToTerminal;
+		slot->Sequence.store(pos + 1, std::memory_order_release);
 
-		if (Settings::Instance().General.StreamLogs) {
-			std::ofstream log("log.txt", std::ios_base::app | std::ios_base::out);
-			log << data.str() << std::endl;
-			log.close();
-		} else
-			m_msgs.push_back(data.str());
+		// errors shouldn't wait for the next batch
+		if (level == Level::Error)
+			m_wake.notify_one();
+	}
+	void Logger::Flush()
+	{
+		m_drain();
 	}
 	void Logger::Save()
 	{
+		Flush();
+
 		if (!Settings::Instance().General.Log || Settings::Instance().General.StreamLogs)
 			return;
 
 		time_t now = time(0);
 		tm* ltm = localtime(&now);
 
+		std::unique_lock<std::mutex> lock(m_writeMutex);
+
 		std::ofstream file("log.txt");
 		file << "Log -> " << ltm->tm_mday << "." << ltm->tm_mon + 1 << "." << 1900 + ltm->tm_year << "\n";
 
@@ -68,4 +113,153 @@ namespace ed {
 
 		file.close();
 	}
-}
\ No newline at end of file
+	std::deque<std::string> Logger::GetTail()
+	{
+		std::unique_lock<std::mutex> lock(m_tailMutex);
+		return m_tail;
+	}
+
+	void Logger::m_start()
+	{
+		m_running = true;
+		m_thread = std::thread(&Logger::m_run, this);
+	}
+	void Logger::m_run()
+	{
+		while (m_running) {
+			{
+				std::unique_lock<std::mutex> lock(m_wakeMutex);
+				m_wake.wait_for(lock, std::chrono::milliseconds(50));
+			}
+
+			m_drain();
+		}
+	}
+	bool Logger::m_pop(Message& out)
+	{
+		Slot* slot = &m_ring[m_dequeuePos & (Capacity - 1)];
+		size_t seq = slot->Sequence.load(std::memory_order_acquire);
+		if (seq != m_dequeuePos + 1)
+			return false;
+
+		out = std::move(slot->Data);
+		slot->Sequence.store(m_dequeuePos + Capacity, std::memory_order_release);
+		m_dequeuePos++;
+
+		return true;
+	}
+	void Logger::m_drain()
+	{
+		std::unique_lock<std::mutex> lock(m_writeMutex);
+
+		Message msg;
+		while (m_pop(msg)) {
+			// merge repeated messages
+			if (m_hasLast && msg.Type == m_last.Type && msg.Line == m_last.Line && msg.Text == m_last.Text && msg.File == m_last.File && difftime(msg.Time, m_last.Time) < RepeatWindow) {
+				m_lastRepeat++;
+				continue;
+			}
+
+			m_flushRepeat();
+			m_write(msg, msg.Text, msg.Stream, msg.Pipe);
+
+			m_last = std::move(msg);
+			m_hasLast = true;
+		}
+
+		// message stopped repeating
+		if (m_lastRepeat > 0 && difftime(time(0), m_last.Time) >= RepeatWindow)
+			m_flushRepeat();
+
+		size_t dropped = m_dropped;
+		if (dropped != m_droppedReported && m_hasLast) {
+			Message info = m_last;
+			info.Type = Level::Warning;
+			info.Time = time(0);
+			info.File = "";
+			info.Line = -1;
+			m_write(info, std::to_string(dropped - m_droppedReported) + " log message(s) were dropped", info.Stream, info.Pipe);
+			m_droppedReported = dropped;
+		}
+
+		// write the whole batch at once
+		if (!m_fileBatch.empty()) {
+			if (!m_file.is_open())
+				m_file.open("log.txt", std::ios_base::app | std::ios_base::out);
+			m_file << m_fileBatch;
+			m_file.flush();
+			m_fileBatch.clear();
+		}
+		if (!m_pipeBatch.empty()) {
+			std::cout << m_pipeBatch << std::flush;
+			m_pipeBatch.clear();
+		}
+	}
+	void Logger::m_write(const Message& msg, const std::string& text, bool stream, bool pipe)
+	{
+		// localtime() only once per second
+		if (msg.Time != m_formatTime || m_formatTimeStr.empty()) {
+			tm* ltm = localtime(&msg.Time);
+
+			std::stringstream timeStr;
+			timeStr << "[" << std::setw(2) << std::setfill('0') << ltm->tm_hour << ":" << std::setw(2) << std::setfill('0') << ltm->tm_min << ":" << std::setw(2) << std::setfill('0') << ltm->tm_sec << "] ";
+
+			m_formatTime = msg.Time;
+			m_formatTimeStr = timeStr.str();
+		}
+
+		std::string data = m_formatTimeStr;
+
+		// file and line
+		if (msg.File.size() != 0)
+			data += "<" + msg.File;
+
+		if (msg.Line != -1) {
+			if (msg.File.size() == 0)
+				data += "<";
+			else
+				data += " ";
+			data += "at line " + std::to_string(msg.Line);
+		}
+
+		if (msg.File.size() != 0 || msg.Line != -1)
+			data += "> ";
+
+		// level
+		if (msg.Type == Level::Error)
+			data += "(ERROR) ";
+		else if (msg.Type == Level::Warning)
+			data += "(WARNING) ";
+		else if (msg.Type == Level::Debug)
+			data += "(DEBUG) ";
+
+		// message
+		data += text;
+
+		if (pipe)
+			m_pipeBatch += data + "\n";
+
+		if (stream)
+			m_fileBatch += data + "\n";
+		else
+			m_msgs.push_back(data);
+
+		std::unique_lock<std::mutex> lock(m_tailMutex);
+		m_tail.push_back(data);
+		if (m_tail.size() > TailSize)
+			m_tail.pop_front();
+	}
+	void Logger::m_flushRepeat()
+	{
+		if (m_lastRepeat == 0)
+			return;
+
+		Message info = m_last;
+		info.File = "";
+		info.Line = -1;
+		m_write(info, "last message repeated " + std::to_string(m_lastRepeat) + " more time(s)", m_last.Stream, m_last.Pipe);
+
+		m_last.Time = time(0);
+		m_lastRepeat = 0;
+	}
+}
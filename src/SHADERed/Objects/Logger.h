@@ -1,16 +1,31 @@
 #pragma once
 #include <SHADERed/Objects/MessageStack.h>
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace ed {
+	/* messages are pushed to a lock-free ring buffer (multiple producers, one consumer) and
+		formatted + written in batches on the background thread */
 	class Logger {
 	public:
+		enum class Level {
+			Debug,
+			Info,
+			Warning,
+			Error
+		};
+
 		MessageStack* Stack;
 
-		Logger()
-		{
-			Stack = nullptr;
-		}
+		Logger();
+		~Logger();
 
 		static Logger& Get()
 		{
@@ -18,10 +33,69 @@ namespace ed {
 			return ret;
 		}
 
+		static const size_t Capacity;  // size of the ring buffer
+		static const size_t TailSize;  // number of lines kept for the UI
+		static const float RepeatWindow; // identical messages within this time (in seconds) are merged
+
 		void Log(const std::string& msg, bool error = false, const std::string& file = "", int line = -1);
+		void Log(Level level, const std::string& msg, const std::string& file = "", int line = -1);
+
+		// writes everything that was logged so far
+		void Flush();
 		void Save();
 
+		inline void SetLevel(Level level) { m_level = level; }
+		inline Level GetLevel() { return m_level; }
+
+		// last TailSize formatted lines (doesn't touch the disk)
+		std::deque<std::string> GetTail();
+		inline size_t GetDroppedCount() { return m_dropped; }
+
 	private:
+		struct Message {
+			Level Type;
+			time_t Time;
+			std::string Text, File;
+			int Line;
+			bool Stream, Pipe; // settings at the time of the Log() call
+		};
+		struct Slot {
+			std::atomic<size_t> Sequence;
+			Message Data;
+		};
+
+		void m_start();
+		void m_run();
+		bool m_pop(Message& out);
+		void m_drain();
+		void m_write(const Message& msg, const std::string& text, bool stream, bool pipe);
+		void m_flushRepeat();
+
+		Slot* m_ring;
+		std::atomic<size_t> m_enqueuePos;
+		size_t m_dequeuePos; // only used by the consumer
+
+		std::atomic<Level> m_level;
+		std::atomic<size_t> m_dropped;
+
+		std::thread m_thread;
+		std::atomic<bool> m_running;
+		std::once_flag m_startFlag;
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wake;
+
+		std::mutex m_writeMutex; // consumer side - background thread or Flush()
+		std::ofstream m_file;
+		time_t m_formatTime;
+		std::string m_formatTimeStr;
+		Message m_last; // last written message - used for merging repeated messages
+		bool m_hasLast;
+		int m_lastRepeat;
+		size_t m_droppedReported;
+		std::string m_fileBatch, m_pipeBatch;
 		std::vector<std::string> m_msgs;
+
+		std::mutex m_tailMutex;
+		std::deque<std::string> m_tail;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,115 @@
+#include <SHADERed/Objects/MappedFile.h>
+#include <SHADERed/Objects/Logger.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ed {
+	MappedFile::MappedFile()
+			: m_data(nullptr)
+			, m_size(0)
+			, m_opened(false)
+#if defined(_WIN32)
+			, m_handle(INVALID_HANDLE_VALUE)
+			, m_mapping(nullptr)
+#else
+			, m_handle(-1)
+#endif
+	{
+	}
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+	bool MappedFile::Open(const std::string& file)
+	{
+		Close();
+
+		m_file = file;
+
+#if defined(_WIN32)
+		m_handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (m_handle == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fsize;
+		if (!GetFileSizeEx(m_handle, &fsize)) {
+			Close();
+			return false;
+		}
+		m_size = (size_t)fsize.QuadPart;
+		m_opened = true;
+
+		if (m_size == 0)
+			return true;
+
+		m_mapping = CreateFileMappingA(m_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (m_mapping == nullptr) {
+			Close();
+			return false;
+		}
+
+		m_data = (const char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+		m_handle = open(file.c_str(), O_RDONLY);
+		if (m_handle == -1)
+			return false;
+
+		struct stat st;
+		if (fstat(m_handle, &st) != 0) {
+			Close();
+			return false;
+		}
+		m_size = (size_t)st.st_size;
+		m_opened = true;
+
+		if (m_size == 0)
+			return true;
+
+		void* ptr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_handle, 0);
+		if (ptr != MAP_FAILED) {
+			m_data = (const char*)ptr;
+			madvise(ptr, m_size, MADV_SEQUENTIAL);
+		}
+#endif
+
+		if (m_data == nullptr) {
+			Logger::Get().Log("Failed to map file " + file + " to memory", true);
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+	void MappedFile::Close()
+	{
+#if defined(_WIN32)
+		if (m_data != nullptr)
+			UnmapViewOfFile(m_data);
+		if (m_mapping != nullptr)
+			CloseHandle(m_mapping);
+		if (m_handle != INVALID_HANDLE_VALUE)
+			CloseHandle(m_handle);
+
+		m_mapping = nullptr;
+		m_handle = INVALID_HANDLE_VALUE;
+#else
+		if (m_data != nullptr)
+			munmap((void*)m_data, m_size);
+		if (m_handle != -1)
+			close(m_handle);
+
+		m_handle = -1;
+#endif
+
+		m_data = nullptr;
+		m_size = 0;
+		m_opened = false;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+
+namespace ed {
+	// read-only memory mapping of a whole file
+	class MappedFile {
+	public:
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const std::string& file);
+		void Close();
+
+		inline bool IsOpen() { return m_opened; }
+		inline const char* GetData() { return m_data; }
+		inline size_t GetSize() { return m_size; }
+		inline const std::string& GetFilename() { return m_file; }
+
+	private:
+		std::string m_file;
+		const char* m_data;
+		size_t m_size;
+		bool m_opened; // empty files are "opened" but have no mapping
+
+#if defined(_WIN32)
+		void* m_handle;
+		void* m_mapping;
+#else
+		int m_handle;
+#endif
+	};
+}
@@ -1,64 +1,174 @@
 #include <SHADERed/Objects/MessageStack.h>
 
 namespace ed {
+	const int MessageStack::MaxGroupMessages = 100;
+
 	MessageStack::MessageStack()
 	{
 		BuildOccured = false;
+		for (int i = 0; i < 3; i++)
+			m_count[i] = 0;
 	}
 	MessageStack::~MessageStack()
 	{
 	}
 	void MessageStack::Add(const std::vector<Message>& msgs)
 	{
-		m_msgs.insert(m_msgs.end(), msgs.begin(), msgs.end());
+		for (const auto& msg : msgs)
+			m_add(msg);
 	}
 	void MessageStack::Add(Type type, const std::string& group, const std::string& message, int ln, ShaderStage sh)
 	{
-		m_msgs.push_back({ type, group, message, ln, sh });
+		m_add(Message(type, group, message, ln, sh));
+	}
+	void MessageStack::m_add(const Message& msg)
+	{
+		Group& grp = m_groups[msg.Group];
+
+		// identical message -> only increase the counter
+		std::string key = m_key(msg);
+		auto it = grp.Lookup.find(key);
+		if (it != grp.Lookup.end()) {
+			m_msgs[it->second].Repeat += msg.Repeat;
+			return;
+		}
+
+		grp.Count[(int)msg.MType]++;
+		m_count[(int)msg.MType]++;
+
+		// a broken #include can generate thousands of errors
+		if (grp.Stored >= MaxGroupMessages) {
+			grp.Suppressed[(int)msg.MType]++;
+			m_updateSummary(msg.Group, grp);
+			return;
+		}
+
+		grp.Lookup[key] = m_msgs.size();
+		grp.Stored++;
+		m_msgs.push_back(msg);
 	}
 	void MessageStack::ClearGroup(const std::string& group, int type)
 	{
-		for (int i = 0; i < m_msgs.size(); i++)
-			if (m_msgs[i].Group == group && (type == -1 || m_msgs[i].MType == (ed::MessageStack::Type)type)) {
-				m_msgs.erase(m_msgs.begin() + i);
-				i--;
+		auto grpIt = m_groups.find(group);
+		if (grpIt == m_groups.end())
+			return;
+
+		Group& grp = grpIt->second;
+
+		// update the counters
+		for (int i = 0; i < 3; i++) {
+			if (type != -1 && type != i)
+				continue;
+
+			m_count[i] -= grp.Count[i];
+			grp.Count[i] = 0;
+			grp.Suppressed[i] = 0;
+		}
+
+		bool hasSuppressed = grp.Suppressed[0] + grp.Suppressed[1] + grp.Suppressed[2] > 0;
+
+		// remove the messages
+		std::vector<int> remap(m_msgs.size(), -1);
+		int count = 0;
+		for (int i = 0; i < m_msgs.size(); i++) {
+			if (m_msgs[i].Group == group) {
+				bool isSummary = i == grp.Summary;
+				if ((isSummary && !hasSuppressed) || (!isSummary && (type == -1 || m_msgs[i].MType == (ed::MessageStack::Type)type)))
+					continue;
 			}
+
+			remap[i] = count;
+			if (count != i)
+				m_msgs[count] = std::move(m_msgs[i]);
+			count++;
+		}
+		m_msgs.resize(count);
+
+		if (type == -1)
+			m_groups.erase(grpIt);
+
+		m_reindex(remap);
+
+		if (hasSuppressed)
+			m_updateSummary(group, m_groups[group]);
+	}
+	void MessageStack::Clear()
+	{
+		m_msgs.clear();
+		m_groups.clear();
+		for (int i = 0; i < 3; i++)
+			m_count[i] = 0;
 	}
 	int MessageStack::GetGroupWarningMsgCount(const std::string& group)
 	{
-		int cnt = 0;
-		for (int i = 0; i < m_msgs.size(); i++)
-			if (m_msgs[i].Group == group && m_msgs[i].MType == ed::MessageStack::Type::Warning)
-				cnt++;
-		return cnt;
+		auto it = m_groups.find(group);
+		if (it == m_groups.end())
+			return 0;
+		return it->second.Count[(int)Type::Warning];
 	}
 	int MessageStack::GetErrorAndWarningMsgCount()
 	{
-		int cnt = 0;
-		for (int i = 0; i < m_msgs.size(); i++)
-			if (m_msgs[i].MType == ed::MessageStack::Type::Warning || m_msgs[i].MType == ed::MessageStack::Type::Error)
-				cnt++;
-		return cnt;
+		return m_count[(int)Type::Error] + m_count[(int)Type::Warning];
 	}
 	int MessageStack::GetGroupErrorAndWarningMsgCount(const std::string& group)
 	{
-		int cnt = 0;
-		for (int i = 0; i < m_msgs.size(); i++)
-			if ((m_msgs[i].MType == ed::MessageStack::Type::Warning || m_msgs[i].MType == ed::MessageStack::Type::Error) && m_msgs[i].Group == group)
-				cnt++;
-		return cnt;
+		auto it = m_groups.find(group);
+		if (it == m_groups.end())
+			return 0;
+		return it->second.Count[(int)Type::Error] + it->second.Count[(int)Type::Warning];
 	}
 	void MessageStack::RenameGroup(const std::string& group, const std::string& newName)
 	{
+		auto it = m_groups.find(group);
+		if (it == m_groups.end())
+			return;
+
+		Group grp = std::move(it->second);
+		m_groups.erase(it);
+		m_groups[newName] = std::move(grp);
+
 		for (int i = 0; i < m_msgs.size(); i++)
 			if (m_msgs[i].Group == group)
 				m_msgs[i].Group = newName;
 	}
 	bool MessageStack::CanRenderPreview()
 	{
-		for (int i = 0; i < m_msgs.size(); i++)
-			if (m_msgs[i].MType == Type::Error)
-				return false;
-		return true;
+		return m_count[(int)Type::Error] == 0;
+	}
+
+	std::string MessageStack::m_key(const Message& msg)
+	{
+		return std::to_string((int)msg.MType) + ":" + std::to_string((int)msg.Shader) + ":" + std::to_string(msg.Line) + ":" + msg.Text;
+	}
+	void MessageStack::m_updateSummary(const std::string& name, Group& group)
+	{
+		int total = group.Suppressed[0] + group.Suppressed[1] + group.Suppressed[2];
+
+		std::string text = std::to_string(total) + " more message(s) not shown (" + std::to_string(group.Suppressed[(int)Type::Error]) + " error(s), " + std::to_string(group.Suppressed[(int)Type::Warning]) + " warning(s))";
+
+		if (group.Summary == -1) {
+			group.Summary = m_msgs.size();
+			m_msgs.push_back(Message(Type::Message, name, text));
+		} else
+			m_msgs[group.Summary].Text = text;
+	}
+	void MessageStack::m_reindex(const std::vector<int>& remap)
+	{
+		for (auto& pair : m_groups) {
+			Group& grp = pair.second;
+			if (grp.Summary != -1)
+				grp.Summary = remap[grp.Summary];
+			grp.Stored = 0;
+			grp.Lookup.clear();
+		}
+
+		for (int i = 0; i < m_msgs.size(); i++) {
+			Group& grp = m_groups[m_msgs[i].Group];
+			if (i == grp.Summary)
+				continue;
+
+			grp.Lookup[m_key(m_msgs[i])] = i;
+			grp.Stored++;
+		}
 	}
-}
\ No newline at end of file
+}
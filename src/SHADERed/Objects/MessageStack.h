@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <SHADERed/Objects/ShaderStage.h>
 
@@ -23,6 +24,7 @@ namespace ed {
 				Text = "";
 				Line = -1;
 				Shader = ShaderStage::Count;
+				Repeat = 1;
 			}
 			Message(Type type, const std::string& group, const std::string& txt, int line = -1, ShaderStage shader = ShaderStage::Count)
 			{
@@ -31,22 +33,26 @@ namespace ed {
 				Text = txt;
 				Line = line;
 				Shader = shader;
+				Repeat = 1;
 			}
 			Type MType;
 			std::string Group;
 			std::string Text;
 			int Line;
 			ShaderStage Shader;
+			int Repeat; // number of identical messages merged into this one
 		};
 
+		static const int MaxGroupMessages; // messages over this limit are only counted
+
 		bool BuildOccured;		 // have we recompiled project/shader? if yes and an error has occured we can open error window
 		std::string CurrentItem; // a shader pass that we are currently compiling
-		
+
 		// group -> pipeline item name
 		void Add(const std::vector<Message>& msgs);
 		void Add(Type type, const std::string& group, const std::string& message, int ln = -1, ShaderStage sh = ShaderStage::Count);
 		void ClearGroup(const std::string& group, int type = -1);
-		inline void Clear() { m_msgs.clear(); }
+		void Clear();
 		int GetGroupWarningMsgCount(const std::string& group);
 		int GetErrorAndWarningMsgCount();
 		int GetGroupErrorAndWarningMsgCount(const std::string& group);
@@ -54,9 +60,32 @@ namespace ed {
 
 		bool CanRenderPreview();
 
-		inline std::vector<Message>& GetMessages() { return m_msgs; }
+		inline const std::vector<Message>& GetMessages() { return m_msgs; }
 
 	private:
+		struct Group {
+			Group()
+			{
+				Stored = 0;
+				Summary = -1;
+				for (int i = 0; i < 3; i++)
+					Count[i] = Suppressed[i] = 0;
+			}
+
+			int Count[3];	   // per Type, including the suppressed messages
+			int Suppressed[3]; // per Type
+			int Stored;		   // number of entries in m_msgs (without the summary)
+			int Summary;	   // index of the "N more messages" entry or -1
+			std::unordered_map<std::string, int> Lookup; // message key -> index in m_msgs
+		};
+
+		void m_add(const Message& msg); // keeps msg.Repeat
+		std::string m_key(const Message& msg);
+		void m_updateSummary(const std::string& name, Group& group);
+		void m_reindex(const std::vector<int>& remap); // remap: old index -> new index or -1
+
 		std::vector<Message> m_msgs;
+		std::unordered_map<std::string, Group> m_groups;
+		int m_count[3];
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,11 @@
+#pragma once
+// declarations of the bundled miniz for every file except WebAPI.cpp (which compiles the implementation) -
+// zip_file.hpp always defines the miniz_cpp wrapper with non-inline helpers, so the wrapper is
+// moved into an anonymous namespace here instead of colliding with the one in WebAPI.cpp
+#include <cassert>
+
+#define MINIZ_HEADER_FILE_ONLY
+#define miniz_cpp
+#include <miniz/zip_file.hpp>
+#undef miniz_cpp
+#undef MINIZ_HEADER_FILE_ONLY
@@ -3,6 +3,7 @@
 #include <SHADERed/Objects/ObjectManager.h>
 #include <SHADERed/Objects/RenderEngine.h>
 #include <SHADERed/Objects/Settings.h>
+#include <SHADERed/Objects/StreamingUploader.h>
 #include <SHADERed/Engine/Model.h>
 
 #include <SFML/Audio/Sound.hpp>
@@ -22,18 +23,40 @@ namespace ed {
 	{
 		m_binds.clear();
 		memset(m_kbTexture, 0, sizeof(unsigned char) * 256 * 3);
+		memset(m_kbUploaded, 0, sizeof(unsigned char) * 256 * 3);
 	}
 	ObjectManager::~ObjectManager()
 	{
 		Clear();
 	}
 
-	void loadCubemapFace(GLuint face, const std::string& path, int& w, int& h)
+	// decodes the image straight from the project archive if the file is stored there
+	unsigned char* loadImage(ProjectParser* parser, const std::string& file, int* w, int* h, int* nrChannels, int reqChannels, bool flip)
 	{
-		stbi_set_flip_vertically_on_load(0);
+		// already decoded while loading the project
+		unsigned char* loaded = parser->GetLoader().TakeImage(file, flip, reqChannels, w, h, nrChannels);
+		if (loaded != nullptr)
+			return loaded;
 
+		stbi_set_flip_vertically_on_load(flip);
+
+		std::string entry = parser->GetArchiveEntry(file);
+		if (!entry.empty()) {
+			std::string storage;
+			size_t size = 0;
+			const char* data = parser->GetArchive().GetData(entry, size, storage);
+			if (data == nullptr)
+				return nullptr;
+
+			return stbi_load_from_memory((const stbi_uc*)data, (int)size, w, h, nrChannels, reqChannels);
+		}
+
+		return stbi_load(parser->GetProjectPath(file).c_str(), w, h, nrChannels, reqChannels);
+	}
+	void loadCubemapFace(ProjectParser* parser, GLuint face, const std::string& file, int& w, int& h)
+	{
 		int nrChannels = 0;
-		unsigned char* data = stbi_load(path.c_str(), &w, &h, &nrChannels, 0);
+		unsigned char* data = loadImage(parser, file, &w, &h, &nrChannels, 0, false);
 		unsigned char* paddedData = nullptr;
 
 		if (nrChannels != 4) {
@@ -145,11 +168,8 @@ namespace ed {
 			return false;
 		}
 
-		stbi_set_flip_vertically_on_load(1);
-
-		std::string path = m_parser->GetProjectPath(file);
 		int width, height, nrChannels;
-		unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrChannels, STBI_rgb_alpha);
+		unsigned char* data = loadImage(m_parser, file, &width, &height, &nrChannels, STBI_rgb_alpha, true);
 		
 		if (data == nullptr) {
 			Logger::Get().Log("Failed to load a texture " + file + " from file", true);
@@ -233,27 +253,27 @@ namespace ed {
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
 		// left face
-		loadCubemapFace(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, m_parser->GetProjectPath(left), width, height);
+		loadCubemapFace(m_parser, GL_TEXTURE_CUBE_MAP_NEGATIVE_X, left, width, height);
 		item->CubemapPaths.push_back(left);
 
 		// top
-		loadCubemapFace(GL_TEXTURE_CUBE_MAP_POSITIVE_Y, m_parser->GetProjectPath(top), width, height);
+		loadCubemapFace(m_parser, GL_TEXTURE_CUBE_MAP_POSITIVE_Y, top, width, height);
 		item->CubemapPaths.push_back(top);
 
 		// front
-		loadCubemapFace(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, m_parser->GetProjectPath(front), width, height);
+		loadCubemapFace(m_parser, GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, front, width, height);
 		item->CubemapPaths.push_back(front);
 
 		// bottom
-		loadCubemapFace(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, m_parser->GetProjectPath(bottom), width, height);
+		loadCubemapFace(m_parser, GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, bottom, width, height);
 		item->CubemapPaths.push_back(bottom);
 
 		// right
-		loadCubemapFace(GL_TEXTURE_CUBE_MAP_POSITIVE_X, m_parser->GetProjectPath(right), width, height);
+		loadCubemapFace(m_parser, GL_TEXTURE_CUBE_MAP_POSITIVE_X, right, width, height);
 		item->CubemapPaths.push_back(right);
 
 		// back
-		loadCubemapFace(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, m_parser->GetProjectPath(back), width, height);
+		loadCubemapFace(m_parser, GL_TEXTURE_CUBE_MAP_POSITIVE_Z, back, width, height);
 		item->CubemapPaths.push_back(back);
 
 		// clean up
@@ -274,7 +294,15 @@ namespace ed {
 		ObjectManagerItem* item = new ObjectManagerItem();
 
 		item->SoundBuffer = new sf::SoundBuffer();
-		bool loaded = item->SoundBuffer->loadFromFile(m_parser->GetProjectPath(file));
+		bool loaded = false;
+		std::string entry = m_parser->GetArchiveEntry(file);
+		if (!entry.empty()) {
+			std::string storage;
+			size_t size = 0;
+			const char* data = m_parser->GetArchive().GetData(entry, size, storage);
+			loaded = data != nullptr && item->SoundBuffer->loadFromMemory(data, size);
+		} else
+			loaded = item->SoundBuffer->loadFromFile(m_parser->GetProjectPath(file));
 		if (!loaded) {
 			delete item;
 			ed::Logger::Get().Log("Failed to load an audio file " + file, true);
@@ -321,8 +349,11 @@ namespace ed {
 		glm::ivec2 size = m_renderer->GetLastRenderSize();
 
 		bObj->PreviewPaused = false;
+		bObj->Dirty = true;
 		bObj->Size = 0;
+		bObj->GPUSize = 0;
 		bObj->Data = nullptr;
+		bObj->Mapping = nullptr;
 		strcpy(bObj->ViewFormat, "float");
 
 		glGenBuffers(1, &bObj->ID);
@@ -441,7 +472,7 @@ namespace ed {
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_kbTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, fmt, GL_UNSIGNED_BYTE, m_kbTexture);
 		glGenerateMipmap(GL_TEXTURE_2D);
 		glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -522,6 +553,8 @@ namespace ed {
 		if (data != nullptr) {
 			m_parser->ModifyProject();
 
+			m_unmapBuffer(buf);
+
 			if (convertToFloat) {
 				buf->Size = width * height * nrChannels * sizeof(float);
 				buf->Data = realloc(buf->Data, buf->Size);
@@ -542,11 +575,9 @@ namespace ed {
 			}
 
 			stbi_image_free(data);
+			buf->Dirty = true;
 
-			
-			glBindBuffer(GL_UNIFORM_BUFFER, buf->ID);
-			glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // upload data
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			UploadBuffer(buf);
 		}
 
 		return data != nullptr;
@@ -554,7 +585,7 @@ namespace ed {
 	bool ObjectManager::LoadBufferFromModel(BufferObject* buf, const std::string& str)
 	{
 		ed::eng::Model mdl;
-		bool ret = mdl.LoadFromFile(str);
+		bool ret = mdl.ImportFromFile(str); // only the vertex data is needed
 
 		if (ret) {
 			int vertCount = 0;
@@ -562,6 +593,7 @@ namespace ed {
 				vertCount += mesh.Vertices.size();
 			int bufSize = vertCount * 4 * sizeof(float);
 
+			m_unmapBuffer(buf);
 			buf->Size = bufSize;
 			buf->Data = realloc(buf->Data, bufSize);
 
@@ -575,10 +607,9 @@ namespace ed {
 					fData[index + 3] = 1.0f;
 					index += 4;
 				}
+			buf->Dirty = true;
 
-			glBindBuffer(GL_UNIFORM_BUFFER, buf->ID);
-			glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // upload data
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			UploadBuffer(buf);
 		}
 
 		return ret;
@@ -586,38 +617,31 @@ namespace ed {
 	bool ObjectManager::LoadBufferFromFile(BufferObject* buf, const std::string& str)
 	{
 		std::string bPath = m_parser->GetProjectPath(str);
-		std::ifstream bufRead(bPath, std::ios::binary | std::ios::ate);
-		size_t bufSize = bufRead.tellg();
-		bufRead.seekg(0, std::ios::beg);
+		MappedFile* bufFile = new MappedFile();
 
-		bool ret = bufRead.is_open();
+		bool ret = bufFile->Open(bPath);
 		if (ret) {
-			buf->Size = bufSize;
-			buf->Data = realloc(buf->Data, bufSize);
-			char* data = (char*)calloc(1, bufSize);
-			bufRead.read(data, bufSize);
-			memcpy(buf->Data, data, bufSize);
-			free(data);
-
-			glBindBuffer(GL_UNIFORM_BUFFER, buf->ID);
-			glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // upload data
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-		}
-
-		bufRead.close();
+			// uploaded straight from the mapping, Data is filled once the CPU needs it
+			m_unmapBuffer(buf);
+			free(buf->Data);
+			buf->Data = nullptr;
+			buf->Mapping = bufFile;
+			buf->Size = bufFile->GetSize();
+			buf->Dirty = true;
+
+			UploadBuffer(buf);
+		} else
+			delete bufFile;
 
 		return ret;
 	}
 
 	bool ObjectManager::ReloadTexture(ObjectManagerItem* item, const std::string& newPath)
 	{
-		stbi_set_flip_vertically_on_load(1);
-
 		for (int i = 0; i < m_itemData.size(); i++) {
 			if (m_itemData[i] == item) {
-				std::string path = m_parser->GetProjectPath(newPath);
 				int width, height, nrChannels;
-				unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrChannels, STBI_rgb_alpha);
+				unsigned char* data = loadImage(m_parser, newPath, &width, &height, &nrChannels, STBI_rgb_alpha, true);
 
 				if (data == nullptr)
 					return false;
@@ -861,6 +885,18 @@ namespace ed {
 	}
 	void ObjectManager::Update(float delta)
 	{
+		StreamingUploader& uploader = StreamingUploader::Instance();
+
+		// keyboard rows that changed since the last upload
+		int kbFirstRow = -1, kbLastRow = -1;
+		for (int row = 0; row < 3; row++) {
+			if (memcmp(&m_kbTexture[row * 256], &m_kbUploaded[row * 256], 256) != 0) {
+				if (kbFirstRow == -1)
+					kbFirstRow = row;
+				kbLastRow = row;
+			}
+		}
+
 		for (auto& it : m_itemData) {
 			// update audio items
 			if (it->SoundBuffer != nullptr) {
@@ -881,18 +917,16 @@ namespace ed {
 					m_audioTempTexData[i + ed::AudioAnalyzer::SampleCount] = sf * 0.5f + 0.5f;
 				}
 
-				glBindTexture(GL_TEXTURE_2D, it->Texture);
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, 512, 2, 0, GL_RED, GL_FLOAT, m_audioTempTexData);
-				glBindTexture(GL_TEXTURE_2D, 0);
+				uploader.UploadTexture(it->Texture, 0, 0, ed::AudioAnalyzer::SampleCount, 2, GL_RED, GL_FLOAT, m_audioTempTexData);
 			}
 			// update kb texture
-			else if (it->IsKeyboardTexture) {
-				glBindTexture(GL_TEXTURE_2D, it->Texture);
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, 256, 3, 0, GL_RED, GL_UNSIGNED_BYTE, m_kbTexture);
-				glBindTexture(GL_TEXTURE_2D, 0);
-				memset(&m_kbTexture[256], 0, sizeof(unsigned char) * 256);
-			}
+			else if (it->IsKeyboardTexture && kbFirstRow != -1)
+				uploader.UploadTexture(it->Texture, 0, kbFirstRow, 256, kbLastRow - kbFirstRow + 1, GL_RED, GL_UNSIGNED_BYTE, &m_kbTexture[kbFirstRow * 256]);
 		}
+
+		if (kbFirstRow != -1)
+			memcpy(m_kbUploaded, m_kbTexture, sizeof(unsigned char) * 256 * 3);
+		memset(&m_kbTexture[256], 0, sizeof(unsigned char) * 256);
 	}
 	void ObjectManager::Remove(const std::string& file)
 	{
@@ -1177,9 +1211,7 @@ namespace ed {
 					memcpy(&resPixels[(height - y - 1) * width * 4], &pixels[(texSize.y - y - 1) * texSize.x * 4], width * 4);
 			}
 
-			glBindTexture(GL_TEXTURE_2D, img->Texture);
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, resPixels);
-			glBindTexture(GL_TEXTURE_2D, 0);
+			StreamingUploader::Instance().UploadTexture(img->Texture, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, resPixels);
 
 			if (needsResize)
 				free(resPixels);
@@ -1188,13 +1220,51 @@ namespace ed {
 		} else {
 			unsigned char* pixels = (unsigned char*)calloc(img->Size.x * img->Size.y, 4);
 
-			glBindTexture(GL_TEXTURE_2D, img->Texture);
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, img->Size.x, img->Size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-			glBindTexture(GL_TEXTURE_2D, 0);
+			StreamingUploader::Instance().UploadTexture(img->Texture, 0, 0, img->Size.x, img->Size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
 			free(pixels);
 		}
 	}
+	void ObjectManager::UploadBuffer(BufferObject* buf, int offset, int size)
+	{
+		if (size < 0)
+			size = buf->Size - offset;
+		size = std::min<int>(size, buf->Size - offset);
+
+		const char* data = (const char*)buf->Data;
+		if (buf->Mapping != nullptr)
+			data = buf->Mapping->GetData();
+
+		// storage is only reallocated when the buffer was resized - the whole buffer is uploaded with it
+		if (buf->GPUSize != buf->Size) {
+			glBindBuffer(GL_UNIFORM_BUFFER, buf->ID);
+			glBufferData(GL_UNIFORM_BUFFER, buf->Size, data, GL_STATIC_DRAW);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+			buf->GPUSize = buf->Size;
+			return;
+		}
+
+		if (data != nullptr && offset >= 0 && size > 0)
+			StreamingUploader::Instance().UploadBuffer(buf->ID, offset, size, data + offset);
+	}
+	void ObjectManager::RequireBufferData(BufferObject* buf)
+	{
+		if (buf->Mapping == nullptr)
+			return;
+
+		buf->Data = realloc(buf->Data, buf->Size);
+		if (buf->Size > 0)
+			memcpy(buf->Data, buf->Mapping->GetData(), std::min<size_t>(buf->Size, buf->Mapping->GetSize()));
+
+		delete buf->Mapping;
+		buf->Mapping = nullptr;
+	}
+	void ObjectManager::m_unmapBuffer(BufferObject* buf)
+	{
+		delete buf->Mapping;
+		buf->Mapping = nullptr;
+	}
 	void ObjectManager::SaveToFile(const std::string& itemName, ObjectManagerItem* item, const std::string& filepath)
 	{
 		glm::vec2 imgSize = item->ImageSize;
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include <SHADERed/Objects/AudioAnalyzer.h>
+#include <SHADERed/Objects/MappedFile.h>
 #include <SHADERed/Objects/PipelineItem.h>
 #include <SHADERed/Objects/ProjectParser.h>
 
@@ -46,10 +47,13 @@ namespace ed {
 
 	struct BufferObject {
 		int Size;
-		void* Data;
+		void* Data;			 // nullptr while Mapping is set - see ObjectManager::RequireBufferData
+		MappedFile* Mapping; // file the buffer was uploaded from, until the CPU needs the data
 		char ViewFormat[256]; // vec3;vec3;vec2
 		GLuint ID;
+		int GPUSize; // size of the allocated storage, updated by ObjectManager::UploadBuffer
 		bool PreviewPaused;
+		bool Dirty; // Data differs from the buffers/<name>.buf file
 	};
 
 	struct ImageObject {
@@ -104,6 +108,7 @@ namespace ed {
 			if (Buffer != nullptr) {
 				glDeleteBuffers(1, &Buffer->ID);
 				free(Buffer->Data);
+				delete Buffer->Mapping;
 				delete Buffer;
 			}
 			if (Image != nullptr) {
@@ -195,6 +200,8 @@ namespace ed {
 		bool IsCubeMap(GLuint id);
 
 		void UploadDataToImage(ImageObject* img, GLuint tex, glm::ivec2 texSize);
+		void UploadBuffer(BufferObject* buf, int offset = 0, int size = -1); // uploads buf->Data[offset, offset+size), GPU storage is reallocated only if the size changed
+		void RequireBufferData(BufferObject* buf);							// copies a mapped buffer file into buf->Data - call before the CPU reads or edits it
 		void SaveToFile(const std::string& itemName, ObjectManagerItem* item, const std::string& filepath);
 
 		void ResizeRenderTexture(const std::string& name, glm::ivec2 size);
@@ -270,6 +277,8 @@ namespace ed {
 		RenderEngine* m_renderer;
 		ProjectParser* m_parser;
 
+		void m_unmapBuffer(BufferObject* buf); // Data is about to be replaced
+
 		std::vector<std::string> m_items; // TODO: move item name to item data
 		std::vector<ObjectManagerItem*> m_itemData;
 
@@ -281,6 +290,7 @@ namespace ed {
 		float m_audioTempTexData[ed::AudioAnalyzer::SampleCount * 2];
 
 		unsigned char m_kbTexture[256 * 3];
+		unsigned char m_kbUploaded[256 * 3]; // only the rows that changed are uploaded
 
 		std::unordered_map<PipelineItem*, std::vector<GLuint>> m_binds;
 		std::unordered_map<PipelineItem*, std::vector<GLuint>> m_uniformBinds;
@@ -67,6 +67,9 @@ namespace ed {
 
 				WorkX = WorkY = WorkZ = 1;
 				Active = true;
+				Iterations = 1;
+				IndirectBuffer = nullptr;
+				PingPongSwapped = false;
 			}
 
 			char Path[SHADERED_MAX_PATH];
@@ -76,8 +79,15 @@ namespace ed {
 			bool Active;
 
 			GLuint WorkX, WorkY, WorkZ;
+			int Iterations;		  // dispatches per frame
+			void* IndirectBuffer; // BufferObject*, the group count is read from it (glDispatchComputeIndirect) instead of WorkX/Y/Z
+
+			// bound buffers/images whose binding slots are swapped after every iteration
+			std::vector<std::pair<std::string, std::string>> PingPong;
+			bool PingPongSwapped; // an odd number of iterations leaves the pairs swapped for the next frame
 			ShaderVariableContainer Variables;
 			std::vector<ShaderMacro> Macros;
+			std::vector<MacroPermutation> Permutations;
 		};
 
 		struct AudioPass {
@@ -133,6 +143,7 @@ namespace ed {
 
 			ShaderVariableContainer Variables;
 			std::vector<ShaderMacro> Macros;
+			std::vector<MacroPermutation> Permutations;
 
 			std::vector<InputLayoutItem> InputLayout;
 
@@ -142,6 +142,10 @@ namespace ed {
 		typedef bool (*ImGuiFileDialogGetResultFn)();
 		typedef void (*ImGuiFileDialogGetPathFn)(char* outPath);
 		typedef const char* (*DebuggerImmediateFn)(void* Debugger, const char* expr);
+
+		/********** IPlugin3 **********/
+		typedef bool (*UploadBufferDataFn)(void* objects, const char* name, int offset, int size, const void* data);
+		typedef bool (*UploadImageDataFn)(void* objects, const char* name, int x, int y, int width, int height, unsigned int format, unsigned int type, const void* data);
 	}
 
 	// CreatePlugin(), DestroyPlugin(ptr), GetPluginAPIVersion(), GetPluginVersion(), GetPluginName()
@@ -470,4 +474,13 @@ namespace ed {
 		pluginfn::ImGuiFileDialogGetPathFn ImGuiFileDialogGetPath;
 		pluginfn::DebuggerImmediateFn DebuggerImmediate;
 	};
+
+	class IPlugin3 : public IPlugin2 {
+	public:
+		virtual int GetVersion() { return 3; }
+
+		// only the given range is uploaded (through the host's streaming uploader)
+		pluginfn::UploadBufferDataFn UploadBufferData;
+		pluginfn::UploadImageDataFn UploadImageData; // tightly packed, GL_RED/RG/RGB/BGR/RGBA/BGRA (or _INTEGER) with a byte, short, half float, int or float type
+	};
 }
\ No newline at end of file
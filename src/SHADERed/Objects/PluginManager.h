@@ -14,21 +14,36 @@ namespace ed {
 
 	class PluginManager {
 	public:
-		void Init(InterfaceManager* data, GUIManager* ui); // load all the plugins here
+		// plugins/<name>/manifest.ini - plugins that have it are loaded only when they are needed (language plugins on startup)
+		struct Manifest {
+			std::string Directory;
+			std::string Name;
+			int Version = 0, APIVersion = 0;
+			std::vector<std::pair<std::string, std::vector<std::string>>> Languages; // language name -> file extensions
+			std::vector<std::string> Items, Objects;
+			std::vector<std::string> Menus; // menus (and context menus) that the plugin adds items to
+			std::vector<std::string> Files; // file extensions handled through HandleDropFile
+			bool Startup = false;			// load on startup anyway
+		};
+
+		void Init(InterfaceManager* data, GUIManager* ui); // load the plugins without a manifest and the language plugins here
 		void Destroy();									   // destroy all the plugins
 		void Update(float delta);
 
 		void BeginRender();
 		void EndRender();
 
-		IPlugin1* GetPlugin(const std::string& plugin);
+		IPlugin1* GetPlugin(const std::string& plugin); // loads the plugin if needed
 		const std::string& GetPluginName(IPlugin1* plugin);
 		int GetPluginVersion(const std::string& plugin);
 		int GetPluginAPIVersion(const std::string& plugin);
 
+		const Manifest* GetManifest(const std::string& plugin); // nullptr if the plugin is already loaded
+
 		bool IsLoaded(const std::string& plugin);
+		bool IsInstalled(const std::string& plugin);
 
-		inline const std::vector<std::string>& GetPluginList() { return m_names; }
+		inline const std::vector<std::string>& GetPluginList() { return m_installed; }
 
 		void ShowCustomMenu();
 		void ShowMenuItems(const std::string& menu);
@@ -51,12 +66,24 @@ namespace ed {
 		inline const std::vector<std::string>& GetIncompatiblePlugins() { return m_incompatible; }
 
 	private:
+		IPlugin1* m_load(const std::string& pdir, std::string& pname);
+		IPlugin1* m_load(Manifest manifest);
+		bool m_readManifest(const std::string& pdir, Manifest& manifest);
+		void m_registerLanguage(const std::string& name, const std::string& ext);
+
+		InterfaceManager* m_data = nullptr;
+		GUIManager* m_ui = nullptr;
+		std::string m_pluginsDir;
+		std::vector<std::string> m_iniLines;
+
+		std::vector<Manifest> m_available; // not loaded yet
+		std::vector<std::string> m_installed;
+
 		std::vector<void*> m_proc;
 		std::vector<IPlugin1*> m_plugins;
 		std::vector<std::string> m_names;
 		std::vector<int> m_pluginVersion, m_apiVersion;
 
-		
 		std::vector<std::string> m_incompatible;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,321 @@
+#include <SHADERed/Objects/Logger.h>
+#include <SHADERed/Objects/MinizHeader.h>
+#include <SHADERed/Objects/ProjectArchive.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace ed {
+	const char* ProjectArchive::ProjectEntry = "project.sprj";
+	const size_t ProjectArchive::StoreThreshold = 1024 * 1024;
+
+	ProjectArchive::ProjectArchive()
+			: m_reader(nullptr)
+			, m_writer(nullptr)
+	{
+	}
+	ProjectArchive::~ProjectArchive()
+	{
+		if (m_writer != nullptr) {
+			sed_mz_zip_writer_end(m_writer);
+			delete m_writer;
+
+			std::error_code ec;
+			std::filesystem::remove(m_writeFile, ec);
+		}
+
+		Close();
+	}
+
+	bool ProjectArchive::IsArchive(const std::string& file)
+	{
+		std::string ext = std::filesystem::path(file).extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+		return ext == ".sprjz";
+	}
+	bool ProjectArchive::ShouldStore(const std::string& entry, size_t size)
+	{
+		if (size >= StoreThreshold)
+			return true;
+
+		// already compressed formats
+		static const char* compressedExts[] = { ".png", ".jpg", ".jpeg", ".ogg", ".flac", ".mp3" };
+
+		std::string ext = std::filesystem::path(entry).extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+		for (const char* cext : compressedExts)
+			if (ext == cext)
+				return true;
+
+		return false;
+	}
+
+	bool ProjectArchive::Open(const std::string& file)
+	{
+		Close();
+
+		if (!m_map.Open(file)) {
+			Logger::Get().Log("Failed to open project archive " + file, true);
+			return false;
+		}
+
+		m_reader = new sed_mz_zip_archive();
+		memset(m_reader, 0, sizeof(sed_mz_zip_archive));
+
+		if (!sed_mz_zip_reader_init_mem(m_reader, m_map.GetData(), m_map.GetSize(), 0)) {
+			Logger::Get().Log("File " + file + " is not a valid project archive", true);
+			Close();
+			return false;
+		}
+
+		m_file = file;
+
+		return true;
+	}
+	void ProjectArchive::Close()
+	{
+		if (m_reader != nullptr) {
+			sed_mz_zip_reader_end(m_reader);
+			delete m_reader;
+			m_reader = nullptr;
+		}
+
+		m_map.Close();
+		m_modified.clear();
+		m_file = "";
+	}
+
+	bool ProjectArchive::Exists(const std::string& entry)
+	{
+		return m_modified.count(entry) > 0 || m_locate(entry) >= 0;
+	}
+	size_t ProjectArchive::GetSize(const std::string& entry)
+	{
+		auto mod = m_modified.find(entry);
+		if (mod != m_modified.end())
+			return mod->second.size();
+
+		int index = m_locate(entry);
+		if (index < 0)
+			return 0;
+
+		sed_mz_zip_archive_file_stat stat;
+		if (!sed_mz_zip_reader_file_stat(m_reader, index, &stat))
+			return 0;
+
+		return stat.m_uncomp_size;
+	}
+	std::vector<std::string> ProjectArchive::GetEntries()
+	{
+		std::vector<std::string> ret;
+		if (m_reader == nullptr)
+			return ret;
+
+		sed_mz_uint count = sed_mz_zip_reader_get_num_files(m_reader);
+		for (sed_mz_uint i = 0; i < count; i++) {
+			sed_mz_zip_archive_file_stat stat;
+			if (sed_mz_zip_reader_file_stat(m_reader, i, &stat) && !sed_mz_zip_reader_is_file_a_directory(m_reader, i))
+				ret.push_back(stat.m_filename);
+		}
+
+		return ret;
+	}
+
+	const char* ProjectArchive::GetData(const std::string& entry, size_t& size, std::string& storage)
+	{
+		size = 0;
+
+		auto mod = m_modified.find(entry);
+		if (mod != m_modified.end()) {
+			size = mod->second.size();
+			return mod->second.data();
+		}
+
+		int index = m_locate(entry);
+		if (index < 0)
+			return nullptr;
+
+		sed_mz_zip_archive_file_stat stat;
+		if (!sed_mz_zip_reader_file_stat(m_reader, index, &stat))
+			return nullptr;
+
+		// stored entries can be used directly from the mapping
+		if (stat.m_method == 0 && !(stat.m_bit_flag & 1) && stat.m_comp_size == stat.m_uncomp_size) {
+			const unsigned char* header = (const unsigned char*)m_map.GetData() + stat.m_local_header_ofs;
+			if (stat.m_local_header_ofs + 30 <= m_map.GetSize() && header[0] == 'P' && header[1] == 'K' && header[2] == 3 && header[3] == 4) {
+				size_t nameLen = header[26] | (header[27] << 8);
+				size_t extraLen = header[28] | (header[29] << 8);
+				size_t dataOffset = stat.m_local_header_ofs + 30 + nameLen + extraLen;
+
+				if (dataOffset + stat.m_uncomp_size <= m_map.GetSize()) {
+					size = stat.m_uncomp_size;
+					return m_map.GetData() + dataOffset;
+				}
+			}
+		}
+
+		storage.resize(stat.m_uncomp_size);
+		if (stat.m_uncomp_size > 0 && !sed_mz_zip_reader_extract_to_mem(m_reader, index, &storage[0], storage.size(), 0)) {
+			Logger::Get().Log("Failed to extract " + entry + " from the project archive", true);
+			storage.clear();
+			return nullptr;
+		}
+
+		size = storage.size();
+		return storage.data();
+	}
+	bool ProjectArchive::Read(const std::string& entry, void* dst, size_t dstSize)
+	{
+		int index = m_modified.count(entry) ? -1 : m_locate(entry);
+
+		// inflate straight into the destination when it can hold the whole entry
+		if (index >= 0 && GetSize(entry) <= dstSize) {
+			sed_mz_zip_archive_file_stat stat;
+			if (sed_mz_zip_reader_file_stat(m_reader, index, &stat) && stat.m_method != 0)
+				return sed_mz_zip_reader_extract_to_mem(m_reader, index, dst, dstSize, 0);
+		}
+
+		std::string storage;
+		size_t size = 0;
+		const char* data = GetData(entry, size, storage);
+		if (data == nullptr)
+			return false;
+
+		memcpy(dst, data, std::min<size_t>(size, dstSize));
+
+		return true;
+	}
+	std::string ProjectArchive::Read(const std::string& entry)
+	{
+		std::string storage;
+		size_t size = 0;
+		const char* data = GetData(entry, size, storage);
+
+		if (data == nullptr)
+			return "";
+		if (data == storage.data())
+			return storage;
+
+		return std::string(data, size);
+	}
+	void ProjectArchive::Modify(const std::string& entry, const std::string& data)
+	{
+		m_modified[entry] = data;
+	}
+
+	bool ProjectArchive::BeginWrite(const std::string& file)
+	{
+		if (m_writer != nullptr)
+			return false;
+
+		m_writeFile = file + ".tmp";
+		m_written.clear();
+
+		m_writer = new sed_mz_zip_archive();
+		memset(m_writer, 0, sizeof(sed_mz_zip_archive));
+
+		if (!sed_mz_zip_writer_init_file(m_writer, m_writeFile.c_str(), 0)) {
+			Logger::Get().Log("Failed to create project archive " + m_writeFile, true);
+			delete m_writer;
+			m_writer = nullptr;
+			return false;
+		}
+
+		return true;
+	}
+	bool ProjectArchive::Write(const std::string& entry, const void* data, size_t size)
+	{
+		if (m_writer == nullptr)
+			return false;
+		if (m_written.count(entry))
+			return true;
+
+		sed_mz_uint level = ShouldStore(entry, size) ? sed_mz_NO_COMPRESSION : sed_mz_DEFAULT_LEVEL;
+		if (!sed_mz_zip_writer_add_mem(m_writer, entry.c_str(), data, size, level)) {
+			Logger::Get().Log("Failed to write " + entry + " to the project archive", true);
+			return false;
+		}
+
+		m_written.insert(entry);
+
+		return true;
+	}
+	bool ProjectArchive::WriteFile(const std::string& entry, const std::string& path)
+	{
+		MappedFile src;
+		if (!src.Open(path))
+			return false;
+
+		return Write(entry, src.GetData(), src.GetSize());
+	}
+	bool ProjectArchive::CopyEntry(const std::string& entry)
+	{
+		if (m_writer == nullptr)
+			return false;
+		if (m_written.count(entry))
+			return true;
+
+		auto mod = m_modified.find(entry);
+		if (mod != m_modified.end())
+			return Write(entry, mod->second.data(), mod->second.size());
+
+		int index = m_locate(entry);
+		if (index < 0)
+			return false;
+
+		if (!sed_mz_zip_writer_add_from_zip_reader(m_writer, m_reader, index)) {
+			Logger::Get().Log("Failed to copy " + entry + " to the new project archive", true);
+			return false;
+		}
+
+		m_written.insert(entry);
+
+		return true;
+	}
+	bool ProjectArchive::EndWrite()
+	{
+		if (m_writer == nullptr)
+			return false;
+
+		bool finalized = sed_mz_zip_writer_finalize_archive(m_writer);
+		sed_mz_zip_writer_end(m_writer);
+		delete m_writer;
+		m_writer = nullptr;
+		m_written.clear();
+
+		std::string target = m_writeFile.substr(0, m_writeFile.size() - 4);
+		std::error_code ec;
+
+		if (!finalized) {
+			Logger::Get().Log("Failed to finalize project archive " + target, true);
+			std::filesystem::remove(m_writeFile, ec);
+			return false;
+		}
+
+		// the old archive might be the one we are replacing
+		std::string oldFile = m_file;
+		std::unordered_map<std::string, std::string> oldModified = m_modified;
+		Close();
+
+		std::filesystem::rename(m_writeFile, target, ec);
+		if (ec) {
+			Logger::Get().Log("Failed to replace project archive " + target + " (" + ec.message() + ")", true);
+			std::filesystem::remove(m_writeFile, ec);
+
+			if (!oldFile.empty() && Open(oldFile))
+				m_modified = oldModified;
+			return false;
+		}
+
+		return Open(target);
+	}
+
+	int ProjectArchive::m_locate(const std::string& entry)
+	{
+		if (m_reader == nullptr)
+			return -1;
+
+		return sed_mz_zip_reader_locate_file(m_reader, entry.c_str(), nullptr, sed_mz_ZIP_FLAG_CASE_SENSITIVE);
+	}
+}
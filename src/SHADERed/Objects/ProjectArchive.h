@@ -0,0 +1,65 @@
+#pragma once
+#include <SHADERed/Objects/MappedFile.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct sed_mz_zip_archive_tag;
+
+namespace ed {
+	// single file project (.sprjz) - zip archive with the project XML, shaders, buffers and (optionally) assets
+	class ProjectArchive {
+	public:
+		ProjectArchive();
+		~ProjectArchive();
+
+		ProjectArchive(const ProjectArchive&) = delete;
+		ProjectArchive& operator=(const ProjectArchive&) = delete;
+
+		static const char* ProjectEntry;
+		static const size_t StoreThreshold; // entries larger than this are stored uncompressed
+
+		static bool IsArchive(const std::string& file);
+		static bool ShouldStore(const std::string& entry, size_t size);
+
+		bool Open(const std::string& file);
+		void Close();
+		inline bool IsOpen() { return m_reader != nullptr; }
+		inline const std::string& GetFilename() { return m_file; }
+
+		bool Exists(const std::string& entry);
+		size_t GetSize(const std::string& entry);
+		std::vector<std::string> GetEntries();
+
+		// returns a pointer straight into the mapped archive for stored entries, otherwise inflates the entry into the storage string
+		const char* GetData(const std::string& entry, size_t& size, std::string& storage);
+		bool Read(const std::string& entry, void* dst, size_t dstSize);
+		std::string Read(const std::string& entry);
+
+		// modified entries are kept in memory until the archive gets rewritten
+		void Modify(const std::string& entry, const std::string& data);
+		inline bool HasModifiedEntries() { return !m_modified.empty(); }
+
+		// archive is written to a temporary file which replaces the target file (and gets reopened) in EndWrite()
+		bool BeginWrite(const std::string& file);
+		bool Write(const std::string& entry, const void* data, size_t size);
+		bool WriteFile(const std::string& entry, const std::string& path);
+		bool CopyEntry(const std::string& entry); // copies the (still compressed) entry from the opened archive
+		bool EndWrite();
+
+	private:
+		int m_locate(const std::string& entry);
+
+		std::string m_file;
+		MappedFile m_map;
+		sed_mz_zip_archive_tag* m_reader;
+
+		std::string m_writeFile;
+		sed_mz_zip_archive_tag* m_writer;
+		std::unordered_set<std::string> m_written;
+
+		std::unordered_map<std::string, std::string> m_modified;
+	};
+}
@@ -0,0 +1,405 @@
+#include <SHADERed/Engine/Model.h>
+#include <SHADERed/Objects/FileCache.h>
+#include <SHADERed/Objects/Logger.h>
+#include <SHADERed/Objects/MappedFile.h>
+#include <SHADERed/Objects/ProjectLoader.h>
+#include <SHADERed/Objects/ShaderCompiler.h>
+#include <SHADERed/Objects/ThreadPool.h>
+
+#include <stb/stb_image.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace ed {
+	const float ProjectLoader::FrameBudget = 1.0f / 30.0f;
+
+	ProjectLoader::ProjectLoader()
+			: m_queued(0)
+			, m_finished(0)
+			, m_pendingSPIRV(0)
+			, m_stageFirstJob(0)
+			, m_loading(false)
+			, m_stage(Stage::Document)
+	{
+		memset(m_stageTime, 0, sizeof(m_stageTime));
+		memset(m_jobTime, 0, sizeof(m_jobTime));
+		memset(m_jobCount, 0, sizeof(m_jobCount));
+	}
+	ProjectLoader::~ProjectLoader()
+	{
+		Wait();
+		m_clear();
+		m_spirv.clear();
+	}
+
+	void ProjectLoader::Begin()
+	{
+		Wait();
+		m_clear();
+		m_spirv.clear();
+
+		memset(m_stageTime, 0, sizeof(m_stageTime));
+		memset(m_jobTime, 0, sizeof(m_jobTime));
+		memset(m_jobCount, 0, sizeof(m_jobCount));
+
+		m_loading = true;
+		m_stage = Stage::Document;
+		m_stageFirstJob = m_queued;
+		m_stageTimer.Restart();
+		m_frameTimer.Restart();
+
+		ReportProgress(true);
+	}
+	void ProjectLoader::SetStage(Stage stage)
+	{
+		m_stageTime[(int)m_stage] += m_stageTimer.Restart();
+		m_stage = stage;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_stageFirstJob = m_queued;
+		}
+
+		ReportProgress(true);
+	}
+	void ProjectLoader::End()
+	{
+		// SPIR-V jobs keep running - RenderEngine caches the passes once they are done
+		int pendingShaders = 0;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			pendingShaders = m_pendingSPIRV;
+		}
+
+		m_stageTime[(int)m_stage] += m_stageTimer.Restart();
+		m_loading = false;
+
+		stbi_set_flip_vertically_on_load(1); // default, see main.cpp
+
+		// resources that nobody asked for
+		m_clear();
+
+		static const char* stageNames[] = { "document", "resources", "objects", "shaders" };
+		static const char* jobNames[] = { "images", "models", "buffers", "SPIR-V" };
+
+		float total = 0.0f;
+		std::stringstream breakdown;
+		breakdown << std::fixed << std::setprecision(3);
+		for (int i = 0; i < (int)Stage::Count; i++) {
+			total += m_stageTime[i];
+			breakdown << (i == 0 ? "" : ", ") << stageNames[i] << ": " << m_stageTime[i] << "s";
+		}
+		breakdown << " | worker time -";
+		for (int i = 0; i < (int)Job::Count; i++)
+			breakdown << (i == 0 ? " " : ", ") << jobNames[i] << ": " << m_jobTime[i] << "s (" << m_jobCount[i] << ")";
+		breakdown << " on " << ThreadPool::Instance().GetThreadCount() << " threads";
+		breakdown << " | file cache: " << std::setprecision(1) << FileCache::Instance().GetHitRate() * 100.0f << "% hit rate";
+
+		std::stringstream totalStr;
+		totalStr << std::fixed << std::setprecision(3) << total;
+
+		Logger::Get().Log("Project loaded in " + totalStr.str() + "s - " + breakdown.str());
+		if (pendingShaders > 0)
+			Logger::Get().Log(std::to_string(pendingShaders) + " shader(s) are still being compiled in the background");
+	}
+
+	void ProjectLoader::QueueImage(const std::string& file, const Source& src, bool flip, int reqChannels)
+	{
+		std::string key = m_imageKey(file, flip, reqChannels);
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_images.count(key))
+				return;
+			m_images[key] = { nullptr, 0, 0, 0 }; // placeholder so that the image is queued only once
+		}
+
+		// stbi_set_flip_vertically_on_load() is global - decode everything unflipped and flip it on the worker.
+		// GL thread doesn't touch stb_image until the Resources stage is finished
+		stbi_set_flip_vertically_on_load(0);
+
+		m_submit(Job::Image, [this, key, src, flip, reqChannels]() {
+			MappedFile map;
+			const char* data = src.Data;
+			size_t size = src.Size;
+			if (data == nullptr && map.Open(src.Path)) {
+				data = map.GetData();
+				size = map.GetSize();
+			}
+
+			Image img = { nullptr, 0, 0, 0 };
+			if (data != nullptr && size > 0)
+				img.Pixels = stbi_load_from_memory((const stbi_uc*)data, (int)size, &img.Width, &img.Height, &img.Channels, reqChannels);
+
+			if (img.Pixels != nullptr && flip) {
+				size_t stride = img.Width * (reqChannels == 0 ? img.Channels : reqChannels);
+				std::vector<unsigned char> row(stride);
+				for (int y = 0; y < img.Height / 2; y++) {
+					unsigned char* top = img.Pixels + y * stride;
+					unsigned char* bottom = img.Pixels + (img.Height - y - 1) * stride;
+					memcpy(row.data(), top, stride);
+					memcpy(top, bottom, stride);
+					memcpy(bottom, row.data(), stride);
+				}
+			}
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_images[key] = img;
+		});
+	}
+	void ProjectLoader::QueueModel(const std::string& file, const Source& src)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_models.count(file))
+				return;
+			m_models[file] = nullptr;
+		}
+
+		m_submit(Job::Model, [this, file, src]() {
+			eng::Model* mdl = new eng::Model();
+
+			bool loaded = false;
+			if (src.Data != nullptr)
+				loaded = mdl->ImportFromMemory(src.Data, src.Size, src.Path);
+			else
+				loaded = mdl->ImportFromFile(src.Path);
+
+			if (!loaded) {
+				delete mdl;
+				mdl = nullptr;
+			}
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_models[file] = mdl;
+		});
+	}
+	void ProjectLoader::QueueBuffer(const std::string& file, const Source& src)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_buffers.count(file))
+				return;
+			m_buffers[file] = LoadedBuffer { nullptr, 0, nullptr };
+		}
+
+		m_submit(Job::Buffer, [this, file, src]() {
+			LoadedBuffer ret = { nullptr, 0, nullptr };
+			if (src.Data != nullptr) {
+				ret.Size = src.Size;
+				if (ret.Size > 0) {
+					ret.Data = malloc(ret.Size);
+					memcpy(ret.Data, src.Data, ret.Size);
+				}
+			} else {
+				// the GL upload reads the mapping directly - its pages are faulted in here so that it doesn't wait for the disk
+				MappedFile* map = new MappedFile();
+				if (map->Open(src.Path)) {
+					const char* data = map->GetData();
+					volatile char touch = 0;
+					for (size_t i = 0; i < map->GetSize(); i += 4096)
+						touch += data[i];
+
+					ret.Mapping = map;
+					ret.Size = map->GetSize();
+				} else
+					delete map;
+			}
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_buffers[file] = ret;
+		});
+	}
+	void ProjectLoader::QueueSPIRV(ShaderLanguage lang, const std::string& file, const std::string& source, ShaderStage stage, const std::string& entry, const std::vector<ShaderMacro>& macros, const std::vector<std::string>& includePaths)
+	{
+		std::string key = m_shaderKey(lang, file, source, stage, entry, macros);
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_spirv.count(key))
+				return;
+			m_spirv[key] = std::vector<unsigned int>();
+			m_pendingSPIRV++;
+		}
+
+		m_submit(Job::SPIRV, [this, key, lang, file, source, stage, entry, macros, includePaths]() {
+			std::vector<unsigned int> spv;
+			std::vector<ShaderMacro> macroCopy = macros;
+
+			// errors are not reported here - failed shaders get compiled (and reported) again by the RenderEngine
+			if (!ShaderCompiler::CompileSourceToSPIRV(spv, lang, file, source, stage, entry, macroCopy, nullptr, nullptr, false, &includePaths))
+				spv.clear();
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_spirv[key] = std::move(spv);
+			m_pendingSPIRV--;
+		});
+	}
+
+	void ProjectLoader::Wait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (m_finished < m_queued) {
+			m_cv.wait_for(lock, std::chrono::milliseconds(5));
+
+			// keep the UI alive while waiting
+			lock.unlock();
+			ReportProgress();
+			lock.lock();
+		}
+	}
+
+	unsigned char* ProjectLoader::TakeImage(const std::string& file, bool flip, int reqChannels, int* width, int* height, int* channels)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto it = m_images.find(m_imageKey(file, flip, reqChannels));
+		if (it == m_images.end() || it->second.Pixels == nullptr)
+			return nullptr;
+
+		unsigned char* ret = it->second.Pixels;
+		*width = it->second.Width;
+		*height = it->second.Height;
+		*channels = it->second.Channels;
+
+		m_images.erase(it);
+
+		return ret;
+	}
+	bool ProjectLoader::TakeModel(const std::string& file, eng::Model*& model)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto it = m_models.find(file);
+		if (it == m_models.end())
+			return false;
+
+		model = it->second;
+		m_models.erase(it);
+
+		return true;
+	}
+	void* ProjectLoader::TakeBuffer(const std::string& file, size_t& size, MappedFile*& mapping)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		size = 0;
+		mapping = nullptr;
+
+		auto it = m_buffers.find(file);
+		if (it == m_buffers.end())
+			return nullptr;
+
+		void* ret = it->second.Data;
+		size = it->second.Size;
+		mapping = it->second.Mapping;
+		m_buffers.erase(it);
+
+		return ret;
+	}
+	bool ProjectLoader::TakeSPIRV(ShaderLanguage lang, const std::string& file, const std::string& source, ShaderStage stage, const std::string& entry, const std::vector<ShaderMacro>& macros, std::vector<unsigned int>& spv)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		if (m_spirv.empty())
+			return false;
+
+		auto it = m_spirv.find(m_shaderKey(lang, file, source, stage, entry, macros));
+		if (it == m_spirv.end() || it->second.empty())
+			return false;
+
+		spv = std::move(it->second);
+		m_spirv.erase(it);
+
+		return true;
+	}
+
+	bool ProjectLoader::IsCompilingShaders()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_pendingSPIRV > 0;
+	}
+
+	void ProjectLoader::ReportProgress(bool force)
+	{
+		if (!m_loading || !m_progressCallback)
+			return;
+		if (!force && m_frameTimer.GetElapsedTime() < FrameBudget)
+			return;
+
+		int queued = 0, finished = 0;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			queued = m_queued - m_stageFirstJob;
+			finished = std::max<int>(0, m_finished - m_stageFirstJob);
+		}
+
+		// each stage takes a fixed part of the progress bar
+		static const float stageStart[] = { 0.0f, 0.05f, 0.6f, 0.7f, 1.0f };
+		static const char* stageNames[] = { "Reading the project file", "Loading textures, models and buffers", "Creating objects", "Compiling shaders" };
+
+		float stageProgress = queued == 0 ? 0.0f : (finished / (float)queued);
+		float progress = stageStart[(int)m_stage] + (stageStart[(int)m_stage + 1] - stageStart[(int)m_stage]) * stageProgress;
+
+		std::string status = stageNames[(int)m_stage];
+		if (queued != 0)
+			status += " (" + std::to_string(finished) + "/" + std::to_string(queued) + ")";
+
+		m_progressCallback(status, progress);
+		m_frameTimer.Restart();
+	}
+
+	std::string ProjectLoader::m_imageKey(const std::string& file, bool flip, int reqChannels)
+	{
+		return file + "|" + std::to_string(flip) + "|" + std::to_string(reqChannels);
+	}
+	std::string ProjectLoader::m_shaderKey(ShaderLanguage lang, const std::string& file, const std::string& source, ShaderStage stage, const std::string& entry, const std::vector<ShaderMacro>& macros)
+	{
+		std::string key = file + "|" + std::to_string((int)lang) + "|" + std::to_string((int)stage) + "|" + entry + "|" + std::to_string(std::hash<std::string>()(source));
+		for (const auto& macro : macros)
+			if (macro.Active || macro.Specialize)
+				key += "|" + std::string(macro.Specialize ? "$" : "") + std::string(macro.Active ? "" : "!") + std::string(macro.Name) + "=" + std::string(macro.Value);
+		return key;
+	}
+
+	void ProjectLoader::m_submit(Job type, const std::function<void()>& job)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_queued++;
+		}
+
+		ThreadPool::Instance().Submit([this, type, job]() {
+			eng::Timer timer;
+			job();
+			float elapsed = timer.GetElapsedTime();
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobTime[(int)type] += elapsed;
+				m_jobCount[(int)type]++;
+				m_finished++;
+			}
+			m_cv.notify_all();
+		});
+	}
+	void ProjectLoader::m_clear()
+	{
+		for (auto& img : m_images)
+			if (img.second.Pixels != nullptr)
+				stbi_image_free(img.second.Pixels);
+		for (auto& mdl : m_models)
+			delete mdl.second;
+		for (auto& buf : m_buffers) {
+			free(buf.second.Data);
+			delete buf.second.Mapping;
+		}
+
+		m_images.clear();
+		m_models.clear();
+		m_buffers.clear();
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <SHADERed/Engine/Timer.h>
+#include <SHADERed/Objects/ShaderLanguage.h>
+#include <SHADERed/Objects/ShaderMacro.h>
+#include <SHADERed/Objects/ShaderStage.h>
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ed {
+	class MappedFile;
+	namespace eng {
+		class Model;
+	}
+
+	/* loads the heavy parts of a project on the ThreadPool while the project file is being parsed:
+		Document -> Resources (image decoding, model import, buffer reads) -> Objects (GL uploads on the GL thread) -> Shaders (SPIR-V)
+	*/
+	class ProjectLoader {
+	public:
+		ProjectLoader();
+		~ProjectLoader();
+
+		enum class Stage {
+			Document,
+			Resources,
+			Objects,
+			Shaders,
+			Count
+		};
+
+		// either points to memory (archive entry) or to a file on the disk
+		struct Source {
+			std::string Path;
+			const char* Data = nullptr;
+			size_t Size = 0;
+			std::shared_ptr<std::string> Storage; // keeps inflated archive entries alive
+		};
+
+		static const float FrameBudget; // max time (in seconds) spent on the GL thread between two progress frames
+
+		void Begin();
+		void SetStage(Stage stage);
+		void End(); // doesn't wait for the SPIR-V jobs
+		inline bool IsLoading() { return m_loading; }
+
+		void QueueImage(const std::string& file, const Source& src, bool flip, int reqChannels);
+		void QueueModel(const std::string& file, const Source& src);
+		void QueueBuffer(const std::string& file, const Source& src);
+		void QueueSPIRV(ShaderLanguage lang, const std::string& file, const std::string& source, ShaderStage stage, const std::string& entry, const std::vector<ShaderMacro>& macros, const std::vector<std::string>& includePaths);
+
+		// blocks until all queued jobs are finished
+		void Wait();
+
+		// results are removed from the loader - caller takes the ownership
+		unsigned char* TakeImage(const std::string& file, bool flip, int reqChannels, int* width, int* height, int* channels);
+		bool TakeModel(const std::string& file, eng::Model*& model);
+		void* TakeBuffer(const std::string& file, size_t& size, MappedFile*& mapping); // files on the disk are only mapped - returns nullptr and sets the mapping
+		bool TakeSPIRV(ShaderLanguage lang, const std::string& file, const std::string& source, ShaderStage stage, const std::string& entry, const std::vector<ShaderMacro>& macros, std::vector<unsigned int>& spv);
+
+		// SPIR-V queued while the project was loading that isn't finished yet
+		bool IsCompilingShaders();
+
+		// called on the GL thread - invokes the progress callback once FrameBudget has passed since the last call
+		void ReportProgress(bool force = false);
+		inline void SetProgressCallback(const std::function<void(const std::string&, float)>& cb) { m_progressCallback = cb; }
+
+		inline float GetStageTime(Stage stage) { return m_stageTime[(int)stage]; }
+
+	private:
+		enum class Job {
+			Image,
+			Model,
+			Buffer,
+			SPIRV,
+			Count
+		};
+
+		struct Image {
+			unsigned char* Pixels;
+			int Width, Height, Channels;
+		};
+		struct LoadedBuffer {
+			void* Data; // copy of an archive entry
+			size_t Size;
+			MappedFile* Mapping;
+		};
+
+		static std::string m_imageKey(const std::string& file, bool flip, int reqChannels);
+		static std::string m_shaderKey(ShaderLanguage lang, const std::string& file, const std::string& source, ShaderStage stage, const std::string& entry, const std::vector<ShaderMacro>& macros);
+
+		void m_submit(Job type, const std::function<void()>& job);
+		void m_clear();
+
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		int m_queued, m_finished;
+		int m_pendingSPIRV;
+		int m_stageFirstJob;
+
+		std::unordered_map<std::string, Image> m_images;
+		std::unordered_map<std::string, eng::Model*> m_models;
+		std::unordered_map<std::string, LoadedBuffer> m_buffers;
+		std::unordered_map<std::string, std::vector<unsigned int>> m_spirv;
+
+		bool m_loading;
+		Stage m_stage;
+		eng::Timer m_stageTimer, m_frameTimer;
+		float m_stageTime[(int)Stage::Count];
+		float m_jobTime[(int)Job::Count]; // summed up time spent on the worker threads
+		int m_jobCount[(int)Job::Count];
+
+		std::function<void(const std::string&, float)> m_progressCallback;
+	};
+}
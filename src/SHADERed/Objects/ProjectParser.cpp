@@ -1,9 +1,11 @@
 #include <SHADERed/Objects/CameraSnapshots.h>
 #include <SHADERed/Objects/DebugInformation.h>
 #include <SHADERed/Objects/DefaultState.h>
+#include <SHADERed/Objects/FileCache.h>
 #include <SHADERed/Objects/FunctionVariableManager.h>
 #include <SHADERed/Objects/InputLayout.h>
 #include <SHADERed/Objects/Logger.h>
+#include <SHADERed/Objects/MappedFile.h>
 #include <SHADERed/Objects/Names.h>
 #include <SHADERed/Objects/ObjectManager.h>
 #include <SHADERed/Objects/PipelineItem.h>
@@ -24,6 +26,9 @@
 #include <filesystem>
 #include <algorithm>
 #include <fstream>
+#include <functional>
+
+#include <stb/stb_image.h>
 
 #define HARRAYSIZE(a) (sizeof(a) / sizeof(*a))
 
@@ -58,6 +63,53 @@ namespace ed {
 	{
 		return proj + "_" + shaderpass + stage + "." + ext; // eg: project_SimpleVS.glsl
 	}
+	void forEachProjectFile(pugi::xml_node projectNode, const std::function<void(std::string&, bool)>& fn)
+	{
+		auto visitAttribute = [&](pugi::xml_attribute attr, bool isAsset) {
+			if (attr.empty())
+				return;
+			std::string path = attr.as_string();
+			fn(path, isAsset);
+			attr.set_value(path.c_str());
+		};
+
+		for (pugi::xml_node passNode : projectNode.child("pipeline").children("pass")) {
+			for (pugi::xml_node shaderNode : passNode.children("shader"))
+				visitAttribute(shaderNode.attribute("path"), false);
+
+			for (pugi::xml_node itemNode : passNode.child("items").children("item")) {
+				if (strcmp(itemNode.attribute("type").as_string(), "model") != 0)
+					continue;
+
+				pugi::xml_text pathText = itemNode.child("filepath").text();
+				std::string path = pathText.as_string();
+				fn(path, true);
+				pathText.set(path.c_str());
+			}
+		}
+
+		static const char* cubeFaces[] = { "left", "top", "front", "bottom", "right", "back" };
+		for (pugi::xml_node objectNode : projectNode.child("objects").children("object")) {
+			visitAttribute(objectNode.attribute("path"), true);
+
+			if (objectNode.attribute("cube").as_bool())
+				for (const char* face : cubeFaces)
+					visitAttribute(objectNode.attribute(face), true);
+		}
+	}
+	std::string toArchiveEntry(const std::string& file, const std::string& projectPath)
+	{
+		std::filesystem::path fpath(file);
+		if (fpath.is_absolute())
+			fpath = fpath.lexically_relative(projectPath);
+
+		// files outside of the project directory can't be stored in the archive
+		std::string entry = fpath.lexically_normal().generic_string();
+		if (entry.empty() || entry == "." || entry.substr(0, 2) == ".." || std::filesystem::path(entry).is_absolute())
+			return "";
+
+		return entry;
+	}
 
 	ProjectParser::ProjectParser(PipelineManager* pipeline, ObjectManager* objects, RenderEngine* rend, PluginManager* plugins, MessageStack* msgs, DebugInformation* debugger, GUIManager* gui)
 			: m_pipe(pipeline)
@@ -78,10 +130,33 @@ namespace ed {
 	{
 		Logger::Get().Log("Opening a project file " + file);
 
+		m_loader.Begin();
+
 		pugi::xml_document doc;
-		pugi::xml_parse_result result = doc.load_file(file.c_str());
+		pugi::xml_parse_result result;
+		if (ProjectArchive::IsArchive(file)) {
+			if (!m_archive.Open(file)) {
+				m_loader.End();
+				return;
+			}
+
+			// stored entries are parsed straight from the archive's mapping
+			std::string projectStorage;
+			size_t projectSize = 0;
+			const char* projectSrc = m_archive.GetData(ProjectArchive::ProjectEntry, projectSize, projectStorage);
+			result = doc.load_buffer(projectSrc == nullptr ? "" : projectSrc, projectSize);
+		} else {
+			m_archive.Close();
+
+			MappedFile projectFile;
+			if (projectFile.Open(file))
+				result = doc.load_buffer(projectFile.GetData() == nullptr ? "" : projectFile.GetData(), projectFile.GetSize());
+			else
+				result = doc.load_file(file.c_str()); // reports the error
+		}
 		if (!result) {
 			Logger::Get().Log("Failed to parse a project file", true);
+			m_loader.End();
 			return;
 		}
 
@@ -161,6 +236,8 @@ namespace ed {
 
 		if (!pluginTest) {
 			Logger::Get().Log("Missing plugin - project not loaded", true);
+			m_archive.Close();
+			m_loader.End();
 			return;
 		}
 
@@ -187,6 +264,7 @@ namespace ed {
 		Settings::Instance().Project.FPCamera = false;
 		Settings::Instance().Project.ClearColor = glm::vec4(0, 0, 0, 0);
 		Settings::Instance().Project.UseAlphaChannel = false;
+		Settings::Instance().Project.OptimizeSPIRV = false;
 
 		pugi::xml_node projectNode = doc.child("project");
 		int projectVersion = 1; // if no project version is specified == using first project file
@@ -198,13 +276,29 @@ namespace ed {
 			m_plugins->GetPlugin(pname)->Project_BeginLoad();
 
 		switch (projectVersion) {
-		case 1: m_parseV1(projectNode); break;
-		case 2: m_parseV2(projectNode); break;
+		case 1:
+			m_loader.SetStage(ProjectLoader::Stage::Objects);
+			m_parseV1(projectNode);
+			break;
+		case 2:
+			// decode textures, import models and read buffers on the worker threads
+			m_loader.SetStage(ProjectLoader::Stage::Resources);
+			m_queueResources(projectNode);
+			m_loader.Wait();
+
+			// create the GL objects from the loaded resources
+			m_loader.SetStage(ProjectLoader::Stage::Objects);
+			m_parseV2(projectNode);
+			break;
 		default:
 			Logger::Get().Log("Tried to open a project that is newer version", true);
 			break;
 		}
 
+		// shaders are compiled to SPIR-V on the worker threads, RenderEngine picks up the results when caching the passes
+		m_loader.SetStage(ProjectLoader::Stage::Shaders);
+		m_queueShaders();
+
 		m_modified = false;
 
 		// reset time, frame index, etc...
@@ -214,6 +308,9 @@ namespace ed {
 		for (const auto& pname : m_pluginList)
 			m_plugins->GetPlugin(pname)->Project_EndLoad();
 
+		// returns without waiting for the shaders
+		m_loader.End();
+
 		Logger::Get().Log("Finished with parsing a project file");
 	}
 	void ProjectParser::OpenTemplate()
@@ -235,6 +332,11 @@ namespace ed {
 		std::string oldProjectPath = m_projectPath;
 		SetProjectDirectory(file.substr(0, file.find_last_of("/\\")));
 
+		// when saving to an archive, files are packed instead of being written next to the project file
+		bool isArchive = ProjectArchive::IsArchive(file);
+		std::vector<std::pair<std::string, BufferObject*>> archiveBuffers;
+		std::unordered_map<std::string, std::string> archiveCopies; // entry -> source file
+
 		std::vector<PipelineItem*> passItems = m_pipe->GetList();
 		std::vector<pipe::ShaderPass*> collapsedSP = ((PipelineUI*)m_ui->Get(ViewID::Pipeline))->GetCollapsedItems();
 
@@ -247,11 +349,25 @@ namespace ed {
 		if (copyFiles) {
 			Logger::Get().Log("Copying shader files...");
 
-			std::filesystem::create_directories(shadersDir);
+			if (!isArchive)
+				std::filesystem::create_directories(shadersDir);
 			std::error_code errc;
 
 			std::string proj = oldProjectPath + ((oldProjectPath[oldProjectPath.size() - 1] == '/') ? "" : "/");
 
+			// files stored in the opened archive have to be extracted
+			auto copyFile = [&](const std::string& src, const std::string& dst) {
+				std::string entry = m_archive.IsOpen() ? toArchiveEntry(src, oldProjectPath) : "";
+				if (isArchive)
+					archiveCopies[toArchiveEntry(dst, m_projectPath)] = src;
+				else if (!entry.empty() && m_archive.Exists(entry)) {
+					std::string data = m_archive.Read(entry);
+					std::ofstream out(dst, std::ios::binary);
+					out.write(data.c_str(), data.size());
+				} else
+					std::filesystem::copy_file(src, dst, std::filesystem::copy_options::overwrite_existing, errc);
+			};
+
 			for (PipelineItem* passItem : passItems) {
 				if (passItem->Type == PipelineItem::ItemType::ShaderPass) {
 					pipe::ShaderPass* passData = (pipe::ShaderPass*)passItem->Data;
@@ -262,14 +378,14 @@ namespace ed {
 					std::string vsExt = getExtension(vs);
 					std::string psExt = getExtension(ps);
 
-					std::filesystem::copy_file(vs, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "VS", vsExt), std::filesystem::copy_options::overwrite_existing, errc);
-					std::filesystem::copy_file(ps, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "PS", psExt), std::filesystem::copy_options::overwrite_existing, errc);
+					copyFile(vs, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "VS", vsExt));
+					copyFile(ps, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "PS", psExt));
 
 					if (passData->GSUsed) {
 						std::string gs = std::filesystem::path(passData->GSPath).is_absolute() ? passData->GSPath : (proj + std::string(passData->GSPath));
 						std::string gsExt = getExtension(gs);
 
-						std::filesystem::copy_file(gs, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "GS", gsExt), std::filesystem::copy_options::overwrite_existing, errc);
+						copyFile(gs, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "GS", gsExt));
 					}
 
 					if (errc)
@@ -280,7 +396,7 @@ namespace ed {
 					std::string cs = std::filesystem::path(passData->Path).is_absolute() ? passData->Path : (proj + std::string(passData->Path));
 					std::string csExt = getExtension(cs);
 
-					std::filesystem::copy_file(cs, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "CS", csExt), std::filesystem::copy_options::overwrite_existing, errc);
+					copyFile(cs, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "CS", csExt));
 					if (errc)
 						ed::Logger::Get().Log("Failed to copy a file (source == destination)", true);
 				} else if (passItem->Type == PipelineItem::ItemType::AudioPass) {
@@ -289,7 +405,7 @@ namespace ed {
 					std::string ss = std::filesystem::path(passData->Path).is_absolute() ? passData->Path : (proj + std::string(passData->Path));
 					std::string ssExt = getExtension(ss);
 
-					std::filesystem::copy_file(ss, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "SS", ssExt), std::filesystem::copy_options::overwrite_existing, errc);
+					copyFile(ss, shadersDir + "/" + newShaderFilename(projectStem, passItem->Name, "SS", ssExt));
 					if (errc)
 						ed::Logger::Get().Log("Failed to copy a file (source == destination)", true);
 				} else if (passItem->Type == PipelineItem::ItemType::PluginItem) {
@@ -425,8 +541,12 @@ namespace ed {
 					pugi::xml_node macroNode = macrosNode.append_child("define");
 					macroNode.append_attribute("name").set_value(macro.Name);
 					macroNode.append_attribute("active").set_value(macro.Active);
+					if (macro.Specialize)
+						macroNode.append_attribute("specialize").set_value(true);
 					macroNode.text().set(macro.Value);
 				}
+
+				m_exportPermutations(passNode, passData->Permutations);
 			} else if (passItem->Type == PipelineItem::ItemType::ComputePass) {
 				pipe::ComputePass* passData = (pipe::ComputePass*)passItem->Data;
 
@@ -451,6 +571,20 @@ namespace ed {
 				workNode.append_attribute("y").set_value(passData->WorkY);
 				workNode.append_attribute("z").set_value(passData->WorkZ);
 
+				// iterations & indirect dispatch
+				if (passData->Iterations != 1)
+					passNode.append_child("iterations").text().set(passData->Iterations);
+				if (passData->IndirectBuffer != nullptr)
+					passNode.append_child("indirect").text().set(m_objects->GetBufferNameByID(((BufferObject*)passData->IndirectBuffer)->ID).c_str());
+				if (!passData->PingPong.empty()) {
+					pugi::xml_node pingPongNode = passNode.append_child("pingpong");
+					for (const auto& pair : passData->PingPong) {
+						pugi::xml_node pairNode = pingPongNode.append_child("pair");
+						pairNode.append_attribute("first").set_value(pair.first.c_str());
+						pairNode.append_attribute("second").set_value(pair.second.c_str());
+					}
+				}
+
 				// variables -> now global in pass element [V2]
 				m_exportShaderVariables(passNode, passData->Variables.GetVariables());
 
@@ -460,8 +594,12 @@ namespace ed {
 					pugi::xml_node macroNode = macrosNode.append_child("define");
 					macroNode.append_attribute("name").set_value(macro.Name);
 					macroNode.append_attribute("active").set_value(macro.Active);
+					if (macro.Specialize)
+						macroNode.append_attribute("specialize").set_value(true);
 					macroNode.text().set(macro.Value);
 				}
+
+				m_exportPermutations(passNode, passData->Permutations);
 			} else if (passItem->Type == PipelineItem::ItemType::AudioPass) {
 				pipe::AudioPass* passData = (pipe::AudioPass*)passItem->Data;
 
@@ -487,6 +625,8 @@ namespace ed {
 					pugi::xml_node macroNode = macrosNode.append_child("define");
 					macroNode.append_attribute("name").set_value(macro.Name);
 					macroNode.append_attribute("active").set_value(macro.Active);
+					if (macro.Specialize)
+						macroNode.append_attribute("specialize").set_value(true);
 					macroNode.text().set(macro.Value);
 				}
 			} else if (passItem->Type == PipelineItem::ItemType::PluginItem) {
@@ -639,13 +779,41 @@ namespace ed {
 					textureNode.append_attribute("format").set_value(bobj->ViewFormat);
 					textureNode.append_attribute("pausedpreview").set_value(bobj->PreviewPaused);
 
-					std::string bPath = GetProjectPath("buffers/" + texs[i] + ".buf");
-					if (!std::filesystem::exists(GetProjectPath("buffers")))
-						std::filesystem::create_directories(GetProjectPath("buffers"));
-
-					std::ofstream bufWrite(bPath, std::ios::binary);
-					bufWrite.write((char*)bobj->Data, bobj->Size);
-					bufWrite.close();
+					if (isArchive) {
+						m_objects->RequireBufferData(bobj);
+						archiveBuffers.push_back(std::make_pair("buffers/" + texs[i] + ".buf", bobj));
+					}
+					else {
+						std::string bPath = GetProjectPath("buffers/" + texs[i] + ".buf");
+
+						// only rewrite buffers that changed (or that don't exist in the new location yet)
+						std::error_code ec;
+						bool upToDate = !bobj->Dirty && oldProjectPath == m_projectPath && std::filesystem::file_size(bPath, ec) == bobj->Size && !ec;
+						if (!upToDate) {
+							m_objects->RequireBufferData(bobj); // also releases the mapping of the file that is replaced
+
+							if (!std::filesystem::exists(GetProjectPath("buffers")))
+								std::filesystem::create_directories(GetProjectPath("buffers"));
+
+							// write to a temporary file first so that a failed save doesn't destroy the old data
+							std::string tmpPath = bPath + ".tmp";
+							std::ofstream bufWrite(tmpPath, std::ios::binary);
+							bufWrite.write((char*)bobj->Data, bobj->Size);
+							bufWrite.close();
+
+							if (bufWrite.fail()) {
+								Logger::Get().Log("Failed to write buffer " + texs[i] + " to " + tmpPath, true);
+								std::filesystem::remove(tmpPath, ec);
+							} else {
+								std::filesystem::rename(tmpPath, bPath, ec);
+								if (ec) {
+									Logger::Get().Log("Failed to replace " + bPath + " (" + ec.message() + ")", true);
+									std::filesystem::remove(tmpPath, ec);
+								} else
+									bobj->Dirty = false;
+							}
+						}
+					}
 
 					for (int j = 0; j < passItems.size(); j++) {
 						const std::vector<GLuint>& bound = m_objects->GetUniformBindList(passItems[j]);
@@ -817,6 +985,13 @@ namespace ed {
 				alphaNode.append_attribute("val").set_value(settings.Project.UseAlphaChannel);
 			}
 
+			// optimizespirv
+			if (settings.Project.OptimizeSPIRV) {
+				pugi::xml_node optNode = settingsNode.append_child("entry");
+				optNode.append_attribute("type").set_value("optimizespirv");
+				optNode.append_attribute("val").set_value(settings.Project.OptimizeSPIRV);
+			}
+
 			// include paths
 			if (settings.Project.IncludePaths.size() > 0) {
 				pugi::xml_node pathsNode = settingsNode.append_child("entry");
@@ -888,34 +1063,198 @@ namespace ed {
 			}
 		}
 
-		doc.save_file(file.c_str());
+		if (isArchive)
+			m_saveArchive(file, doc, oldProjectPath, archiveBuffers, archiveCopies);
+		else {
+			if (m_archive.IsOpen())
+				m_extractArchive(doc, oldProjectPath);
+			doc.save_file(file.c_str());
+		}
 	}
-	std::string ProjectParser::LoadFile(const std::string& file)
+	void ProjectParser::m_saveArchive(const std::string& file, pugi::xml_document& doc, const std::string& oldProjectPath, const std::vector<std::pair<std::string, BufferObject*>>& buffers, const std::unordered_map<std::string, std::string>& copies)
 	{
-		std::ifstream in(file);
-		if (in.is_open()) {
-			in.seekg(0, std::ios::beg);
+		Logger::Get().Log("Packing project files into " + file);
+
+		if (!m_archive.BeginWrite(file))
+			return;
+
+		bool packAssets = Settings::Instance().General.ArchiveAssets;
+		bool hasOldArchive = m_archive.IsOpen();
+
+		forEachProjectFile(doc.child("project"), [&](std::string& path, bool isAsset) {
+			std::string absPath = std::filesystem::path(path).is_absolute() ? path : GetProjectPath(path);
+			std::string entry = toArchiveEntry(path, m_projectPath);
+			auto copy = copies.find(entry);
+			if (copy != copies.end())
+				absPath = copy->second;
+
+			std::string oldEntry = hasOldArchive ? toArchiveEntry(absPath, oldProjectPath) : "";
+
+			if (!oldEntry.empty() && m_archive.Exists(oldEntry)) {
+				// archived files travel with the archive
+				if (entry.empty())
+					entry = oldEntry;
+
+				if (entry == oldEntry)
+					m_archive.CopyEntry(entry);
+				else {
+					std::string data = m_archive.Read(oldEntry);
+					m_archive.Write(entry, data.c_str(), data.size());
+				}
+
+				path = entry;
+			} else if (!entry.empty() && (packAssets || !isAsset) && std::filesystem::exists(absPath))
+				m_archive.WriteFile(entry, absPath);
+		});
 
-			std::string content((std::istreambuf_iterator<char>(in)), (std::istreambuf_iterator<char>()));
-			in.close();
-			return content;
+		for (const auto& buf : buffers)
+			m_archive.Write(buf.first, buf.second->Data, buf.second->Size);
+
+		std::ostringstream projectStream;
+		doc.save(projectStream);
+		std::string projectSrc = projectStream.str();
+		m_archive.Write(ProjectArchive::ProjectEntry, projectSrc.c_str(), projectSrc.size());
+
+		if (!m_archive.EndWrite())
+			Logger::Get().Log("Failed to save the project archive " + file, true);
+	}
+	void ProjectParser::m_extractArchive(pugi::xml_document& doc, const std::string& oldProjectPath)
+	{
+		Logger::Get().Log("Extracting files from the project archive...");
+
+		forEachProjectFile(doc.child("project"), [&](std::string& path, bool isAsset) {
+			std::string absPath = std::filesystem::path(path).is_absolute() ? path : GetProjectPath(path);
+			std::string oldEntry = toArchiveEntry(absPath, oldProjectPath);
+
+			if (oldEntry.empty() || !m_archive.Exists(oldEntry))
+				return;
+
+			std::error_code ec;
+			std::filesystem::create_directories(std::filesystem::path(absPath).parent_path(), ec);
+
+			std::string data = m_archive.Read(oldEntry);
+			std::ofstream out(absPath, std::ios::binary);
+			out.write(data.c_str(), data.size());
+		});
+
+		m_archive.Close();
+	}
+
+	ProjectLoader::Source ProjectParser::m_getLoaderSource(const std::string& file)
+	{
+		ProjectLoader::Source src;
+		src.Path = GetProjectPath(file);
+
+		// archive entries are passed to the workers as memory
+		std::string entry = GetArchiveEntry(file);
+		if (!entry.empty()) {
+			src.Path = entry;
+			src.Storage = std::make_shared<std::string>();
+			src.Data = m_archive.GetData(entry, src.Size, *src.Storage);
 		}
-		return "";
+
+		return src;
 	}
-	std::string ProjectParser::LoadProjectFile(const std::string& file)
+	void ProjectParser::m_queueResources(pugi::xml_node& projectNode)
 	{
-		std::ifstream in(GetProjectPath(file));
-		if (in.is_open()) {
-			in.seekg(0, std::ios::beg);
+		static const char* cubeFaces[] = { "left", "top", "front", "bottom", "right", "back" };
+
+		for (pugi::xml_node objectNode : projectNode.child("objects").children("object")) {
+			const pugi::char_t* objType = objectNode.attribute("type").as_string();
 
-			std::string content((std::istreambuf_iterator<char>(in)), (std::istreambuf_iterator<char>()));
-			in.close();
-			return content;
+			if (strcmp(objType, "texture") == 0) {
+				if (objectNode.attribute("keyboard_texture").as_bool())
+					continue;
+
+				if (objectNode.attribute("cube").as_bool()) {
+					for (const char* face : cubeFaces) {
+						std::string path = toGenericPath(objectNode.attribute(face).as_string());
+						m_loader.QueueImage(path, m_getLoaderSource(path), false, 0);
+					}
+				} else {
+					std::string path = toGenericPath(objectNode.attribute("path").as_string());
+					m_loader.QueueImage(path, m_getLoaderSource(path), true, STBI_rgb_alpha);
+				}
+			} else if (strcmp(objType, "buffer") == 0) {
+				std::string path = "buffers/" + std::string(objectNode.attribute("name").as_string()) + ".buf";
+				if (objectNode.attribute("size").as_int() > 0)
+					m_loader.QueueBuffer(path, m_getLoaderSource(path));
+			}
+		}
+
+		for (pugi::xml_node passNode : projectNode.child("pipeline").children("pass")) {
+			for (pugi::xml_node itemNode : passNode.child("items").children("item")) {
+				if (strcmp(itemNode.attribute("type").as_string(), "model") != 0)
+					continue;
+
+				std::string path = itemNode.child("filepath").text().as_string();
+				if (!path.empty())
+					m_loader.QueueModel(path, m_getLoaderSource(path));
+			}
+		}
+	}
+	void ProjectParser::m_queueShaders()
+	{
+		std::vector<std::string> includePaths = GetIncludePaths();
+		auto queueShader = [&](const char* path, const char* entry, ShaderStage stage, const std::vector<ShaderMacro>& macros) {
+			if (strlen(path) == 0)
+				return;
+
+			// plugins might not be thread safe, GLSL SPIR-V is generated lazily by the RenderEngine
+			ShaderLanguage lang = ShaderCompiler::GetShaderLanguageFromExtension(path);
+			if (lang == ShaderLanguage::Plugin || lang == ShaderLanguage::GLSL)
+				return;
+
+			m_loader.QueueSPIRV(lang, path, LoadProjectFile(path), stage, entry, macros, includePaths);
+		};
+
+		for (PipelineItem* item : m_pipe->GetList()) {
+			if (item->Type == PipelineItem::ItemType::ShaderPass) {
+				pipe::ShaderPass* data = (pipe::ShaderPass*)item->Data;
+
+				queueShader(data->VSPath, data->VSEntry, ShaderStage::Vertex, data->Macros);
+				queueShader(data->PSPath, data->PSEntry, ShaderStage::Pixel, data->Macros);
+				if (data->GSUsed && strlen(data->GSEntry) > 0)
+					queueShader(data->GSPath, data->GSEntry, ShaderStage::Geometry, data->Macros);
+			} else if (item->Type == PipelineItem::ItemType::ComputePass) {
+				pipe::ComputePass* data = (pipe::ComputePass*)item->Data;
+				queueShader(data->Path, data->Entry, ShaderStage::Compute, data->Macros);
+			}
 		}
-		return "";
+	}
+	std::string ProjectParser::LoadFile(const std::string& file)
+	{
+		std::string entry = GetArchiveEntry(file);
+		if (!entry.empty())
+			return m_archive.Read(entry);
+
+		std::string content;
+		FileCache::Instance().Read(file, content);
+		return content;
+	}
+	std::string ProjectParser::LoadProjectFile(const std::string& file)
+	{
+		std::string entry = GetArchiveEntry(file);
+		if (!entry.empty())
+			return m_archive.Read(entry);
+
+		std::string content;
+		FileCache::Instance().Read(GetProjectPath(file), content);
+		return content;
 	}
 	char* ProjectParser::LoadProjectFile(const std::string& file, size_t& fsize)
 	{
+		std::string entry = GetArchiveEntry(file);
+		if (!entry.empty()) {
+			fsize = m_archive.GetSize(entry);
+
+			char* string = (char*)malloc(fsize + 1);
+			m_archive.Read(entry, string, fsize);
+			string[fsize] = 0;
+
+			return string;
+		}
+
 		std::string actual = GetProjectPath(file);
 
 		FILE* f = fopen(actual.c_str(), "rb");
@@ -938,11 +1277,31 @@ namespace ed {
 			if (mdl.first == file)
 				return mdl.second;
 
+		// model might have already been imported on a worker thread
+		eng::Model* imported = nullptr;
+		if (m_loader.TakeModel(file, imported)) {
+			if (imported == nullptr)
+				return nullptr;
+
+			imported->Upload();
+			m_models.push_back(std::make_pair(file, imported));
+			m_loader.ReportProgress();
+
+			return imported;
+		}
+
 		m_models.push_back(std::make_pair(file, new eng::Model()));
 
 		// load the model
-		std::string path = GetProjectPath(file);
-		bool loaded = m_models[m_models.size() - 1].second->LoadFromFile(path);
+		bool loaded = false;
+		std::string entry = GetArchiveEntry(file);
+		if (!entry.empty()) {
+			std::string storage;
+			size_t size = 0;
+			const char* data = m_archive.GetData(entry, size, storage);
+			loaded = data != nullptr && m_models[m_models.size() - 1].second->LoadFromMemory(data, size, entry);
+		} else
+			loaded = m_models[m_models.size() - 1].second->LoadFromFile(GetProjectPath(file));
 		if (!loaded) {
 			m_models.erase(m_models.begin() + (m_models.size() - 1));
 			return nullptr;
@@ -952,9 +1311,21 @@ namespace ed {
 	}
 	void ProjectParser::SaveProjectFile(const std::string& file, const std::string& data)
 	{
-		std::ofstream out(GetProjectPath(file));
+		// changes are written to the archive on the next project save
+		std::string entry = GetArchiveEntry(file);
+		if (!entry.empty()) {
+			m_archive.Modify(entry, data);
+			m_modified = true;
+			return;
+		}
+
+		std::string path = GetProjectPath(file);
+
+		std::ofstream out(path);
 		out << data;
 		out.close();
+
+		FileCache::Instance().Invalidate(path);
 	}
 	std::string ProjectParser::GetRelativePath(const std::string& to)
 	{
@@ -979,12 +1350,31 @@ namespace ed {
 
 		return std::filesystem::path(m_projectPath + ((m_projectPath[m_projectPath.size() - 1] == '/') ? "" : "/") + to).generic_string();
 	}
+	std::vector<std::string> ProjectParser::GetIncludePaths()
+	{
+		std::vector<std::string> ret;
+		for (const auto& path : Settings::Instance().Project.IncludePaths)
+			ret.push_back(GetProjectPath(path));
+		return ret;
+	}
 	bool ProjectParser::FileExists(const std::string& str)
 	{
-		return std::filesystem::exists(GetProjectPath(str));
+		return !GetArchiveEntry(str).empty() || std::filesystem::exists(GetProjectPath(str));
+	}
+	std::string ProjectParser::GetArchiveEntry(const std::string& file)
+	{
+		if (!m_archive.IsOpen())
+			return "";
+
+		std::string entry = toArchiveEntry(file, m_projectPath);
+		if (entry.empty() || !m_archive.Exists(entry))
+			return "";
+
+		return entry;
 	}
 	void ProjectParser::ResetProjectDirectory()
 	{
+		m_archive.Close();
 		m_file = "";
 		m_projectPath = std::filesystem::current_path().string();
 	}
@@ -1064,6 +1454,50 @@ namespace ed {
 			}
 		}
 	}
+	void ProjectParser::m_exportPermutations(pugi::xml_node& node, const std::vector<MacroPermutation>& perms)
+	{
+		if (perms.empty())
+			return;
+
+		pugi::xml_node permsNode = node.append_child("permutations");
+		for (const auto& perm : perms) {
+			pugi::xml_node permNode = permsNode.append_child("permutation");
+			permNode.append_attribute("name").set_value(perm.Name);
+
+			for (const auto& macro : perm.Macros) {
+				pugi::xml_node macroNode = permNode.append_child("define");
+				macroNode.append_attribute("name").set_value(macro.Name);
+				macroNode.append_attribute("active").set_value(macro.Active);
+				if (macro.Specialize)
+					macroNode.append_attribute("specialize").set_value(true);
+				macroNode.text().set(macro.Value);
+			}
+		}
+	}
+	void ProjectParser::m_importPermutations(const pugi::xml_node& node, std::vector<MacroPermutation>& perms)
+	{
+		for (pugi::xml_node permNode : node.child("permutations").children("permutation")) {
+			MacroPermutation perm;
+			strncpy(perm.Name, permNode.attribute("name").as_string(), sizeof(perm.Name) - 1);
+			perm.Name[sizeof(perm.Name) - 1] = 0;
+
+			for (pugi::xml_node macroNode : permNode.children("define")) {
+				ShaderMacro newMacro;
+				if (!macroNode.attribute("name").empty())
+					strcpy(newMacro.Name, macroNode.attribute("name").as_string());
+
+				newMacro.Active = true;
+				if (!macroNode.attribute("active").empty())
+					newMacro.Active = macroNode.attribute("active").as_bool();
+				if (!macroNode.attribute("specialize").empty())
+					newMacro.Specialize = macroNode.attribute("specialize").as_bool();
+				strcpy(newMacro.Value, macroNode.text().get());
+				perm.Macros.push_back(newMacro);
+			}
+
+			perms.push_back(perm);
+		}
+	}
 	void ProjectParser::m_exportShaderVariables(pugi::xml_node& node, std::vector<ShaderVariable*>& vars)
 	{
 		if (vars.size() > 0) {
@@ -2210,6 +2644,7 @@ namespace ed {
 		std::map<pipe::GeometryItem*, std::pair<std::string, pipe::ShaderPass*>> geoUBOs; // buffers that are bound to pipeline items
 		std::map<pipe::Model*, std::pair<std::string, pipe::ShaderPass*>> modelUBOs;
 		std::map<pipe::VertexBuffer*, std::pair<std::string, pipe::ShaderPass*>> vbUBOs;
+		std::map<pipe::ComputePass*, std::string> indirectBuffers;
 
 		// shader passes
 		for (pugi::xml_node passNode : projectNode.child("pipeline").children("pass")) {
@@ -2396,9 +2831,12 @@ namespace ed {
 					newMacro.Active = true;
 					if (!macroNode.attribute("active").empty())
 						newMacro.Active = macroNode.attribute("active").as_bool();
+					if (!macroNode.attribute("specialize").empty())
+						newMacro.Specialize = macroNode.attribute("specialize").as_bool();
 					strcpy(newMacro.Value, macroNode.text().get());
 					data->Macros.push_back(newMacro);
 				}
+				m_importPermutations(passNode, data->Permutations);
 
 				// parse items
 				m_importItems(name, data, passNode.child("items"), data->InputLayout, geoUBOs, modelUBOs, vbUBOs);
@@ -2521,9 +2959,12 @@ namespace ed {
 					newMacro.Active = true;
 					if (!macroNode.attribute("active").empty())
 						newMacro.Active = macroNode.attribute("active").as_bool();
+					if (!macroNode.attribute("specialize").empty())
+						newMacro.Specialize = macroNode.attribute("specialize").as_bool();
 					strcpy(newMacro.Value, macroNode.text().get());
 					data->Macros.push_back(newMacro);
 				}
+				m_importPermutations(passNode, data->Permutations);
 
 				// get group size
 				pugi::xml_node workNode = passNode.child("groupsize");
@@ -2540,6 +2981,14 @@ namespace ed {
 				else
 					data->WorkZ = 1;
 
+				// iterations & indirect dispatch
+				if (!passNode.child("iterations").empty())
+					data->Iterations = std::max(passNode.child("iterations").text().as_int(), 1);
+				if (!passNode.child("indirect").empty())
+					indirectBuffers[data] = passNode.child("indirect").text().as_string();
+				for (pugi::xml_node pairNode : passNode.child("pingpong").children("pair"))
+					data->PingPong.push_back(std::make_pair(pairNode.attribute("first").as_string(), pairNode.attribute("second").as_string()));
+
 				// add the item
 				m_pipe->AddComputePass(name, data);
 			} else if (type == PipelineItem::ItemType::AudioPass) {
@@ -2624,6 +3073,8 @@ namespace ed {
 					newMacro.Active = true;
 					if (!macroNode.attribute("active").empty())
 						newMacro.Active = macroNode.attribute("active").as_bool();
+					if (!macroNode.attribute("specialize").empty())
+						newMacro.Specialize = macroNode.attribute("specialize").as_bool();
 					strcpy(newMacro.Value, macroNode.text().get());
 					data->Macros.push_back(newMacro);
 				}
@@ -2703,6 +3154,8 @@ namespace ed {
 				else
 					m_objects->CreateTexture(name);
 
+				m_loader.ReportProgress();
+
 				for (pugi::xml_node bindNode : objectNode.children("bind")) {
 					const pugi::char_t* passBindName = bindNode.attribute("name").as_string();
 					int slot = bindNode.attribute("slot").as_int();
@@ -2996,15 +3449,51 @@ namespace ed {
 				if (!objectNode.attribute("pausedpreview").empty())
 					buf->PreviewPaused = objectNode.attribute("pausedpreview").as_bool();
 
-				std::string bPath = GetProjectPath("buffers/" + std::string(objName) + ".buf");
-				std::ifstream bufRead(bPath, std::ios::binary);
-				if (bufRead.is_open())
-					bufRead.read((char*)buf->Data, buf->Size);
-				bufRead.close();
+				std::string bFile = "buffers/" + std::string(objName) + ".buf";
+				std::string bEntry = GetArchiveEntry(bFile);
+
+				size_t loadedSize = 0;
+				MappedFile* mapping = nullptr;
+				void* loadedData = m_loader.TakeBuffer(bFile, loadedSize, mapping);
+				if (mapping == nullptr && loadedData == nullptr && bEntry.empty()) {
+					mapping = new MappedFile();
+					if (!mapping->Open(GetProjectPath(bFile))) {
+						delete mapping;
+						mapping = nullptr;
+					}
+				}
+
+				if (mapping != nullptr) {
+					if (mapping->GetSize() == buf->Size) {
+						// uploaded straight from the mapping, Data is filled once the CPU needs it
+						free(buf->Data);
+						buf->Data = nullptr;
+						buf->Mapping = mapping;
+						buf->Dirty = false;
+					} else {
+						size_t bufSize = std::min<size_t>(mapping->GetSize(), buf->Size);
+						if (bufSize > 0)
+							memcpy(buf->Data, mapping->GetData(), bufSize);
+						buf->Dirty = true;
+						delete mapping;
+					}
+				} else if (loadedData != nullptr) {
+					// take over the memory that was read on the worker thread
+					if (loadedSize == buf->Size) {
+						free(buf->Data);
+						buf->Data = loadedData;
+					} else {
+						memcpy(buf->Data, loadedData, std::min<size_t>(loadedSize, buf->Size));
+						free(loadedData);
+					}
+
+					buf->Dirty = !bEntry.empty() || loadedSize != buf->Size;
+				} else if (!bEntry.empty())
+					m_archive.Read(bEntry, buf->Data, buf->Size);
+
+				m_objects->UploadBuffer(buf);
 
-				glBindBuffer(GL_UNIFORM_BUFFER, buf->ID);
-				glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // allocate 0 bytes of memory
-				glBindBuffer(GL_UNIFORM_BUFFER, 0);
+				m_loader.ReportProgress();
 
 				for (pugi::xml_node bindNode : objectNode.children("bind")) {
 					const pugi::char_t* passBindName = bindNode.attribute("name").as_string();
@@ -3088,6 +3577,8 @@ namespace ed {
 			if (bobj)
 				gl::CreateBufferVAO(vb.first->VAO, bobj->ID, m_objects->ParseBufferFormat(bobj->ViewFormat));
 		}
+		for (auto& indirect : indirectBuffers)
+			indirect.first->IndirectBuffer = m_objects->GetBuffer(indirect.second);
 
 		// bind objects
 		for (const auto& b : boundTextures)
@@ -3215,6 +3706,8 @@ namespace ed {
 						Settings::Instance().Project.UseAlphaChannel = settingItem.attribute("val").as_bool();
 					else
 						Settings::Instance().Project.UseAlphaChannel = false;
+				} else if (type == "optimizespirv") {
+					Settings::Instance().Project.OptimizeSPIRV = settingItem.attribute("val").as_bool();
 				} else if (type == "ipaths") {
 					Settings::Instance().Project.IncludePaths.clear();
 					for (pugi::xml_node pathNode : settingItem.children("path"))
@@ -2,10 +2,13 @@
 #include <SHADERed/Engine/Model.h>
 #include <SHADERed/GUIManager.h>
 #include <SHADERed/Objects/MessageStack.h>
+#include <SHADERed/Objects/ProjectArchive.h>
+#include <SHADERed/Objects/ProjectLoader.h>
 #include <SHADERed/Objects/ShaderVariable.h>
 
 #include <pugixml/src/pugixml.hpp>
 #include <string>
+#include <unordered_map>
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -24,6 +27,7 @@ namespace ed {
 	class InputLayoutItem;
 	class DebugInformation;
 	struct PipelineItem;
+	struct BufferObject;
 	namespace pipe {
 		struct ShaderPass;
 		struct GeometryItem;
@@ -52,8 +56,14 @@ namespace ed {
 
 		std::string GetRelativePath(const std::string& to);
 		std::string GetProjectPath(const std::string& projectFile);
+		std::vector<std::string> GetIncludePaths(); // absolute paths of the project's include directories - safe to hand to worker threads
 		bool FileExists(const std::string& file);
 
+		// returns the name of the archive entry if the file is stored in the opened .sprjz project
+		std::string GetArchiveEntry(const std::string& file);
+		inline ProjectArchive& GetArchive() { return m_archive; }
+		inline ProjectLoader& GetLoader() { return m_loader; }
+
 		void ResetProjectDirectory();
 		inline void SetProjectDirectory(const std::string& path) { m_projectPath = path; }
 		inline const std::string& GetProjectDirectory() { return m_projectPath; }
@@ -72,12 +82,21 @@ namespace ed {
 		void m_parseVariableValue(pugi::xml_node& node, ShaderVariable* var);
 		void m_exportVariableValue(pugi::xml_node& node, ShaderVariable* vars);
 		void m_exportShaderVariables(pugi::xml_node& node, std::vector<ShaderVariable*>& vars);
+		void m_exportPermutations(pugi::xml_node& node, const std::vector<MacroPermutation>& perms);
+		void m_importPermutations(const pugi::xml_node& node, std::vector<MacroPermutation>& perms);
 		GLenum m_toBlend(const char* str);
 		GLenum m_toBlendOp(const char* str);
 		GLenum m_toComparisonFunc(const char* str);
 		GLenum m_toStencilOp(const char* str);
 		GLenum m_toCullMode(const char* str);
 
+		void m_saveArchive(const std::string& file, pugi::xml_document& doc, const std::string& oldProjectPath, const std::vector<std::pair<std::string, BufferObject*>>& buffers, const std::unordered_map<std::string, std::string>& copies);
+		void m_extractArchive(pugi::xml_document& doc, const std::string& oldProjectPath);
+
+		ProjectLoader::Source m_getLoaderSource(const std::string& file);
+		void m_queueResources(pugi::xml_node& projectNode);
+		void m_queueShaders();
+
 		void m_exportItems(pugi::xml_node& node, std::vector<PipelineItem*>& items, const std::string& oldProjectPath);
 		void m_importItems(const char* owner, pipe::ShaderPass* data, const pugi::xml_node& node, const std::vector<InputLayoutItem>& inpLayout,
 			std::map<pipe::GeometryItem*, std::pair<std::string, pipe::ShaderPass*>>& geoUBOs,
@@ -101,5 +120,8 @@ namespace ed {
 		void m_addPlugin(const std::string& name);
 
 		std::vector<std::pair<std::string, eng::Model*>> m_models;
+
+		ProjectArchive m_archive;
+		ProjectLoader m_loader;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <SHADERed/Engine/Timer.h>
+#include <SHADERed/Objects/FileCache.h>
+#include <SHADERed/Objects/ProjectArchive.h>
+#include <SHADERed/Objects/ProjectValidator.h>
+#include <SHADERed/Objects/ShaderCompiler.h>
+#include <SHADERed/Objects/ThreadPool.h>
+
+#include <pugixml/src/pugixml.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string.h>
+
+namespace ed {
+	static bool isProjectFile(const std::filesystem::path& path)
+	{
+		std::string ext = path.extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+		return ext == ".sprj" || ext == ".sprjz";
+	}
+
+	ProjectValidator::ProjectValidator()
+	{
+	}
+
+	void ProjectValidator::Run(const std::vector<std::string>& paths)
+	{
+		eng::Timer timer;
+
+		m_report.Projects.clear();
+		for (const auto& path : paths) {
+			std::error_code ec;
+			if (std::filesystem::is_directory(path, ec)) {
+				for (const auto& entry : std::filesystem::recursive_directory_iterator(path, std::filesystem::directory_options::skip_permission_denied, ec))
+					if (entry.is_regular_file(ec) && isProjectFile(entry.path())) {
+						m_report.Projects.push_back(Project());
+						m_report.Projects.back().Path = entry.path().generic_string();
+					}
+			} else {
+				m_report.Projects.push_back(Project());
+				m_report.Projects.back().Path = std::filesystem::path(path).generic_string();
+			}
+		}
+
+		// same order on every run
+		std::sort(m_report.Projects.begin(), m_report.Projects.end(), [](const Project& a, const Project& b) { return a.Path < b.Path; });
+
+		// one job per project - m_report.Projects doesn't change size from now on
+		std::mutex mutex;
+		std::condition_variable cv;
+		size_t remaining = m_report.Projects.size();
+
+		for (Project& proj : m_report.Projects) {
+			ThreadPool::Instance().Submit([&, projPtr = &proj]() {
+				m_validate(*projPtr);
+
+				std::unique_lock<std::mutex> lock(mutex);
+				remaining--;
+				cv.notify_one();
+			});
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		cv.wait(lock, [&]() { return remaining == 0; });
+
+		m_report.Time = timer.GetElapsedTime();
+	}
+
+	void ProjectValidator::m_validate(Project& proj)
+	{
+		eng::Timer timer;
+
+		ProjectArchive archive;
+		if (m_load(proj, archive)) {
+			for (Pass& pass : proj.Passes)
+				for (Stage& stage : pass.Stages)
+					m_compile(proj, pass, stage, archive);
+		}
+
+		proj.Time = timer.GetElapsedTime();
+	}
+	bool ProjectValidator::m_load(Project& proj, ProjectArchive& archive)
+	{
+		pugi::xml_document doc;
+		pugi::xml_parse_result result;
+
+		if (ProjectArchive::IsArchive(proj.Path)) {
+			if (!archive.Open(proj.Path)) {
+				proj.Error = "Failed to open the archive";
+				return false;
+			}
+			std::string projectSrc = archive.Read(ProjectArchive::ProjectEntry);
+			result = doc.load_string(projectSrc.c_str());
+		} else
+			result = doc.load_file(proj.Path.c_str());
+
+		if (!result) {
+			proj.Error = std::string("Failed to parse the project file: ") + result.description();
+			return false;
+		}
+
+		pugi::xml_node projectNode = doc.child("project");
+		if (!projectNode) {
+			proj.Error = "Not a SHADERed project";
+			return false;
+		}
+
+		// V1 projects store the path & entry as child elements
+		int projectVersion = projectNode.attribute("version").empty() ? 1 : projectNode.attribute("version").as_int();
+		auto readProperty = [&](const pugi::xml_node& node, const char* name) -> std::string {
+			if (projectVersion == 1)
+				return node.child(name).text().as_string();
+			return node.attribute(name).as_string();
+		};
+
+		std::filesystem::path projectDir = std::filesystem::path(proj.Path).parent_path();
+
+		for (pugi::xml_node settingItem : projectNode.child("settings").children("entry"))
+			if (strcmp(settingItem.attribute("type").as_string(), "ipaths") == 0)
+				for (pugi::xml_node pathNode : settingItem.children("path"))
+					proj.IncludePaths.push_back((projectDir / pathNode.text().as_string()).generic_string());
+
+		for (pugi::xml_node passNode : projectNode.child("pipeline").children("pass")) {
+			Pass pass;
+			pass.Name = passNode.attribute("name").as_string();
+			pass.Type = passNode.attribute("type").empty() ? "shader" : passNode.attribute("type").as_string();
+
+			for (pugi::xml_node macroNode : passNode.child("macros").children("define")) {
+				ShaderMacro macro;
+				strncpy(macro.Name, macroNode.attribute("name").as_string(), sizeof(macro.Name) - 1);
+				macro.Name[sizeof(macro.Name) - 1] = 0;
+				strncpy(macro.Value, macroNode.text().get(), sizeof(macro.Value) - 1);
+				macro.Value[sizeof(macro.Value) - 1] = 0;
+				macro.Active = macroNode.attribute("active").empty() ? true : macroNode.attribute("active").as_bool();
+				macro.Specialize = macroNode.attribute("specialize").as_bool();
+				pass.Macros.push_back(macro);
+			}
+
+			for (pugi::xml_node shaderNode : passNode.children("shader")) {
+				std::string type = shaderNode.attribute("type").as_string();
+
+				Stage stage;
+				stage.Path = readProperty(shaderNode, "path");
+				stage.Entry = readProperty(shaderNode, "entry");
+				stage.Passed = false;
+
+				if (type == "vs")
+					stage.Type = ShaderStage::Vertex;
+				else if (type == "ps")
+					stage.Type = ShaderStage::Pixel;
+				else if (type == "gs") {
+					stage.Type = ShaderStage::Geometry;
+					if (!shaderNode.attribute("used").as_bool())
+						continue;
+				} else if (type == "cs")
+					stage.Type = ShaderStage::Compute;
+				else if (type == "ss")
+					stage.Type = ShaderStage::Audio;
+				else
+					continue;
+
+				stage.Language = ShaderCompiler::GetShaderLanguageFromExtension(stage.Path);
+				if (stage.Entry.empty())
+					stage.Entry = "main";
+
+				if (pass.Type == "plugin" || stage.Language == ShaderLanguage::Plugin)
+					stage.Skipped = "plugin languages need the plugin to be loaded";
+				else if (stage.Type == ShaderStage::Audio)
+					stage.Skipped = "audio shaders are compiled by the audio stream";
+
+				pass.Stages.push_back(stage);
+			}
+
+			proj.Passes.push_back(pass);
+		}
+
+		return true;
+	}
+	void ProjectValidator::m_compile(Project& proj, Pass& pass, Stage& stage, ProjectArchive& archive)
+	{
+		if (!stage.Skipped.empty())
+			return;
+
+		MessageStack msgs;
+		msgs.CurrentItem = pass.Name;
+
+		std::filesystem::path path(stage.Path);
+		if (path.is_relative())
+			path = std::filesystem::path(proj.Path).parent_path() / path;
+		std::string file = path.lexically_normal().generic_string();
+
+		// files that are packed in the archive go first
+		std::string source;
+		std::string entry = std::filesystem::path(stage.Path).lexically_normal().generic_string();
+		bool loaded = false;
+		if (archive.IsOpen() && !std::filesystem::path(stage.Path).is_absolute() && archive.Exists(entry)) {
+			source = archive.Read(entry);
+			loaded = true;
+		} else
+			loaded = FileCache::Instance().Read(file, source);
+
+		if (!loaded)
+			msgs.Add(MessageStack::Type::Error, pass.Name, "Failed to open file " + file, -1, stage.Type);
+		else {
+			std::vector<unsigned int> spv;
+			bool gsUsed = std::count_if(pass.Stages.begin(), pass.Stages.end(), [](const Stage& s) { return s.Type == ShaderStage::Geometry; }) > 0;
+
+			// GLSL is compiled by the driver in the editor - glslang is the closest we get without a context
+			stage.Passed = ShaderCompiler::CompileSourceToSPIRV(spv, stage.Language, file, source, stage.Type, stage.Entry, pass.Macros, &msgs, nullptr, false, &proj.IncludePaths);
+			if (stage.Passed && stage.Language != ShaderLanguage::GLSL)
+				stage.Passed = ShaderCompiler::ConvertToGLSL(spv, stage.Language, stage.Type, gsUsed, &msgs) != "error";
+		}
+
+		stage.Messages = msgs.GetMessages();
+		if (!msgs.CanRenderPreview()) // any error
+			stage.Passed = false;
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <SHADERed/Objects/ValidationReport.h>
+
+#include <string>
+#include <vector>
+
+namespace ed {
+	class ProjectArchive;
+
+	/* --validate: compiles every pass & stage of the given projects with glslang (and SPIRV-Cross for HLSL/Vulkan GLSL)
+		without a GL context - the project XML is read directly (no ObjectManager/RenderEngine), one job per project on the ThreadPool */
+	class ProjectValidator {
+	public:
+		ProjectValidator();
+
+		typedef ValidationReport::Stage Stage;
+		typedef ValidationReport::Pass Pass;
+		typedef ValidationReport::Project Project;
+
+		// directories are searched recursively for .sprj and .sprjz files
+		void Run(const std::vector<std::string>& paths);
+
+		inline ValidationReport& GetReport() { return m_report; }
+
+	private:
+		void m_validate(Project& proj);
+		bool m_load(Project& proj, ProjectArchive& archive);
+		void m_compile(Project& proj, Pass& pass, Stage& stage, ProjectArchive& archive);
+
+		ValidationReport m_report;
+	};
+}
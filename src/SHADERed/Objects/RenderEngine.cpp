@@ -7,11 +7,15 @@
 #include <SHADERed/Objects/ObjectManager.h>
 #include <SHADERed/Objects/PipelineManager.h>
 #include <SHADERed/Objects/RenderEngine.h>
+#include <SHADERed/Objects/SPIRVSpecialization.h>
 #include <SHADERed/Objects/Settings.h>
 #include <SHADERed/Objects/ShaderCompiler.h>
 #include <SHADERed/Objects/SystemVariableManager.h>
+#include <SHADERed/Objects/ThreadPool.h>
 
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
 #include <glm/gtx/intersect.hpp>
 
 static const GLenum fboBuffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3, GL_COLOR_ATTACHMENT4, GL_COLOR_ATTACHMENT5, GL_COLOR_ATTACHMENT6, GL_COLOR_ATTACHMENT7, GL_COLOR_ATTACHMENT8, GL_COLOR_ATTACHMENT9, GL_COLOR_ATTACHMENT10, GL_COLOR_ATTACHMENT11, GL_COLOR_ATTACHMENT12, GL_COLOR_ATTACHMENT13, GL_COLOR_ATTACHMENT14, GL_COLOR_ATTACHMENT15 };
@@ -26,6 +30,32 @@ void main()
 	outColor = _sed_dbg_pixel_color;
 }
 )";
+static const size_t MaxProgramVariants = 32; // per pipeline item
+static const size_t MaxCachedPermutations = 64;
+static const size_t MaxPermutationMemory = 256 * 1024 * 1024;
+
+// values of the macros lowered to specialization constants
+static std::string getSpecializationKey(const std::vector<ed::ShaderMacro>& macros)
+{
+	std::string ret = "";
+	for (const auto& macro : macros)
+		if (ed::SPIRVSpecialization::IsSpecializable(macro))
+			ret += std::string(macro.Name) + "=" + (macro.Active ? macro.Value : "") + ";";
+	return ret;
+}
+// everything else - a change here needs a full recompile
+static std::string getMacroSignature(const std::vector<ed::ShaderMacro>& macros)
+{
+	std::string ret = "";
+	for (const auto& macro : macros) {
+		if (ed::SPIRVSpecialization::IsSpecializable(macro)) {
+			bool isBool = strcmp(macro.Value, "true") == 0 || strcmp(macro.Value, "false") == 0;
+			ret += std::string("$") + (isBool ? "bool " : "int ") + macro.Name + ";";
+		} else if (macro.Active)
+			ret += std::string(macro.Name) + "=" + macro.Value + ";";
+	}
+	return ret;
+}
 
 
 namespace ed {
@@ -100,6 +130,23 @@ namespace ed {
 			, m_wasMultiPick(false)
 	{
 		m_paused = false;
+		m_asyncCompile = std::make_shared<AsyncCompileQueue>();
+		m_lazySPIRV = std::make_shared<LazySPIRVQueue>();
+		m_permutationQueue = std::make_shared<PermutationQueue>();
+		m_permutationClock = 0;
+		m_gpuTimersEnabled = false;
+		m_gpuTimerFrame = 0;
+		m_comparison.Item = nullptr;
+		m_comparison.Current = 0;
+		m_comparison.Program = 0;
+		m_comparison.CheckRequested = m_comparison.Checking = m_comparison.Checked = false;
+		m_fullBarriers = false;
+		m_checkingBarriers = false;
+		m_barrierCheckFrame = 0;
+		for (int i = 0; i < 2; i++) {
+			m_backendTime[i] = 0.0f;
+			m_backendCount[i] = 0;
+		}
 
 		glGenTextures(1, &m_rtColor);
 		glGenTextures(1, &m_rtDepth);
@@ -165,6 +212,11 @@ namespace ed {
 		// cache elements
 		m_cache();
 
+		// debug renders & renders up to an item need every pass
+		bool cull = !isDebug && breakItem == nullptr;
+		if (cull)
+			m_cullPasses();
+
 		auto& systemVM = SystemVariableManager::Instance();
 
 		auto& itemVarValues = GetItemVariableValues();
@@ -173,6 +225,19 @@ namespace ed {
 		bool clearedWindow = false;
 		int debugID = DEBUG_ID_START;
 
+		// compare the output of both A/B versions before this frame's swap
+		if (m_comparison.CheckRequested && !isDebug) {
+			m_comparison.CheckRequested = false;
+			m_checkComparison(width, height);
+		}
+		// compare the derived memory barriers with GL_ALL_BARRIER_BITS every few frames
+		if (Settings::Instance().Debug.ValidateBarriers && !isDebug && !m_paused && m_computeSupported && !m_checkingBarriers && breakItem == nullptr && m_comparison.Item == nullptr) {
+			if (m_barrierCheckFrame++ % BarrierCheckInterval == 0)
+				m_checkBarriers(width, height);
+		}
+		int compareIndex = isDebug ? -1 : m_beginComparisonFrame();
+		bool timeComparison = compareIndex != -1 && !m_comparison.Checking;
+
 		m_plugins->BeginRender();
 
 		for (int i = 0; i < m_items.size(); i++) {
@@ -183,6 +248,8 @@ namespace ed {
 
 				if (!data->Active || data->Items.size() <= 0 || data->RTCount == 0 /* || (isDebug && data->GSUsed) */)
 					continue;
+				if (cull && m_culled.count(it))
+					continue;
 
 				const std::vector<GLuint>& srvs = m_objects->GetBindList(m_items[i]);
 				const std::vector<GLuint>& ubos = m_objects->GetUniformBindList(m_items[i]);
@@ -193,6 +260,13 @@ namespace ed {
 				if (m_shaders[i] == 0)
 					continue;
 
+				m_syncPass(it);
+
+				if (timeComparison && i == compareIndex)
+					m_beginGPUTimer(m_comparison.Timers[m_comparison.Current], ComparisonWarmup + ComparisonSamples);
+				else if (m_gpuTimersEnabled && !isDebug)
+					m_beginGPUTimer(it);
+
 				// bind fbo and buffers
 				glBindFramebuffer(GL_FRAMEBUFFER, isMSAA ? m_fboMS[data] : data->FBO);
 				glDrawBuffers(data->RTCount, fboBuffers);
@@ -441,11 +515,14 @@ namespace ed {
 						glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 					}
 				}
+
+				if ((timeComparison && i == compareIndex) || (m_gpuTimersEnabled && !isDebug))
+					m_endGPUTimer();
 			}
 			else if (it->Type == PipelineItem::ItemType::ComputePass && !isDebug && !m_paused && m_computeSupported) {
 				pipe::ComputePass* data = (pipe::ComputePass*)it->Data;
 
-				if (!data->Active)
+				if (!data->Active || (cull && m_culled.count(it)))
 					continue;
 
 				const std::vector<GLuint>& srvs = m_objects->GetBindList(m_items[i]);
@@ -476,29 +553,73 @@ namespace ed {
 				for (int j = ubos.size(); j < cMax; j++)
 					glBindBufferBase(GL_SHADER_STORAGE_BUFFER, j, 0);
 
-				for (int j = 0; j < ubos.size(); j++) {
-					if (m_objects->IsImage(ubos[j])) {
-						ImageObject* iobj = m_objects->GetImage(m_objects->GetImageNameByID(ubos[j])); // TODO: GetImageByID
-						glBindImageTexture(j, ubos[j], 0, GL_FALSE, 0, GL_WRITE_ONLY | GL_READ_ONLY, iobj->Format);
-					} else if (m_objects->IsImage3D(ubos[j])) {
-						Image3DObject* iobj = m_objects->GetImage3D(m_objects->GetImage3DNameByID(ubos[j]));
-						glBindImageTexture(j, ubos[j], 0, GL_TRUE, 0, GL_WRITE_ONLY | GL_READ_ONLY, iobj->Format);
-					} else if (m_objects->IsPluginObject(ubos[j])) {
-						PluginObject* pobj = m_objects->GetPluginObject(ubos[j]);
-						pobj->Owner->Object_Bind(pobj->Type, pobj->Data, pobj->ID);
-					} else
-						glBindBufferBase(GL_SHADER_STORAGE_BUFFER, j, ubos[j]);
+				// binding slots of the ping-pong pairs
+				std::vector<std::pair<int, int>> pingPong;
+				auto isStorage = [&](const std::string& name) -> bool {
+					return m_objects->IsBuffer(name) || m_objects->IsImage(name) || m_objects->IsImage3D(name);
+				};
+				for (const auto& pair : data->PingPong) {
+					if (!isStorage(pair.first) || !isStorage(pair.second))
+						continue;
+
+					int first = m_objects->IsUniformBound(pair.first, it);
+					int second = m_objects->IsUniformBound(pair.second, it);
+					if (first != -1 && second != -1 && first != second)
+						pingPong.push_back(std::make_pair(first, second));
 				}
 
+				std::vector<GLuint> bound = ubos;
+				if (data->PingPongSwapped)
+					for (const auto& pair : pingPong)
+						std::swap(bound[pair.first], bound[pair.second]);
+
+				for (int j = 0; j < bound.size(); j++)
+					m_bindStorage(j, bound[j]);
+
 				// bind variables
 				data->Variables.Bind();
 
+				BufferObject* indirect = (BufferObject*)data->IndirectBuffer;
+				if (indirect != nullptr && indirect->Size < 3 * sizeof(GLuint))
+					indirect = nullptr;
+				if (indirect != nullptr)
+					glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, indirect->ID);
+
 				// call compute shader
-				glDispatchCompute(data->WorkX, data->WorkY, data->WorkZ);
+				if (m_gpuTimersEnabled)
+					m_beginGPUTimer(it);
+				for (int iter = 0; iter < data->Iterations; iter++) {
+					if (iter > 0)
+						for (const auto& pair : pingPong) {
+							m_bindStorage(pair.first, bound[pair.first]);
+							m_bindStorage(pair.second, bound[pair.second]);
+						}
+
+					// results of earlier passes, iterations or frames
+					m_syncPass(it);
+
+					if (indirect != nullptr)
+						glDispatchComputeIndirect(0);
+					else
+						glDispatchCompute(data->WorkX, data->WorkY, data->WorkZ);
+
+					// independent dispatches run without a barrier in between - the readers issue it
+					if (m_fullBarriers)
+						glMemoryBarrier(GL_ALL_BARRIER_BITS);
+					else
+						m_markWritten(bound);
+
+					// the next iteration (or the next frame) reads what this one has written
+					for (const auto& pair : pingPong)
+						std::swap(bound[pair.first], bound[pair.second]);
+					if (!pingPong.empty())
+						data->PingPongSwapped = !data->PingPongSwapped;
+				}
+				if (m_gpuTimersEnabled)
+					m_endGPUTimer();
 
-				// wait until it finishes
-				glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-				// or maybe until i implement these as options glMemoryBarrier(GL_ALL_BARRIER_BITS);
+				if (indirect != nullptr)
+					glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
 			}
 			else if (it->Type == PipelineItem::ItemType::AudioPass && !isDebug) {
 				pipe::AudioPass* data = (pipe::AudioPass*)it->Data;
@@ -532,11 +653,15 @@ namespace ed {
 				// bind variables
 				data->Variables.Bind();
 
+				m_syncPass(it);
+
 				data->Stream.renderAudio();
 			}
 			else if (it->Type == PipelineItem::ItemType::PluginItem) {
 				pipe::PluginItemData* pldata = reinterpret_cast<pipe::PluginItemData*>(it->Data);
 
+				m_syncPass(it);
+
 				if (!isDebug)
 					pldata->Owner->PipelineItem_Execute(pldata->Type, pldata->PluginData, pldata->Items.data(), pldata->Items.size());
 				else if (pldata->Owner->PipelineItem_IsDebuggable(pldata->Type, pldata->PluginData))
@@ -547,8 +672,22 @@ namespace ed {
 				break;
 		}
 
+		// object previews & buffer viewers read the results after the frame
+		GLbitfield uiBits = 0;
+		for (const auto& obj : m_barrierBuffers)
+			uiBits |= ~obj.second & GL_BUFFER_UPDATE_BARRIER_BIT;
+		for (const auto& obj : m_barrierTextures)
+			uiBits |= ~obj.second & (GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+		if (uiBits != 0)
+			m_issueBarrier(uiBits);
+
 		m_plugins->EndRender();
 
+		m_endComparisonFrame(compareIndex);
+
+		if ((m_gpuTimersEnabled || timeComparison) && !isDebug)
+			m_gpuTimerFrame++;
+
 		// update frame index
 		if (!m_paused) {
 			systemVM.CopyState();
@@ -1022,6 +1161,8 @@ namespace ed {
 	{
 		Logger::Get().Log("Recompiling " + std::string(name));
 
+		m_cancelAsyncCompile(name);
+
 		m_msgs->BuildOccured = true;
 		m_msgs->CurrentItem = name;
 
@@ -1035,6 +1176,8 @@ namespace ed {
 					pipe::ShaderPass* shader = (pipe::ShaderPass*)item->Data;
 
 					SPIRVQueue.push_back(item);
+					m_hashSources(item);
+					m_resetSpecialized(item, shader->Macros);
 
 					m_msgs->ClearGroup(name);
 
@@ -1044,22 +1187,76 @@ namespace ed {
 
 					std::string psContent = "", vsContent = "",
 								vsEntry = shader->VSEntry,
-								psEntry = shader->PSEntry;
+								psEntry = shader->PSEntry,
+								gsEntry = shader->GSEntry;
 					int lineBias = 0;
 					ShaderLanguage psLang = ShaderCompiler::GetShaderLanguageFromExtension(shader->PSPath);
 					ShaderLanguage vsLang = ShaderCompiler::GetShaderLanguageFromExtension(shader->VSPath);
 					ShaderLanguage gsLang = ShaderCompiler::GetShaderLanguageFromExtension(shader->GSPath);
+					bool gsActive = shader->GSUsed && strlen(shader->GSPath) > 0 && strlen(shader->GSEntry) > 0;
 
-					// pixel shader
-					bool psCompiled = false;
+					// SPIR-V
+					bool psCompiled = false, vsCompiled = false, gsCompiled = true;
 
 					if (psLang == ShaderLanguage::Plugin)
 						psCompiled = m_pluginCompileToSpirv(shader->PSSPV, shader->PSPath, psEntry, plugin::ShaderStage::Pixel, shader->Macros.data(), shader->Macros.size());
-					else
+					else if (psLang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
 						psCompiled = ShaderCompiler::CompileToSPIRV(shader->PSSPV, psLang, shader->PSPath, ShaderStage::Pixel, psEntry, shader->Macros, m_msgs, m_project);
+					else
+						psCompiled = true;
+
+					if (vsLang == ShaderLanguage::Plugin)
+						vsCompiled = m_pluginCompileToSpirv(shader->VSSPV, shader->VSPath, vsEntry, plugin::ShaderStage::Vertex, shader->Macros.data(), shader->Macros.size());
+					else if (vsLang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
+						vsCompiled = ShaderCompiler::CompileToSPIRV(shader->VSSPV, vsLang, shader->VSPath, ShaderStage::Vertex, vsEntry, shader->Macros, m_msgs, m_project);
+					else
+						vsCompiled = true;
+
+					if (gsActive) {
+						if (gsLang == ShaderLanguage::Plugin)
+							gsCompiled = m_pluginCompileToSpirv(shader->GSSPV, shader->GSPath, gsEntry, plugin::ShaderStage::Geometry, shader->Macros.data(), shader->Macros.size());
+						else if (gsLang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
+							gsCompiled = ShaderCompiler::CompileToSPIRV(shader->GSSPV, gsLang, shader->GSPath, ShaderStage::Geometry, gsEntry, shader->Macros, m_msgs, m_project);
+						else
+							gsCompiled = true;
+					}
+
+					eng::Timer backendTimer;
+
+					if (m_shaders[i] != 0)
+						glDeleteProgram(m_shaders[i]);
+					m_shaders[i] = 0;
+
+					// GL_ARB_gl_spirv
+					GLuint spvShaders[3] = { 0, 0, 0 };
+					if (vsCompiled && psCompiled && gsCompiled && (gsActive || !shader->GSUsed)) {
+						m_shaderSources[i] = ShaderPack(); // old shaders were deleted above
+						const std::vector<unsigned int>* spv[3] = { &shader->VSSPV, &shader->PSSPV, &shader->GSSPV };
+						m_shaders[i] = m_linkSPIRVPass(i, shader, spv, spvShaders);
+					}
+
+					if (m_shaders[i] != 0) {
+						m_shaderSources[i].VS = spvShaders[0];
+						m_shaderSources[i].PS = spvShaders[1];
+						m_shaderSources[i].GS = spvShaders[2];
+
+						m_msgs->Add(MessageStack::Type::Message, name, "Compiled the shaders.");
+
+						shader->Variables.SetTextureList(m_shaderSources[i].Samplers);
+						shader->Variables.SetUniformLocations(m_shaderSources[i].Locations);
+						shader->Variables.UpdateUniformInfo(m_shaders[i]);
+
+						m_logBackendTime(name, true, backendTimer.GetElapsedTime());
 
+						m_activePermutation[item] = m_permutationKey(item, shader->Macros);
+						WarmPermutations(item);
+						continue;
+					}
+
+					// pixel shader
 					if (psLang == ShaderLanguage::GLSL) { // GLSL
 						psContent = m_project->LoadProjectFile(shader->PSPath);
+						m_queueLazySPIRV(item, ShaderStage::Pixel, shader->PSPath, psContent, shader->PSEntry, shader->Macros);
 						m_includeCheck(psContent, std::vector<std::string>(), lineBias);
 						m_applyMacros(psContent, shader);
 					} else { // HLSL / VK
@@ -1076,16 +1273,11 @@ namespace ed {
 
 					// vertex shader
 					lineBias = 0;
-					bool vsCompiled = false;
-
-					if (vsLang == ShaderLanguage::Plugin)
-						vsCompiled = m_pluginCompileToSpirv(shader->VSSPV, shader->VSPath, vsEntry, plugin::ShaderStage::Vertex, shader->Macros.data(), shader->Macros.size());
-					else
-						vsCompiled = ShaderCompiler::CompileToSPIRV(shader->VSSPV, vsLang, shader->VSPath, ShaderStage::Vertex, vsEntry, shader->Macros, m_msgs, m_project);
 					
 					// generate glsl
 					if (vsLang == ShaderLanguage::GLSL) { // GLSL
 						vsContent = m_project->LoadProjectFile(shader->VSPath);
+						m_queueLazySPIRV(item, ShaderStage::Vertex, shader->VSPath, vsContent, shader->VSEntry, shader->Macros);
 						m_includeCheck(vsContent, std::vector<std::string>(), lineBias);
 						m_applyMacros(vsContent, shader);
 					} else { // HLSL / VK
@@ -1100,21 +1292,15 @@ namespace ed {
 					vsCompiled &= gl::CheckShaderCompilationStatus(vs);
 
 					// geometry shader
-					bool gsCompiled = true;
 					GLuint gs = 0;
-					if (shader->GSUsed && strlen(shader->GSPath) > 0 && strlen(shader->GSEntry) > 0) {
-						std::string gsContent = "",
-									gsEntry = shader->GSEntry;
+					if (gsActive) {
+						std::string gsContent = "";
 
 						lineBias = 0;
 						
-						if (gsLang == ShaderLanguage::Plugin)
-							gsCompiled = m_pluginCompileToSpirv(shader->GSSPV, shader->GSPath, gsEntry, plugin::ShaderStage::Geometry, shader->Macros.data(), shader->Macros.size());
-						else
-							gsCompiled = ShaderCompiler::CompileToSPIRV(shader->GSSPV, gsLang, shader->GSPath, ShaderStage::Geometry, gsEntry, shader->Macros, m_msgs, m_project);
-						
 						if (gsLang == ShaderLanguage::GLSL) { // GLSL
 							gsContent = m_project->LoadProjectFile(shader->GSPath);
+							m_queueLazySPIRV(item, ShaderStage::Geometry, shader->GSPath, gsContent, shader->GSEntry, shader->Macros);
 							m_includeCheck(gsContent, std::vector<std::string>(), lineBias);
 							m_applyMacros(gsContent, shader);
 						} else { // HLSL / VK
@@ -1132,10 +1318,9 @@ namespace ed {
 							gsCompiled = false;
 					}
 
-					if (m_shaders[i] != 0)
-						glDeleteProgram(m_shaders[i]);
-
 					if (!vsCompiled || !psCompiled || !gsCompiled || vsContent.empty() || psContent.empty()) {
+						m_finishLazySPIRV(item, true); // glslang's error messages
+
 						Logger::Get().Log("Shaders not compiled", true);
 						if (vsContent.empty() || psContent.empty())
 							m_msgs->Add(MessageStack::Type::Error, name, "Shader source empty - try recompiling");
@@ -1151,18 +1336,27 @@ namespace ed {
 						glAttachShader(m_shaders[i], ps);
 						if (shader->GSUsed) glAttachShader(m_shaders[i], gs);
 						glLinkProgram(m_shaders[i]);
+
+						m_logBackendTime(name, false, backendTimer.GetElapsedTime());
 					}
 
 					if (m_shaders[i] != 0)
 						shader->Variables.UpdateUniformInfo(m_shaders[i]);
 
+					m_shaderSources[i] = ShaderPack();
 					m_shaderSources[i].VS = vs;
 					m_shaderSources[i].PS = ps;
 					m_shaderSources[i].GS = gs;
+
+					if (m_shaders[i] != 0)
+						m_activePermutation[item] = m_permutationKey(item, shader->Macros);
+					WarmPermutations(item);
 				} else if (item->Type == PipelineItem::ItemType::ComputePass && m_computeSupported) {
 					pipe::ComputePass* shader = (pipe::ComputePass*)item->Data;
 
 					SPIRVQueue.push_back(item);
+					m_hashSources(item);
+					m_resetSpecialized(item, shader->Macros);
 
 					m_msgs->ClearGroup(name);
 
@@ -1175,11 +1369,14 @@ namespace ed {
 						
 					if (lang == ShaderLanguage::Plugin)
 						compiled = m_pluginCompileToSpirv(shader->SPV, shader->Path, entry, plugin::ShaderStage::Compute, shader->Macros.data(), shader->Macros.size());
-					else
+					else if (lang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
 						compiled = ShaderCompiler::CompileToSPIRV(shader->SPV, lang, shader->Path, ShaderStage::Compute, entry, shader->Macros, m_msgs, m_project);
+					else
+						compiled = true;
 					
 					if (lang == ShaderLanguage::GLSL) { // GLSL
 						content = m_project->LoadProjectFile(shader->Path);
+						m_queueLazySPIRV(item, ShaderStage::Compute, shader->Path, content, shader->Entry, shader->Macros);
 						m_includeCheck(content, std::vector<std::string>(), lineBias);
 						m_applyMacros(content, shader);
 					} else { // HLSL / VK
@@ -1198,6 +1395,8 @@ namespace ed {
 						glDeleteProgram(m_shaders[i]);
 
 					if (!compiled || content.empty()) {
+						m_finishLazySPIRV(item, true); // glslang's error messages
+
 						Logger::Get().Log("Compute shader was not compiled", true);
 						if (content.empty())
 							m_msgs->Add(MessageStack::Type::Error, name, "Shader source empty - try recompiling");
@@ -1214,8 +1413,11 @@ namespace ed {
 
 					glDeleteShader(cs);
 
-					if (m_shaders[i] != 0)
+					if (m_shaders[i] != 0) {
 						shader->Variables.UpdateUniformInfo(m_shaders[i]);
+						m_activePermutation[item] = m_permutationKey(item, shader->Macros);
+					}
+					WarmPermutations(item);
 				} else if (item->Type == PipelineItem::ItemType::AudioPass) {
 					pipe::AudioPass* shader = (pipe::AudioPass*)item->Data;
 
@@ -1260,6 +1462,8 @@ namespace ed {
 	}
 	void RenderEngine::RecompileFromSource(const char* name, const std::string& vssrc, const std::string& pssrc, const std::string& gssrc)
 	{
+		m_cancelAsyncCompile(name);
+
 		m_msgs->BuildOccured = true;
 		m_msgs->CurrentItem = name;
 
@@ -1274,20 +1478,79 @@ namespace ed {
 					m_msgs->ClearGroup(name);
 
 					SPIRVQueue.push_back(item);
+					m_hashSources(item);
+					m_resetSpecialized(item, shader->Macros);
 
 					bool vsCompiled = true, psCompiled = true, gsCompiled = true;
 					int lineBias = 0;
 
-					// pixel shader
+					ShaderLanguage psLang = ShaderCompiler::GetShaderLanguageFromExtension(shader->PSPath);
+					ShaderLanguage vsLang = ShaderCompiler::GetShaderLanguageFromExtension(shader->VSPath);
+					ShaderLanguage gsLang = ShaderCompiler::GetShaderLanguageFromExtension(shader->GSPath);
+
+					// SPIR-V
 					if (pssrc.size() > 0) {
-						ShaderLanguage psLang = ShaderCompiler::GetShaderLanguageFromExtension(shader->PSPath);
 						if (psLang == ShaderLanguage::Plugin)
 							psCompiled = m_pluginCompileToSpirv(shader->PSSPV, shader->PSPath, shader->PSEntry, plugin::ShaderStage::Pixel, shader->Macros.data(), shader->Macros.size(), pssrc);
-						else
+						else if (psLang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
 							psCompiled = ShaderCompiler::CompileSourceToSPIRV(shader->PSSPV, psLang, shader->PSPath, pssrc, ShaderStage::Pixel, shader->PSEntry, shader->Macros, m_msgs, m_project);
+					}
+					if (vssrc.size() > 0) {
+						if (vsLang == ShaderLanguage::Plugin)
+							vsCompiled = m_pluginCompileToSpirv(shader->VSSPV, shader->VSPath, shader->VSEntry, plugin::ShaderStage::Vertex, shader->Macros.data(), shader->Macros.size(), vssrc);
+						else if (vsLang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
+							vsCompiled = ShaderCompiler::CompileSourceToSPIRV(shader->VSSPV, vsLang, shader->VSPath, vssrc, ShaderStage::Vertex, shader->VSEntry, shader->Macros, m_msgs, m_project);
+					}
+					if (gssrc.size() > 0) {
+						if (gsLang == ShaderLanguage::Plugin)
+							gsCompiled = m_pluginCompileToSpirv(shader->GSSPV, shader->GSPath, shader->GSEntry, plugin::ShaderStage::Geometry, shader->Macros.data(), shader->Macros.size(), gssrc);
+						else if (gsLang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
+							gsCompiled = ShaderCompiler::CompileSourceToSPIRV(shader->GSSPV, gsLang, shader->GSPath, gssrc, ShaderStage::Geometry, shader->GSEntry, shader->Macros, m_msgs, m_project);
+					}
+
+					eng::Timer backendTimer;
+
+					// GL_ARB_gl_spirv
+					if (vsCompiled && psCompiled && gsCompiled) {
+						const std::vector<unsigned int>* spv[3] = {
+							vssrc.size() > 0 ? &shader->VSSPV : nullptr,
+							pssrc.size() > 0 ? &shader->PSSPV : nullptr,
+							gssrc.size() > 0 ? &shader->GSSPV : nullptr
+						};
+						GLuint created[3] = { 0, 0, 0 };
+						GLuint prog = m_linkSPIRVPass(i, shader, spv, created);
+						if (prog != 0) {
+							GLuint* objs[3] = { &m_shaderSources[i].VS, &m_shaderSources[i].PS, &m_shaderSources[i].GS };
+							for (int s = 0; s < 3; s++) {
+								if (created[s] == 0)
+									continue;
+								if (*objs[s] != 0)
+									glDeleteShader(*objs[s]);
+								*objs[s] = created[s];
+							}
 
+							if (m_shaders[i] != 0)
+								glDeleteProgram(m_shaders[i]);
+							m_shaders[i] = prog;
+
+							m_msgs->Add(MessageStack::Type::Message, name, "Compiled the shaders.");
+
+							shader->Variables.SetTextureList(m_shaderSources[i].Samplers);
+							shader->Variables.SetUniformLocations(m_shaderSources[i].Locations);
+							shader->Variables.UpdateUniformInfo(m_shaders[i]);
+
+							m_logBackendTime(name, true, backendTimer.GetElapsedTime());
+							continue;
+						}
+					}
+					if (m_shaderSources[i].SPIRV)
+						m_convertPassToGLSL(i, shader);
+
+					// pixel shader
+					if (pssrc.size() > 0) {
 						std::string psContent = pssrc;
 						if (psLang == ShaderLanguage::GLSL) { // GLSL
+							m_queueLazySPIRV(item, ShaderStage::Pixel, shader->PSPath, pssrc, shader->PSEntry, shader->Macros);
 							m_includeCheck(psContent, std::vector<std::string>(), lineBias);
 							m_applyMacros(psContent, shader);
 						} else { // HLSL / VK
@@ -1311,14 +1574,9 @@ namespace ed {
 					if (vssrc.size() > 0) {
 						lineBias = 0;
 						
-						ShaderLanguage vsLang = ShaderCompiler::GetShaderLanguageFromExtension(shader->VSPath);
-						if (vsLang == ShaderLanguage::Plugin)
-							vsCompiled = m_pluginCompileToSpirv(shader->VSSPV, shader->VSPath, shader->VSEntry, plugin::ShaderStage::Vertex, shader->Macros.data(), shader->Macros.size(), vssrc);
-						else
-							vsCompiled = ShaderCompiler::CompileSourceToSPIRV(shader->VSSPV, vsLang, shader->VSPath, vssrc, ShaderStage::Vertex, shader->VSEntry, shader->Macros, m_msgs, m_project);
-
 						std::string vsContent = vssrc;
 						if (vsLang == ShaderLanguage::GLSL) { // GLSL
+							m_queueLazySPIRV(item, ShaderStage::Vertex, shader->VSPath, vssrc, shader->VSEntry, shader->Macros);
 							m_includeCheck(vsContent, std::vector<std::string>(), lineBias);
 							m_applyMacros(vsContent, shader);
 						} else { // HLSL / VK
@@ -1341,14 +1599,10 @@ namespace ed {
 					if (gssrc.size() > 0) {
 						lineBias = 0;
 
-						ShaderLanguage gsLang = ShaderCompiler::GetShaderLanguageFromExtension(shader->GSPath);
-						if (gsLang == ShaderLanguage::Plugin)
-							gsCompiled = m_pluginCompileToSpirv(shader->GSSPV, shader->GSPath, shader->GSEntry, plugin::ShaderStage::Geometry, shader->Macros.data(), shader->Macros.size(), gssrc);
-						else
-							gsCompiled = ShaderCompiler::CompileSourceToSPIRV(shader->GSSPV, gsLang, shader->GSPath, gssrc, ShaderStage::Geometry, shader->GSEntry, shader->Macros, m_msgs, m_project);
-
 						std::string gsContent = gssrc;
 						if (gsLang == ShaderLanguage::GLSL) { // GLSL
+							if (shader->GSUsed)
+								m_queueLazySPIRV(item, ShaderStage::Geometry, shader->GSPath, gssrc, shader->GSEntry, shader->Macros);
 							m_includeCheck(gsContent, std::vector<std::string>(), lineBias);
 							m_applyMacros(gsContent, shader);
 						} else { // HLSL / VK
@@ -1373,6 +1627,8 @@ namespace ed {
 						glDeleteProgram(m_shaders[i]);
 
 					if (!vsCompiled || !psCompiled || !gsCompiled) {
+						m_finishLazySPIRV(item, true); // glslang's error messages
+
 						m_msgs->Add(MessageStack::Type::Error, name, "Failed to compile the shader(s)");
 						m_shaders[i] = 0;
 					} else {
@@ -1383,6 +1639,8 @@ namespace ed {
 						glAttachShader(m_shaders[i], m_shaderSources[i].PS);
 						if (shader->GSUsed) glAttachShader(m_shaders[i], m_shaderSources[i].GS);
 						glLinkProgram(m_shaders[i]);
+
+						m_logBackendTime(name, false, backendTimer.GetElapsedTime());
 					}
 
 					if (m_shaders[i] != 0)
@@ -1392,6 +1650,8 @@ namespace ed {
 					m_msgs->ClearGroup(name);
 
 					SPIRVQueue.push_back(item);
+					m_hashSources(item);
+					m_resetSpecialized(item, shader->Macros);
 
 					bool compiled = false;
 					GLuint cs = 0;
@@ -1403,11 +1663,14 @@ namespace ed {
 						ShaderLanguage lang = ShaderCompiler::GetShaderLanguageFromExtension(shader->Path);
 						if (lang == ShaderLanguage::Plugin)
 							compiled = m_pluginCompileToSpirv(shader->SPV, shader->Path, shader->Entry, plugin::ShaderStage::Compute, shader->Macros.data(), shader->Macros.size(), vssrc);
-						else
+						else if (lang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
 							compiled = ShaderCompiler::CompileSourceToSPIRV(shader->SPV, lang, shader->Path, vssrc, ShaderStage::Compute, shader->Entry, shader->Macros, m_msgs, m_project);
+						else
+							compiled = true;
 
 						std::string content = vssrc;
 						if (lang == ShaderLanguage::GLSL) { // GLSL
+							m_queueLazySPIRV(item, ShaderStage::Compute, shader->Path, vssrc, shader->Entry, shader->Macros);
 							m_includeCheck(content, std::vector<std::string>(), lineBias);
 							m_applyMacros(content, shader);
 						} else { // HLSL / VK
@@ -1426,6 +1689,8 @@ namespace ed {
 						glDeleteProgram(m_shaders[i]);
 
 					if (!compiled) {
+						m_finishLazySPIRV(item, true); // glslang's error messages
+
 						m_msgs->Add(MessageStack::Type::Error, name, "Failed to compile the compute shader");
 						m_shaders[i] = 0;
 					} else {
@@ -1457,6 +1722,241 @@ namespace ed {
 
 		Render();
 	}
+	void RenderEngine::RecompileFromSourceAsync(const char* name, const std::string& vssrc, const std::string& pssrc, const std::string& gssrc)
+	{
+		PipelineItem* item = nullptr;
+		for (int i = 0; i < m_items.size(); i++)
+			if (strcmp(m_items[i]->Name, name) == 0) {
+				item = m_items[i];
+				break;
+			}
+		if (item == nullptr)
+			return;
+
+		std::shared_ptr<AsyncCompile> job = std::make_shared<AsyncCompile>();
+		job->Name = name;
+		job->IncludePaths = m_project->GetIncludePaths();
+		job->GSUsed = false;
+
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* shader = (pipe::ShaderPass*)item->Data;
+
+			const char* paths[3] = { shader->VSPath, shader->PSPath, shader->GSPath };
+			const char* entries[3] = { shader->VSEntry, shader->PSEntry, shader->GSEntry };
+			const std::string* sources[3] = { &vssrc, &pssrc, &gssrc };
+			ShaderStage types[3] = { ShaderStage::Vertex, ShaderStage::Pixel, ShaderStage::Geometry };
+
+			for (int s = 0; s < 3; s++) {
+				AsyncCompile::Stage& stage = job->Stages[s];
+				stage.Type = types[s];
+				stage.Path = paths[s];
+				stage.Entry = entries[s];
+				stage.Source = *sources[s];
+				stage.Language = ShaderCompiler::GetShaderLanguageFromExtension(stage.Path);
+			}
+
+			job->Macros = shader->Macros;
+			job->GSUsed = shader->GSUsed;
+		} else if (item->Type == PipelineItem::ItemType::ComputePass && m_computeSupported) {
+			pipe::ComputePass* shader = (pipe::ComputePass*)item->Data;
+
+			AsyncCompile::Stage& stage = job->Stages[0];
+			stage.Type = ShaderStage::Compute;
+			stage.Path = shader->Path;
+			stage.Entry = shader->Entry;
+			stage.Source = vssrc;
+			stage.Language = ShaderCompiler::GetShaderLanguageFromExtension(stage.Path);
+
+			job->Macros = shader->Macros;
+		} else {
+			RecompileFromSource(name, vssrc, pssrc, gssrc); // audio passes
+			return;
+		}
+
+		// plugin languages can't be used from other threads
+		for (int s = 0; s < 3; s++)
+			if (!job->Stages[s].Source.empty() && job->Stages[s].Language == ShaderLanguage::Plugin) {
+				RecompileFromSource(name, vssrc, pssrc, gssrc);
+				return;
+			}
+
+		// newer text supersedes the jobs that are still running
+		std::shared_ptr<AsyncCompileQueue> queue = m_asyncCompile;
+		{
+			std::unique_lock<std::mutex> lock(queue->Mutex);
+			job->Generation = ++queue->Counter;
+			queue->Latest[job->Name] = job->Generation;
+		}
+
+		ThreadPool::Instance().Submit([queue, job]() {
+			auto isCurrent = [&]() -> bool {
+				std::unique_lock<std::mutex> lock(queue->Mutex);
+				auto it = queue->Latest.find(job->Name);
+				return it != queue->Latest.end() && it->second == job->Generation;
+			};
+
+			MessageStack msgs;
+			msgs.CurrentItem = job->Name;
+
+			for (int s = 0; s < 3; s++) {
+				AsyncCompile::Stage& stage = job->Stages[s];
+				if (stage.Source.empty())
+					continue;
+
+				if (!isCurrent())
+					return;
+
+				// GLSL goes to the driver as is, its SPIR-V is generated after the swap
+				if (stage.Language == ShaderLanguage::GLSL) {
+					stage.Compiled = true;
+					continue;
+				}
+
+				stage.Compiled = ShaderCompiler::CompileSourceToSPIRV(stage.SPV, stage.Language, stage.Path, stage.Source, stage.Type, stage.Entry, job->Macros, &msgs, nullptr, false, &job->IncludePaths);
+				if (stage.Language != ShaderLanguage::GLSL)
+					stage.GLSL = ShaderCompiler::ConvertToGLSL(stage.SPV, stage.Language, stage.Type, job->GSUsed, &msgs);
+			}
+
+			job->Messages = msgs.GetMessages();
+
+			if (isCurrent()) {
+				std::unique_lock<std::mutex> lock(queue->Mutex);
+				queue->Finished.push_back(job);
+			}
+		});
+	}
+	void RenderEngine::UpdateSpecializationConstants(const char* name)
+	{
+		int index = -1;
+		for (int i = 0; i < m_items.size(); i++)
+			if (strcmp(m_items[i]->Name, name) == 0) {
+				index = i;
+				break;
+			}
+		if (index == -1)
+			return;
+
+		PipelineItem* item = m_items[index];
+		std::vector<ShaderMacro>* macros = nullptr;
+		std::vector<std::string> paths;
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+			macros = &pass->Macros;
+			paths = { pass->VSPath, pass->PSPath };
+			if (pass->GSUsed && strlen(pass->GSPath) > 0)
+				paths.push_back(pass->GSPath);
+		} else if (item->Type == PipelineItem::ItemType::ComputePass && m_computeSupported) {
+			pipe::ComputePass* pass = (pipe::ComputePass*)item->Data;
+			macros = &pass->Macros;
+			paths = { pass->Path };
+		}
+
+		// plugin languages get the macros as #defines
+		bool canSpecialize = macros != nullptr && m_shaders[index] != 0;
+		for (const auto& path : paths)
+			canSpecialize &= ShaderCompiler::GetShaderLanguageFromExtension(path) != ShaderLanguage::Plugin;
+
+		auto specIt = m_specialized.find(item);
+		if (!canSpecialize || specIt == m_specialized.end() || specIt->second.Signature != getMacroSignature(*macros)) {
+			Recompile(name);
+			return;
+		}
+
+		SpecializedPrograms& spec = specIt->second;
+		std::string key = getSpecializationKey(*macros);
+		if (key == spec.Current)
+			return;
+
+		m_cancelAsyncCompile(name);
+		m_cancelLazySPIRV(item);
+		m_activePermutation.erase(item);
+
+		m_msgs->BuildOccured = true;
+		m_msgs->CurrentItem = name;
+		m_msgs->ClearGroup(name);
+
+		m_plugins->HandleApplicationEvent(plugin::ApplicationEvent::PipelineItemCompiled, (void*)name, nullptr);
+
+		// keep the active program around for when the values are switched back
+		while (spec.Variants.size() >= MaxProgramVariants)
+			m_evictProgramVariant(spec);
+
+		ProgramVariant active;
+		active.Program = m_shaders[index];
+		active.Pack = m_shaderSources[index];
+		if (item->Type == PipelineItem::ItemType::ShaderPass)
+			active.Samplers = ((pipe::ShaderPass*)item->Data)->Variables.GetSamplerList();
+		active.LastUse = ++spec.Clock;
+		spec.Variants[spec.Current] = active;
+		spec.Current = key;
+
+		m_shaders[index] = 0;
+		m_shaderSources[index] = ShaderPack();
+
+		// stored SPIR-V has to match the new values (debugger, reflection, SPIR-V -> GLSL)
+		std::vector<std::vector<unsigned int>*> spv;
+		std::vector<std::string> entries;
+		ShaderStage types[3] = { ShaderStage::Vertex, ShaderStage::Pixel, ShaderStage::Geometry };
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+			spv = { &pass->VSSPV, &pass->PSSPV, &pass->GSSPV };
+			entries = { pass->VSEntry, pass->PSEntry, pass->GSEntry };
+		} else {
+			pipe::ComputePass* pass = (pipe::ComputePass*)item->Data;
+			spv = { &pass->SPV };
+			entries = { pass->Entry };
+			types[0] = ShaderStage::Compute;
+		}
+		for (int s = 0; s < paths.size(); s++) {
+			if (ShaderCompiler::GetShaderLanguageFromExtension(paths[s]) == ShaderLanguage::GLSL)
+				m_queueLazySPIRV(item, types[s], paths[s], m_project->LoadProjectFile(paths[s]), entries[s], *macros);
+			else
+				SPIRVSpecialization::Apply(*spv[s], *macros);
+		}
+
+		auto variant = spec.Variants.find(key);
+		if (variant != spec.Variants.end()) {
+			m_shaders[index] = variant->second.Program;
+			m_shaderSources[index] = variant->second.Pack;
+
+			if (item->Type == PipelineItem::ItemType::ShaderPass) {
+				pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+				pass->Variables.SetTextureList(variant->second.Samplers);
+				pass->Variables.SetUniformLocations(m_shaderSources[index].Locations);
+			}
+			spec.Variants.erase(variant);
+
+			Logger::Get().Log("Switched " + std::string(name) + " to a cached program variant");
+		} else {
+			eng::Timer backendTimer;
+
+			if (item->Type == PipelineItem::ItemType::ShaderPass)
+				m_shaders[index] = m_buildSpecializedPass(index, (pipe::ShaderPass*)item->Data);
+			else
+				m_shaders[index] = m_buildSpecializedCompute(index, (pipe::ComputePass*)item->Data);
+
+			if (m_shaders[index] != 0)
+				m_logBackendTime(name, m_shaderSources[index].SPIRV, backendTimer.GetElapsedTime());
+		}
+
+		if (m_shaders[index] != 0) {
+			if (item->Type == PipelineItem::ItemType::ShaderPass)
+				((pipe::ShaderPass*)item->Data)->Variables.UpdateUniformInfo(m_shaders[index]);
+			else
+				((pipe::ComputePass*)item->Data)->Variables.UpdateUniformInfo(m_shaders[index]);
+
+			m_msgs->Add(MessageStack::Type::Message, name, "Updated the specialization constants.");
+		} else {
+			m_finishLazySPIRV(item, true); // glslang's error messages
+			m_msgs->Add(MessageStack::Type::Error, name, "Failed to compile the specialized shader(s)");
+		}
+
+		SPIRVQueue.push_back(item);
+
+		// the preview isn't updated every frame while paused
+		if (m_paused)
+			Render();
+	}
 	void RenderEngine::Pick(float sx, float sy, bool multiPick, std::function<void(PipelineItem*)> func)
 	{
 		m_pickAwaiting = true;
@@ -1695,52 +2195,1653 @@ namespace ed {
 
 		return std::make_pair(nullptr, nullptr);
 	}
-	void RenderEngine::FlushCache()
+	void RenderEngine::m_bindStorage(int slot, GLuint id)
 	{
-		for (int i = 0; i < m_shaders.size(); i++) {
-			glDeleteShader(m_shaderSources[i].VS);
-			glDeleteShader(m_shaderSources[i].PS);
-			glDeleteShader(m_shaderSources[i].GS);
-			glDeleteProgram(m_shaders[i]);
+		if (m_objects->IsImage(id)) {
+			ImageObject* iobj = m_objects->GetImage(m_objects->GetImageNameByID(id)); // TODO: GetImageByID
+			glBindImageTexture(slot, id, 0, GL_FALSE, 0, GL_WRITE_ONLY | GL_READ_ONLY, iobj->Format);
+		} else if (m_objects->IsImage3D(id)) {
+			Image3DObject* iobj = m_objects->GetImage3D(m_objects->GetImage3DNameByID(id));
+			glBindImageTexture(slot, id, 0, GL_TRUE, 0, GL_WRITE_ONLY | GL_READ_ONLY, iobj->Format);
+		} else if (m_objects->IsPluginObject(id)) {
+			PluginObject* pobj = m_objects->GetPluginObject(id);
+			pobj->Owner->Object_Bind(pobj->Type, pobj->Data, pobj->ID);
+		} else
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot, id);
+	}
+	void RenderEngine::m_syncPass(PipelineItem* item)
+	{
+		if (m_barrierBuffers.empty() && m_barrierTextures.empty())
+			return;
+
+		GLbitfield bits = 0;
+		auto require = [&](std::unordered_map<GLuint, GLbitfield>& written, GLuint id, GLbitfield access) {
+			auto obj = written.find(id);
+			if (obj != written.end() && (obj->second & access) == 0)
+				bits |= access;
+		};
+		auto requireBuffer = [&](void* buffer, GLbitfield access) {
+			if (buffer != nullptr)
+				require(m_barrierBuffers, ((BufferObject*)buffer)->ID, access);
+		};
+
+		// plugins can read the objects in any way
+		if (item->Type == PipelineItem::ItemType::PluginItem)
+			bits = GL_ALL_BARRIER_BITS;
+		else {
+			for (GLuint id : m_objects->GetBindList(item)) {
+				if (m_objects->IsPluginObject(id))
+					bits = GL_ALL_BARRIER_BITS;
+				else
+					require(m_barrierTextures, id, GL_TEXTURE_FETCH_BARRIER_BIT);
+			}
+			for (GLuint id : m_objects->GetUniformBindList(item)) {
+				if (m_objects->IsImage(id) || m_objects->IsImage3D(id))
+					require(m_barrierTextures, id, GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+				else if (m_objects->IsPluginObject(id))
+					bits = GL_ALL_BARRIER_BITS;
+				else
+					require(m_barrierBuffers, id, GL_SHADER_STORAGE_BARRIER_BIT);
+			}
 		}
 
-		m_fbos.clear();
-		m_fboCount.clear();
-		m_items.clear();
-		m_shaders.clear();
-		m_shaderSources.clear();
-		m_uboMax.clear();
-		m_fbosNeedUpdate = true;
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+			for (PipelineItem* child : pass->Items) {
+				if (child->Type == PipelineItem::ItemType::Geometry)
+					requireBuffer(((pipe::GeometryItem*)child->Data)->InstanceBuffer, GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+				else if (child->Type == PipelineItem::ItemType::Model)
+					requireBuffer(((pipe::Model*)child->Data)->InstanceBuffer, GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+				else if (child->Type == PipelineItem::ItemType::VertexBuffer)
+					requireBuffer(((pipe::VertexBuffer*)child->Data)->Buffer, GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+				else if (child->Type == PipelineItem::ItemType::PluginItem)
+					bits = GL_ALL_BARRIER_BITS;
+			}
+		} else if (item->Type == PipelineItem::ItemType::ComputePass)
+			requireBuffer(((pipe::ComputePass*)item->Data)->IndirectBuffer, GL_COMMAND_BARRIER_BIT);
 
-		// clear textures
-		glBindTexture(GL_TEXTURE_2D, m_rtColor);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_lastSize.x, m_lastSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-		glBindTexture(GL_TEXTURE_2D, m_rtDepth);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, m_lastSize.x, m_lastSize.y, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		if (bits != 0)
+			m_issueBarrier(bits);
+	}
+	void RenderEngine::m_markWritten(const std::vector<GLuint>& storage)
+	{
+		// every bound buffer & image counts as written
+		for (GLuint id : storage) {
+			if (m_objects->IsImage(id) || m_objects->IsImage3D(id))
+				m_barrierTextures[id] = 0;
+			else if (id != 0 && !m_objects->IsPluginObject(id))
+				m_barrierBuffers[id] = 0;
+		}
+	}
+	void RenderEngine::m_issueBarrier(GLbitfield bits)
+	{
+		glMemoryBarrier(bits);
 
-		m_lastSize = glm::ivec2(1, 1); // recreate window rt!
+		// a barrier covers all the writes that were issued before it
+		if (bits == GL_ALL_BARRIER_BITS) {
+			m_barrierBuffers.clear();
+			m_barrierTextures.clear();
+			return;
+		}
+		for (auto& obj : m_barrierBuffers)
+			obj.second |= bits;
+		for (auto& obj : m_barrierTextures)
+			obj.second |= bits;
 	}
-	void RenderEngine::m_cache()
+	void RenderEngine::m_cullPasses()
 	{
-		// check for any changes
-		std::vector<ed::PipelineItem*>& items = m_pipeline->GetList();
+		m_culled.clear();
+		if (!Settings::Instance().Preview.CullPasses)
+			return;
 
-		// check if no major changes were made, if so dont cache for another 0.25s
-		if (m_items.size() == items.size()) {
-			if (m_cacheTimer.GetElapsedTime() > 0.5f)
-				m_cacheTimer.Restart();
-			else
+		struct Pass {
+			PipelineItem* Item;
+			bool Live;
+			std::vector<GLuint> ReadTextures, ReadBuffers, WriteTextures, WriteBuffers;
+		};
+		std::vector<Pass> passes;
+		for (PipelineItem* item : m_items) {
+			// plugins can access any object through the API
+			if (item->Type == PipelineItem::ItemType::PluginItem)
 				return;
-		}
 
-		// check if some item was added
-		for (int i = 0; i < items.size(); i++) {
-			bool found = false;
-			for (int j = 0; j < m_items.size(); j++)
-				if (items[i]->Data == m_items[j]->Data) {
-					found = true;
-					break;
+			bool active = item->Type == PipelineItem::ItemType::AudioPass;
+			if (item->Type == PipelineItem::ItemType::ShaderPass)
+				active = ((pipe::ShaderPass*)item->Data)->Active;
+			else if (item->Type == PipelineItem::ItemType::ComputePass)
+				active = ((pipe::ComputePass*)item->Data)->Active;
+			if (!active)
+				continue;
+
+			Pass pass;
+			pass.Item = item;
+			pass.Live = item->Type == PipelineItem::ItemType::AudioPass || item == m_comparison.Item;
+
+			for (GLuint id : m_objects->GetBindList(item)) {
+				if (m_objects->IsPluginObject(id))
+					pass.Live = true;
+				else
+					pass.ReadTextures.push_back(id);
+			}
+
+			// storage can be both read and written
+			for (GLuint id : m_objects->GetUniformBindList(item)) {
+				if (m_objects->IsImage(id) || m_objects->IsImage3D(id)) {
+					pass.ReadTextures.push_back(id);
+					pass.WriteTextures.push_back(id);
+				} else if (m_objects->IsPluginObject(id))
+					pass.Live = true;
+				else {
+					pass.ReadBuffers.push_back(id);
+					pass.WriteBuffers.push_back(id);
+				}
+			}
+
+			if (item->Type == PipelineItem::ItemType::ShaderPass) {
+				pipe::ShaderPass* data = (pipe::ShaderPass*)item->Data;
+				for (int i = 0; i < data->RTCount; i++)
+					pass.WriteTextures.push_back(data->RenderTextures[i]);
+				if (data->DepthTexture != 0)
+					pass.WriteTextures.push_back(data->DepthTexture);
+
+				for (PipelineItem* child : data->Items) {
+					void* buffer = nullptr;
+					if (child->Type == PipelineItem::ItemType::Geometry)
+						buffer = ((pipe::GeometryItem*)child->Data)->InstanceBuffer;
+					else if (child->Type == PipelineItem::ItemType::Model)
+						buffer = ((pipe::Model*)child->Data)->InstanceBuffer;
+					else if (child->Type == PipelineItem::ItemType::VertexBuffer)
+						buffer = ((pipe::VertexBuffer*)child->Data)->Buffer;
+					else if (child->Type == PipelineItem::ItemType::PluginItem)
+						return;
+
+					if (buffer != nullptr)
+						pass.ReadBuffers.push_back(((BufferObject*)buffer)->ID);
+				}
+			} else if (item->Type == PipelineItem::ItemType::ComputePass) {
+				pipe::ComputePass* data = (pipe::ComputePass*)item->Data;
+				if (data->IndirectBuffer != nullptr)
+					pass.ReadBuffers.push_back(((BufferObject*)data->IndirectBuffer)->ID);
+			}
+
+			passes.push_back(pass);
+		}
+
+		// objects that are shown in the preview or in an object preview window
+		std::set<GLuint> textures, buffers;
+		textures.insert(m_rtColor);
+		for (const std::string& name : m_observed) {
+			if (m_objects->IsBuffer(name))
+				buffers.insert(m_objects->GetBuffer(name)->ID);
+			else if (m_objects->IsImage(name))
+				textures.insert(m_objects->GetImage(name)->Texture);
+			else if (m_objects->IsImage3D(name))
+				textures.insert(m_objects->GetImage3D(name)->Texture);
+			else if (m_objects->Exists(name))
+				textures.insert(m_objects->GetTexture(name));
+		}
+
+		// a pass is live if something live reads one of its outputs - previous frame's results included
+		auto markRead = [&](const Pass& pass) {
+			textures.insert(pass.ReadTextures.begin(), pass.ReadTextures.end());
+			buffers.insert(pass.ReadBuffers.begin(), pass.ReadBuffers.end());
+		};
+		for (const Pass& pass : passes)
+			if (pass.Live)
+				markRead(pass);
+
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			for (Pass& pass : passes) {
+				if (pass.Live)
+					continue;
+
+				for (GLuint id : pass.WriteTextures)
+					pass.Live |= textures.count(id) > 0;
+				for (GLuint id : pass.WriteBuffers)
+					pass.Live |= buffers.count(id) > 0;
+
+				if (pass.Live) {
+					markRead(pass);
+					changed = true;
+				}
+			}
+		}
+
+		for (const Pass& pass : passes)
+			if (!pass.Live)
+				m_culled.insert(pass.Item);
+	}
+	void RenderEngine::FlushCache()
+	{
+		m_cancelLazySPIRV();
+		m_deleteSpecialized();
+		m_deletePermutations();
+		m_deleteGPUTimers();
+		StopComparison();
+
+		for (int i = 0; i < m_shaders.size(); i++) {
+			glDeleteShader(m_shaderSources[i].VS);
+			glDeleteShader(m_shaderSources[i].PS);
+			glDeleteShader(m_shaderSources[i].GS);
+			glDeleteProgram(m_shaders[i]);
+		}
+
+		m_fbos.clear();
+		m_fboCount.clear();
+		m_items.clear();
+		m_shaders.clear();
+		m_shaderSources.clear();
+		m_uboMax.clear();
+		m_barrierBuffers.clear();
+		m_barrierTextures.clear();
+		m_barrierMismatch.clear();
+		m_culled.clear();
+		m_fbosNeedUpdate = true;
+
+		// clear textures
+		glBindTexture(GL_TEXTURE_2D, m_rtColor);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_lastSize.x, m_lastSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glBindTexture(GL_TEXTURE_2D, m_rtDepth);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, m_lastSize.x, m_lastSize.y, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		m_lastSize = glm::ivec2(1, 1); // recreate window rt!
+	}
+	void RenderEngine::m_cancelAsyncCompile(const std::string& name)
+	{
+		std::unique_lock<std::mutex> lock(m_asyncCompile->Mutex);
+		m_asyncCompile->Latest.erase(name);
+	}
+	void RenderEngine::m_queueLazySPIRV(PipelineItem* item, ShaderStage stage, const std::string& path, const std::string& source, const std::string& entry, const std::vector<ShaderMacro>& macros)
+	{
+		std::shared_ptr<LazySPIRV> job = std::make_shared<LazySPIRV>();
+		job->Item = item;
+		job->Type = stage;
+		job->Name = item->Name;
+		job->Path = path;
+		job->Entry = entry;
+		job->Source = source;
+		job->Macros = macros;
+		job->IncludePaths = m_project->GetIncludePaths();
+
+		// newer source supersedes the jobs that are still running
+		std::shared_ptr<LazySPIRVQueue> queue = m_lazySPIRV;
+		{
+			std::unique_lock<std::mutex> lock(queue->Mutex);
+			queue->Pending[std::make_pair(item, stage)] = job;
+		}
+
+		ThreadPool::Instance().Submit([queue, job]() {
+			{
+				std::unique_lock<std::mutex> lock(queue->Mutex);
+				auto it = queue->Pending.find(std::make_pair(job->Item, job->Type));
+				if (it == queue->Pending.end() || it->second != job)
+					return;
+			}
+
+			MessageStack msgs;
+			msgs.CurrentItem = job->Name;
+
+			job->Compiled = ShaderCompiler::CompileSourceToSPIRV(job->SPV, ShaderLanguage::GLSL, job->Path, job->Source, job->Type, job->Entry, job->Macros, &msgs, nullptr, false, &job->IncludePaths);
+			job->Messages = msgs.GetMessages();
+
+			std::unique_lock<std::mutex> lock(queue->Mutex);
+			job->Done = true;
+			queue->Finished.notify_all();
+		});
+	}
+	void RenderEngine::m_cancelLazySPIRV(PipelineItem* item)
+	{
+		std::unique_lock<std::mutex> lock(m_lazySPIRV->Mutex);
+		if (item == nullptr) {
+			m_lazySPIRV->Pending.clear();
+			return;
+		}
+
+		for (auto it = m_lazySPIRV->Pending.begin(); it != m_lazySPIRV->Pending.end();) {
+			if (it->first.first == item)
+				it = m_lazySPIRV->Pending.erase(it);
+			else
+				++it;
+		}
+	}
+	void RenderEngine::m_finishLazySPIRV(PipelineItem* item, bool wait)
+	{
+		std::vector<std::shared_ptr<LazySPIRV>> finished;
+		{
+			std::unique_lock<std::mutex> lock(m_lazySPIRV->Mutex);
+			if (m_lazySPIRV->Pending.empty())
+				return;
+
+			if (wait) {
+				m_lazySPIRV->Finished.wait(lock, [&]() {
+					for (const auto& job : m_lazySPIRV->Pending)
+						if (job.first.first == item && !job.second->Done)
+							return false;
+					return true;
+				});
+			}
+
+			for (auto it = m_lazySPIRV->Pending.begin(); it != m_lazySPIRV->Pending.end();) {
+				if (it->second->Done) {
+					finished.push_back(it->second);
+					it = m_lazySPIRV->Pending.erase(it);
+				} else
+					++it;
+			}
+		}
+
+		std::vector<PipelineItem*>& items = m_pipeline->GetList();
+		for (const auto& job : finished) {
+			if (std::count(items.begin(), items.end(), job->Item) == 0)
+				continue; // item was deleted
+
+			m_msgs->Add(job->Messages);
+
+			// failed SPIR-V is only kept for its error messages
+			if (!job->Compiled)
+				continue;
+
+			std::vector<unsigned int>* spv = nullptr;
+			if (job->Item->Type == PipelineItem::ItemType::ShaderPass) {
+				pipe::ShaderPass* pass = (pipe::ShaderPass*)job->Item->Data;
+				if (job->Type == ShaderStage::Vertex)
+					spv = &pass->VSSPV;
+				else if (job->Type == ShaderStage::Pixel)
+					spv = &pass->PSSPV;
+				else if (job->Type == ShaderStage::Geometry)
+					spv = &pass->GSSPV;
+			} else if (job->Item->Type == PipelineItem::ItemType::ComputePass)
+				spv = &((pipe::ComputePass*)job->Item->Data)->SPV;
+
+			if (spv == nullptr)
+				continue;
+
+			*spv = std::move(job->SPV);
+			SPIRVQueue.push_back(job->Item);
+		}
+	}
+	void RenderEngine::RequireSPIRV(PipelineItem* item)
+	{
+		m_finishLazySPIRV(item, true);
+	}
+	bool RenderEngine::IsSPIRVPending(PipelineItem* item)
+	{
+		std::unique_lock<std::mutex> lock(m_lazySPIRV->Mutex);
+		for (const auto& job : m_lazySPIRV->Pending)
+			if (job.first.first == item)
+				return true;
+		return false;
+	}
+	std::vector<MacroPermutation>* RenderEngine::m_getPermutations(PipelineItem* item)
+	{
+		if (item->Type == PipelineItem::ItemType::ShaderPass)
+			return &((pipe::ShaderPass*)item->Data)->Permutations;
+		else if (item->Type == PipelineItem::ItemType::ComputePass && m_computeSupported)
+			return &((pipe::ComputePass*)item->Data)->Permutations;
+		return nullptr;
+	}
+	std::string RenderEngine::m_permutationKey(PipelineItem* item, const std::vector<ShaderMacro>& macros)
+	{
+		// old programs are never hit after the files were modified
+		auto sources = m_sourceHash.find(item);
+		if (sources == m_sourceHash.end()) {
+			m_hashSources(item);
+			sources = m_sourceHash.find(item);
+		}
+
+		std::string ret = std::to_string((uintptr_t)item) + sources->second;
+		for (const auto& macro : macros)
+			ret += "|" + std::string(macro.Specialize ? "$" : "") + std::string(macro.Active ? "" : "!") + macro.Name + "=" + macro.Value;
+		if (Settings::Instance().Project.OptimizeSPIRV)
+			ret += "|opt";
+
+		return ret;
+	}
+	void RenderEngine::m_hashSources(PipelineItem* item)
+	{
+		std::vector<std::string> stages; // path, entry pairs
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+			stages = { pass->VSPath, pass->VSEntry, pass->PSPath, pass->PSEntry };
+			if (pass->GSUsed) {
+				stages.push_back(pass->GSPath);
+				stages.push_back(pass->GSEntry);
+			}
+		} else if (item->Type == PipelineItem::ItemType::ComputePass) {
+			pipe::ComputePass* pass = (pipe::ComputePass*)item->Data;
+			stages = { pass->Path, pass->Entry };
+		}
+
+		std::string ret = "";
+		for (int i = 0; i + 1 < stages.size(); i += 2) {
+			size_t hash = 0;
+			std::vector<std::string> visited;
+			m_hashFile(stages[i], hash, visited);
+			ret += "|" + stages[i] + ":" + stages[i + 1] + ":" + std::to_string(hash);
+		}
+		m_sourceHash[item] = ret;
+	}
+	void RenderEngine::m_hashFile(const std::string& path, size_t& hash, std::vector<std::string>& visited)
+	{
+		if (std::count(visited.begin(), visited.end(), path) > 0)
+			return;
+		visited.push_back(path);
+
+		std::string src = m_project->LoadProjectFile(path);
+		hash ^= std::hash<std::string>()(src) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+		// #included files are looked up the same way as in m_includeCheck and in the glslang includer
+		std::vector<std::string> dirs = Settings::Instance().Project.IncludePaths;
+		dirs.push_back(".");
+		size_t slash = path.find_last_of("/\\");
+		if (slash != std::string::npos)
+			dirs.push_back(path.substr(0, slash));
+
+		size_t incLoc = src.find("#include");
+		while (incLoc != std::string::npos) {
+			size_t lineEnd = src.find('\n', incLoc);
+			size_t quotePos = src.find_first_of("\"<", incLoc);
+			size_t quoteEnd = quotePos == std::string::npos ? std::string::npos : src.find_first_of("\">", quotePos + 1);
+
+			if (quoteEnd != std::string::npos && quoteEnd < lineEnd) {
+				std::string fileName = src.substr(quotePos + 1, quoteEnd - quotePos - 1);
+				for (const auto& dir : dirs) {
+					std::string ipath = dir;
+					if (!ipath.empty() && ipath.back() != '/' && ipath.back() != '\\')
+						ipath += "/";
+					ipath += fileName;
+
+					if (m_project->FileExists(ipath)) {
+						m_hashFile(ipath, hash, visited);
+						break;
+					}
+				}
+			}
+
+			incLoc = src.find("#include", incLoc + 1);
+		}
+	}
+	void RenderEngine::WarmPermutations(PipelineItem* item)
+	{
+		std::vector<MacroPermutation>* perms = m_getPermutations(item);
+		if (perms == nullptr)
+			return;
+
+		std::vector<std::string> keys;
+		for (const auto& perm : *perms)
+			keys.push_back(m_permutationKey(item, perm.Macros));
+
+		// programs of removed permutations and of older file versions
+		for (auto it = m_permutations.begin(); it != m_permutations.end();) {
+			if (it->second.Item == item && std::count(keys.begin(), keys.end(), it->first) == 0) {
+				m_deleteProgramVariant(it->second.Variant);
+				it = m_permutations.erase(it);
+			} else
+				++it;
+		}
+
+		std::shared_ptr<PermutationQueue> queue = m_permutationQueue;
+		std::vector<std::string> includePaths = m_project->GetIncludePaths();
+		for (int p = 0; p < perms->size(); p++) {
+			const std::string& key = keys[p];
+			if (m_permutationState(item, key) != PermutationState::None)
+				continue;
+
+			std::shared_ptr<AsyncCompile> job = std::make_shared<AsyncCompile>();
+			job->Name = item->Name;
+			job->IncludePaths = includePaths;
+			job->Macros = (*perms)[p].Macros;
+			job->GSUsed = false;
+			job->Generation = 0;
+
+			if (item->Type == PipelineItem::ItemType::ShaderPass) {
+				pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+				const char* paths[3] = { pass->VSPath, pass->PSPath, pass->GSPath };
+				const char* entries[3] = { pass->VSEntry, pass->PSEntry, pass->GSEntry };
+				ShaderStage types[3] = { ShaderStage::Vertex, ShaderStage::Pixel, ShaderStage::Geometry };
+				int stageCount = (pass->GSUsed && strlen(pass->GSPath) > 0 && strlen(pass->GSEntry) > 0) ? 3 : 2;
+
+				for (int s = 0; s < stageCount; s++) {
+					AsyncCompile::Stage& stage = job->Stages[s];
+					stage.Type = types[s];
+					stage.Path = paths[s];
+					stage.Entry = entries[s];
+					stage.Source = m_project->LoadProjectFile(paths[s]);
+					stage.Language = ShaderCompiler::GetShaderLanguageFromExtension(stage.Path);
+				}
+				job->GSUsed = pass->GSUsed;
+			} else {
+				pipe::ComputePass* pass = (pipe::ComputePass*)item->Data;
+				AsyncCompile::Stage& stage = job->Stages[0];
+				stage.Type = ShaderStage::Compute;
+				stage.Path = pass->Path;
+				stage.Entry = pass->Entry;
+				stage.Source = m_project->LoadProjectFile(pass->Path);
+				stage.Language = ShaderCompiler::GetShaderLanguageFromExtension(stage.Path);
+			}
+
+			// plugin languages can't be used from other threads
+			bool canCompile = true;
+			for (int s = 0; s < 3; s++)
+				if (!job->Stages[s].Source.empty() && job->Stages[s].Language == ShaderLanguage::Plugin)
+					canCompile = false;
+			if (!canCompile || job->Stages[0].Source.empty())
+				continue;
+
+			{
+				std::unique_lock<std::mutex> lock(queue->Mutex);
+				queue->Pending.insert(key);
+			}
+
+			ThreadPool::Instance().SubmitIdle([queue, job, key]() {
+				auto isPending = [&]() -> bool {
+					std::unique_lock<std::mutex> lock(queue->Mutex);
+					return queue->Pending.count(key) > 0;
+				};
+
+				MessageStack msgs;
+				msgs.CurrentItem = job->Name;
+
+				for (int s = 0; s < 3; s++) {
+					AsyncCompile::Stage& stage = job->Stages[s];
+					if (stage.Source.empty())
+						continue;
+
+					if (!isPending())
+						return;
+
+					// GLSL goes to the driver as is
+					if (stage.Language == ShaderLanguage::GLSL) {
+						stage.Compiled = true;
+						continue;
+					}
+
+					stage.Compiled = ShaderCompiler::CompileSourceToSPIRV(stage.SPV, stage.Language, stage.Path, stage.Source, stage.Type, stage.Entry, job->Macros, &msgs, nullptr, false, &job->IncludePaths);
+					stage.GLSL = ShaderCompiler::ConvertToGLSL(stage.SPV, stage.Language, stage.Type, job->GSUsed, &msgs);
+				}
+
+				job->Messages = msgs.GetMessages();
+
+				std::unique_lock<std::mutex> lock(queue->Mutex);
+				if (queue->Pending.count(key) > 0)
+					queue->Finished.push_back(std::make_pair(key, job));
+			});
+		}
+	}
+	bool RenderEngine::ApplyPermutation(PipelineItem* item, int index)
+	{
+		int itemIndex = -1;
+		for (int i = 0; i < m_items.size(); i++)
+			if (m_items[i] == item) {
+				itemIndex = i;
+				break;
+			}
+
+		std::vector<MacroPermutation>* perms = m_getPermutations(item);
+		if (itemIndex == -1 || perms == nullptr || index < 0 || index >= perms->size())
+			return false;
+
+		std::vector<ShaderMacro>& macros = item->Type == PipelineItem::ItemType::ShaderPass ? ((pipe::ShaderPass*)item->Data)->Macros : ((pipe::ComputePass*)item->Data)->Macros;
+		macros = (*perms)[index].Macros;
+
+		std::string key = m_permutationKey(item, macros);
+		if (m_permutationState(item, key) == PermutationState::Active && m_shaders[itemIndex] != 0)
+			return true;
+
+		auto cached = m_permutations.find(key);
+		if (cached == m_permutations.end()) {
+			Recompile(item->Name);
+			return false;
+		}
+
+		m_cancelAsyncCompile(item->Name);
+		m_cancelLazySPIRV(item);
+
+		std::vector<std::vector<unsigned int>*> spv;
+		std::vector<std::string> paths, entries;
+		std::vector<ShaderStage> types;
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+			spv = { &pass->VSSPV, &pass->PSSPV };
+			paths = { pass->VSPath, pass->PSPath };
+			entries = { pass->VSEntry, pass->PSEntry };
+			types = { ShaderStage::Vertex, ShaderStage::Pixel };
+			if (pass->GSUsed && strlen(pass->GSPath) > 0) {
+				spv.push_back(&pass->GSSPV);
+				paths.push_back(pass->GSPath);
+				entries.push_back(pass->GSEntry);
+				types.push_back(ShaderStage::Geometry);
+			}
+		} else {
+			pipe::ComputePass* pass = (pipe::ComputePass*)item->Data;
+			spv = { &pass->SPV };
+			paths = { pass->Path };
+			entries = { pass->Entry };
+			types = { ShaderStage::Compute };
+		}
+
+		// keep the active program if it can be used again
+		auto active = m_activePermutation.find(item);
+		if (active != m_activePermutation.end() && m_shaders[itemIndex] != 0 && m_permutations.count(active->second) == 0) {
+			CachedPermutation& old = m_permutations[active->second];
+			old.Item = item;
+			old.Variant.Program = m_shaders[itemIndex];
+			old.Variant.Pack = m_shaderSources[itemIndex];
+			if (item->Type == PipelineItem::ItemType::ShaderPass)
+				old.Variant.Samplers = ((pipe::ShaderPass*)item->Data)->Variables.GetSamplerList();
+			for (int s = 0; s < paths.size(); s++)
+				if (ShaderCompiler::GetShaderLanguageFromExtension(paths[s]) != ShaderLanguage::GLSL)
+					old.SPV[s] = *spv[s];
+			old.Memory = m_programMemory(old.Variant.Program, old.SPV, 3);
+			old.LastUse = ++m_permutationClock;
+		} else {
+			ProgramVariant current;
+			current.Program = m_shaders[itemIndex];
+			current.Pack = m_shaderSources[itemIndex];
+			m_deleteProgramVariant(current);
+		}
+
+		cached = m_permutations.find(key); // inserting might have invalidated the iterator
+		CachedPermutation& perm = cached->second;
+		m_shaders[itemIndex] = perm.Variant.Program;
+		m_shaderSources[itemIndex] = perm.Variant.Pack;
+
+		for (int s = 0; s < paths.size(); s++) {
+			if (ShaderCompiler::GetShaderLanguageFromExtension(paths[s]) == ShaderLanguage::GLSL)
+				m_queueLazySPIRV(item, types[s], paths[s], m_project->LoadProjectFile(paths[s]), entries[s], macros);
+			else
+				*spv[s] = std::move(perm.SPV[s]);
+		}
+
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+			pass->Variables.SetTextureList(perm.Variant.Samplers);
+			pass->Variables.SetUniformLocations(m_shaderSources[itemIndex].Locations);
+			pass->Variables.UpdateUniformInfo(m_shaders[itemIndex]);
+		} else
+			((pipe::ComputePass*)item->Data)->Variables.UpdateUniformInfo(m_shaders[itemIndex]);
+
+		m_permutations.erase(cached);
+
+		m_resetSpecialized(item, macros);
+		m_activePermutation[item] = key;
+
+		m_msgs->BuildOccured = true;
+		m_msgs->CurrentItem = item->Name;
+		m_msgs->ClearGroup(item->Name);
+		m_msgs->Add(MessageStack::Type::Message, item->Name, "Switched to the precompiled permutation \"" + std::string((*perms)[index].Name) + "\".");
+
+		m_plugins->HandleApplicationEvent(plugin::ApplicationEvent::PipelineItemCompiled, (void*)item->Name, nullptr);
+
+		SPIRVQueue.push_back(item);
+
+		m_evictPermutations();
+
+		// the preview isn't updated every frame while paused
+		if (m_paused)
+			Render();
+
+		return true;
+	}
+	RenderEngine::PermutationState RenderEngine::GetPermutationState(PipelineItem* item, int index)
+	{
+		std::vector<MacroPermutation>* perms = m_getPermutations(item);
+		if (perms == nullptr || index < 0 || index >= perms->size())
+			return PermutationState::None;
+
+		return m_permutationState(item, m_permutationKey(item, (*perms)[index].Macros));
+	}
+	RenderEngine::PermutationState RenderEngine::m_permutationState(PipelineItem* item, const std::string& key)
+	{
+		auto active = m_activePermutation.find(item);
+		if (active != m_activePermutation.end() && active->second == key)
+			return PermutationState::Active;
+		if (m_permutations.count(key))
+			return PermutationState::Cached;
+
+		std::unique_lock<std::mutex> lock(m_permutationQueue->Mutex);
+		if (m_permutationQueue->Pending.count(key))
+			return PermutationState::Compiling;
+
+		return PermutationState::None;
+	}
+	size_t RenderEngine::GetPermutationMemory()
+	{
+		size_t ret = 0;
+		for (const auto& perm : m_permutations)
+			ret += perm.second.Memory;
+		return ret;
+	}
+	void RenderEngine::m_finishPermutation()
+	{
+		std::pair<std::string, std::shared_ptr<AsyncCompile>> done;
+		{
+			std::unique_lock<std::mutex> lock(m_permutationQueue->Mutex);
+			if (m_permutationQueue->Finished.empty())
+				return;
+
+			done = m_permutationQueue->Finished.front();
+			m_permutationQueue->Finished.erase(m_permutationQueue->Finished.begin());
+			m_permutationQueue->Pending.erase(done.first);
+		}
+
+		PipelineItem* item = nullptr;
+		for (int i = 0; i < m_items.size(); i++)
+			if (done.second->Name == m_items[i]->Name) {
+				item = m_items[i];
+				break;
+			}
+
+		// item was deleted/renamed or the files were modified in the meantime
+		if (item == nullptr || m_permutationKey(item, done.second->Macros) != done.first)
+			return;
+
+		CachedPermutation perm;
+		perm.Item = item;
+		perm.Variant.Program = m_linkPermutation(item, *done.second, perm.Variant.Pack, perm.Variant.Samplers);
+		if (perm.Variant.Program == 0) {
+			Logger::Get().Log("Failed to precompile a macro permutation of " + std::string(item->Name), true);
+			return;
+		}
+
+		for (int s = 0; s < 3; s++)
+			if (!done.second->Stages[s].Source.empty() && done.second->Stages[s].Language != ShaderLanguage::GLSL)
+				perm.SPV[s] = std::move(done.second->Stages[s].SPV);
+		perm.Memory = m_programMemory(perm.Variant.Program, perm.SPV, 3);
+		perm.LastUse = ++m_permutationClock;
+
+		m_permutations[done.first] = perm;
+		m_evictPermutations();
+	}
+	GLuint RenderEngine::m_linkPermutation(PipelineItem* item, AsyncCompile& job, ShaderPack& pack, std::vector<std::string>& samplers)
+	{
+		bool isCompute = item->Type == PipelineItem::ItemType::ComputePass;
+		GLenum glTypes[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+		if (isCompute)
+			glTypes[0] = GL_COMPUTE_SHADER;
+
+		GLuint created[3] = { 0, 0, 0 };
+		bool compiled = true;
+		for (int s = 0; s < 3; s++) {
+			AsyncCompile::Stage& stage = job.Stages[s];
+			if (stage.Source.empty())
+				continue;
+
+			std::string content = stage.GLSL;
+			if (stage.Language == ShaderLanguage::GLSL) {
+				int lineBias = 0;
+				content = stage.Source;
+				m_includeCheck(content, std::vector<std::string>(), lineBias);
+				m_applyMacros(content, job.Macros);
+			}
+
+			if (s == 1) {
+				ShaderVariableContainer textures;
+				textures.UpdateTextureList(content);
+				samplers = textures.GetSamplerList();
+			}
+
+			created[s] = gl::CompileShader(glTypes[s], content.c_str());
+			compiled &= stage.Compiled && !content.empty() && gl::CheckShaderCompilationStatus(created[s]);
+		}
+
+		GLuint program = 0;
+		if (compiled) {
+			program = glCreateProgram();
+			for (int s = 0; s < 3; s++)
+				if (created[s] != 0)
+					glAttachShader(program, created[s]);
+			glLinkProgram(program);
+
+			if (!gl::CheckShaderLinkStatus(program, nullptr)) {
+				glDeleteProgram(program);
+				program = 0;
+			}
+		}
+
+		// compute programs don't keep their shader objects
+		if (program == 0 || isCompute) {
+			for (int s = 0; s < 3; s++)
+				glDeleteShader(created[s]);
+			return program;
+		}
+
+		pack.VS = created[0];
+		pack.PS = created[1];
+		pack.GS = created[2];
+
+		return program;
+	}
+	size_t RenderEngine::m_programMemory(GLuint program, const std::vector<unsigned int>* spv, int count)
+	{
+		GLint binaryLength = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+
+		size_t ret = binaryLength;
+		for (int i = 0; i < count; i++)
+			ret += spv[i].size() * sizeof(unsigned int);
+		return ret;
+	}
+	void RenderEngine::m_evictPermutations()
+	{
+		// least recently used programs go first
+		size_t memory = GetPermutationMemory();
+		while (!m_permutations.empty() && (m_permutations.size() > MaxCachedPermutations || memory > MaxPermutationMemory)) {
+			auto oldest = m_permutations.begin();
+			for (auto it = m_permutations.begin(); it != m_permutations.end(); it++)
+				if (it->second.LastUse < oldest->second.LastUse)
+					oldest = it;
+
+			memory -= oldest->second.Memory;
+			m_deleteProgramVariant(oldest->second.Variant);
+			m_permutations.erase(oldest);
+		}
+	}
+	void RenderEngine::m_deletePermutations(PipelineItem* item)
+	{
+		std::string prefix = item == nullptr ? "" : std::to_string((uintptr_t)item) + "|";
+		{
+			std::unique_lock<std::mutex> lock(m_permutationQueue->Mutex);
+			for (auto it = m_permutationQueue->Pending.begin(); it != m_permutationQueue->Pending.end();) {
+				if (it->compare(0, prefix.size(), prefix) == 0)
+					it = m_permutationQueue->Pending.erase(it);
+				else
+					++it;
+			}
+			for (auto it = m_permutationQueue->Finished.begin(); it != m_permutationQueue->Finished.end();) {
+				if (it->first.compare(0, prefix.size(), prefix) == 0)
+					it = m_permutationQueue->Finished.erase(it);
+				else
+					++it;
+			}
+		}
+
+		for (auto it = m_permutations.begin(); it != m_permutations.end();) {
+			if (item == nullptr || it->second.Item == item) {
+				m_deleteProgramVariant(it->second.Variant);
+				it = m_permutations.erase(it);
+			} else
+				++it;
+		}
+
+		if (item == nullptr) {
+			m_activePermutation.clear();
+			m_sourceHash.clear();
+		} else {
+			m_activePermutation.erase(item);
+			m_sourceHash.erase(item);
+		}
+	}
+	void RenderEngine::ResetGPUTimer(PipelineItem* item)
+	{
+		auto it = m_gpuTimers.find(item);
+		if (it == m_gpuTimers.end())
+			return;
+
+		for (int i = 0; i < GPUTimerLatency; i++)
+			it->second.Pending[i] = false;
+		it->second.Samples.clear();
+	}
+	float RenderEngine::GetGPUTime(PipelineItem* item)
+	{
+		auto it = m_gpuTimers.find(item);
+		if (it == m_gpuTimers.end() || it->second.Samples.empty())
+			return -1.0f;
+
+		float sum = 0.0f;
+		for (float sample : it->second.Samples)
+			sum += sample;
+		return sum / it->second.Samples.size();
+	}
+	int RenderEngine::GetGPUTimeSampleCount(PipelineItem* item)
+	{
+		auto it = m_gpuTimers.find(item);
+		if (it == m_gpuTimers.end())
+			return 0;
+		return it->second.Samples.size();
+	}
+	void RenderEngine::m_beginGPUTimer(PipelineItem* item)
+	{
+		auto it = m_gpuTimers.find(item);
+		if (it == m_gpuTimers.end()) {
+			GPUTimer& timer = m_gpuTimers[item];
+			glGenQueries(GPUTimerLatency, timer.Queries);
+			for (int i = 0; i < GPUTimerLatency; i++)
+				timer.Pending[i] = false;
+			it = m_gpuTimers.find(item);
+		}
+
+		m_beginGPUTimer(it->second, MaxGPUTimerSamples);
+	}
+	void RenderEngine::m_beginGPUTimer(GPUTimer& timer, size_t maxSamples)
+	{
+		int slot = m_gpuTimerFrame % GPUTimerLatency;
+
+		// this query was issued GPUTimerLatency frames ago, the result should already be there
+		if (timer.Pending[slot]) {
+			GLuint64 ns = 0;
+			glGetQueryObjectui64v(timer.Queries[slot], GL_QUERY_RESULT, &ns);
+			if (timer.Samples.size() >= maxSamples)
+				timer.Samples.erase(timer.Samples.begin());
+			timer.Samples.push_back(ns / 1000000.0f);
+		}
+
+		glBeginQuery(GL_TIME_ELAPSED, timer.Queries[slot]);
+		timer.Pending[slot] = true;
+	}
+	void RenderEngine::m_endGPUTimer()
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+	}
+	void RenderEngine::m_deleteGPUTimers(PipelineItem* item)
+	{
+		for (auto it = m_gpuTimers.begin(); it != m_gpuTimers.end();) {
+			if (item == nullptr || it->first == item) {
+				glDeleteQueries(GPUTimerLatency, it->second.Queries);
+				it = m_gpuTimers.erase(it);
+			} else
+				++it;
+		}
+	}
+	bool RenderEngine::StartComparison(PipelineItem* item, ShaderStage stage, const std::string& sourceA, const std::string& sourceB)
+	{
+		StopComparison();
+
+		if (item == nullptr || item->Type != PipelineItem::ItemType::ShaderPass)
+			return false;
+
+		ProgramVariant versions[2];
+		if (!m_buildComparisonVersion(item, stage, sourceA, versions[0])) {
+			Logger::Get().Log("Failed to build version A of " + std::string(item->Name) + " for the A/B comparison", true);
+			return false;
+		}
+		if (!m_buildComparisonVersion(item, stage, sourceB, versions[1])) {
+			Logger::Get().Log("Failed to build version B of " + std::string(item->Name) + " for the A/B comparison", true);
+			m_deleteProgramVariant(versions[0]);
+			return false;
+		}
+
+		m_comparison.Item = item;
+		m_comparison.Current = 0;
+		m_comparison.Program = 0;
+		m_comparison.CheckRequested = m_comparison.Checking = m_comparison.Checked = false;
+		m_comparison.MaxError = 0.0f;
+		m_comparison.DifferentPixels = 0;
+		for (int v = 0; v < 2; v++) {
+			m_comparison.Versions[v] = versions[v];
+
+			GPUTimer& timer = m_comparison.Timers[v];
+			glGenQueries(GPUTimerLatency, timer.Queries);
+			for (int i = 0; i < GPUTimerLatency; i++)
+				timer.Pending[i] = false;
+			timer.Samples.clear();
+		}
+
+		Logger::Get().Log("Started an A/B comparison of " + std::string(item->Name));
+
+		return true;
+	}
+	void RenderEngine::StopComparison()
+	{
+		if (m_comparison.Item == nullptr)
+			return;
+
+		for (int v = 0; v < 2; v++) {
+			m_deleteProgramVariant(m_comparison.Versions[v]);
+			glDeleteQueries(GPUTimerLatency, m_comparison.Timers[v].Queries);
+			m_comparison.Timers[v].Samples.clear();
+		}
+
+		m_comparison.Item = nullptr;
+		m_comparison.CheckRequested = m_comparison.Checked = false;
+	}
+	RenderEngine::ComparisonResult RenderEngine::GetComparisonResult()
+	{
+		ComparisonResult ret;
+		ret.Finished = m_isComparisonFinished();
+		ret.Checked = m_comparison.Checked;
+		ret.MaxError = m_comparison.MaxError;
+		ret.DifferentPixels = m_comparison.DifferentPixels;
+
+		for (int v = 0; v < 2; v++) {
+			std::vector<float> samples;
+			const std::vector<float>& timer = m_comparison.Timers[v].Samples;
+			if (m_comparison.Item != nullptr && timer.size() > ComparisonWarmup)
+				samples.assign(timer.begin() + ComparisonWarmup, timer.end());
+
+			ret.Samples[v] = samples.size();
+			ret.Mean[v] = ret.Median[v] = ret.Variance[v] = 0.0f;
+			if (samples.empty())
+				continue;
+
+			std::sort(samples.begin(), samples.end());
+			ret.Median[v] = samples[samples.size() / 2];
+
+			for (float sample : samples)
+				ret.Mean[v] += sample;
+			ret.Mean[v] /= samples.size();
+
+			if (samples.size() > 1) {
+				for (float sample : samples)
+					ret.Variance[v] += (sample - ret.Mean[v]) * (sample - ret.Mean[v]);
+				ret.Variance[v] /= samples.size() - 1;
+			}
+		}
+
+		// Welch's interval - the sample counts are large enough to use the normal quantile
+		ret.Difference = ret.Mean[1] - ret.Mean[0];
+		ret.Confidence = 0.0f;
+		if (ret.Samples[0] > 1 && ret.Samples[1] > 1)
+			ret.Confidence = 1.96f * sqrt(ret.Variance[0] / ret.Samples[0] + ret.Variance[1] / ret.Samples[1]);
+
+		return ret;
+	}
+	bool RenderEngine::m_buildComparisonVersion(PipelineItem* item, ShaderStage stageType, const std::string& source, ProgramVariant& version)
+	{
+		pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+
+		AsyncCompile job;
+		job.Name = item->Name;
+		job.IncludePaths = m_project->GetIncludePaths();
+		job.Macros = pass->Macros;
+		job.GSUsed = pass->GSUsed;
+		job.Generation = 0;
+
+		const char* paths[3] = { pass->VSPath, pass->PSPath, pass->GSPath };
+		const char* entries[3] = { pass->VSEntry, pass->PSEntry, pass->GSEntry };
+		ShaderStage types[3] = { ShaderStage::Vertex, ShaderStage::Pixel, ShaderStage::Geometry };
+		int stageCount = (pass->GSUsed && strlen(pass->GSPath) > 0 && strlen(pass->GSEntry) > 0) ? 3 : 2;
+
+		MessageStack msgs;
+		msgs.CurrentItem = item->Name;
+
+		for (int s = 0; s < stageCount; s++) {
+			AsyncCompile::Stage& stage = job.Stages[s];
+			stage.Type = types[s];
+			stage.Path = paths[s];
+			stage.Entry = entries[s];
+			stage.Source = (types[s] == stageType && !source.empty()) ? source : m_project->LoadProjectFile(paths[s]);
+			stage.Language = ShaderCompiler::GetShaderLanguageFromExtension(stage.Path);
+
+			if (stage.Source.empty() || stage.Language == ShaderLanguage::Plugin)
+				return false;
+
+			// GLSL goes to the driver as is
+			if (stage.Language == ShaderLanguage::GLSL) {
+				stage.Compiled = true;
+				continue;
+			}
+
+			stage.Compiled = ShaderCompiler::CompileSourceToSPIRV(stage.SPV, stage.Language, stage.Path, stage.Source, stage.Type, stage.Entry, job.Macros, &msgs, nullptr, false, &job.IncludePaths);
+			stage.GLSL = ShaderCompiler::ConvertToGLSL(stage.SPV, stage.Language, stage.Type, job.GSUsed, &msgs);
+		}
+
+		version.Program = m_linkPermutation(item, job, version.Pack, version.Samplers);
+		if (version.Program == 0)
+			m_msgs->Add(msgs.GetMessages());
+
+		return version.Program != 0;
+	}
+	bool RenderEngine::m_isComparisonFinished()
+	{
+		if (m_comparison.Item == nullptr)
+			return false;
+
+		for (int v = 0; v < 2; v++)
+			if (m_comparison.Timers[v].Samples.size() < ComparisonWarmup + ComparisonSamples)
+				return false;
+		return true;
+	}
+	int RenderEngine::m_beginComparisonFrame()
+	{
+		if (m_comparison.Item == nullptr || (m_isComparisonFinished() && !m_comparison.Checking))
+			return -1;
+
+		int index = -1;
+		for (int i = 0; i < m_items.size(); i++)
+			if (m_items[i] == m_comparison.Item) {
+				index = i;
+				break;
+			}
+		if (index == -1 || m_shaders[index] == 0)
+			return -1;
+
+		// swap the version in like ApplyPermutation does - the pass keeps its own program
+		pipe::ShaderPass* pass = (pipe::ShaderPass*)m_comparison.Item->Data;
+		const ProgramVariant& version = m_comparison.Versions[m_comparison.Current];
+
+		m_comparison.Program = m_shaders[index];
+		m_comparison.Samplers = pass->Variables.GetSamplerList();
+
+		m_shaders[index] = version.Program;
+		pass->Variables.SetTextureList(version.Samplers);
+		pass->Variables.SetUniformLocations(version.Pack.Locations);
+		pass->Variables.UpdateUniformInfo(version.Program);
+
+		return index;
+	}
+	void RenderEngine::m_endComparisonFrame(int index)
+	{
+		if (index == -1)
+			return;
+
+		pipe::ShaderPass* pass = (pipe::ShaderPass*)m_comparison.Item->Data;
+
+		m_shaders[index] = m_comparison.Program;
+		pass->Variables.SetTextureList(m_comparison.Samplers);
+		pass->Variables.SetUniformLocations(m_shaderSources[index].Locations);
+		pass->Variables.UpdateUniformInfo(m_shaders[index]);
+
+		// versions take turns so that both are affected by the same clock & thermal changes
+		if (!m_comparison.Checking)
+			m_comparison.Current = 1 - m_comparison.Current;
+	}
+	void RenderEngine::m_checkComparison(int width, int height)
+	{
+		if (m_comparison.Item == nullptr)
+			return;
+
+		pipe::ShaderPass* pass = (pipe::ShaderPass*)m_comparison.Item->Data;
+
+		// both versions have to see the same time, frame index & compute pass results
+		bool wasPaused = m_paused;
+		if (!wasPaused)
+			SystemVariableManager::Instance().GetTimeClock().Pause();
+		m_paused = true;
+
+		int current = m_comparison.Current;
+		m_comparison.Checking = true;
+
+		std::vector<float> pixels[2];
+		for (int v = 0; v < 2; v++) {
+			m_comparison.Current = v;
+			Render(width, height, false, m_comparison.Item);
+			m_readFirstTarget(pass, pixels[v]);
+		}
+
+		m_comparison.Checking = false;
+		m_comparison.Current = current;
+
+		m_paused = wasPaused;
+		if (!wasPaused)
+			SystemVariableManager::Instance().GetTimeClock().Resume();
+
+		m_comparison.MaxError = 0.0f;
+		m_comparison.DifferentPixels = 0;
+		for (size_t p = 0; p + 3 < pixels[0].size() && pixels[0].size() == pixels[1].size(); p += 4) {
+			float error = 0.0f;
+			for (int c = 0; c < 4; c++)
+				error = std::max(error, std::abs(pixels[0][p + c] - pixels[1][p + c]));
+
+			if (error > 0.0f)
+				m_comparison.DifferentPixels++;
+			m_comparison.MaxError = std::max(m_comparison.MaxError, error);
+		}
+		m_comparison.Checked = true;
+
+		Logger::Get().Log("A/B comparison output check: " + std::to_string(m_comparison.DifferentPixels) + " different pixels, max error " + std::to_string(m_comparison.MaxError));
+	}
+	void RenderEngine::m_readFirstTarget(pipe::ShaderPass* pass, std::vector<float>& pixels)
+	{
+		GLint width = 0, height = 0;
+		glBindTexture(GL_TEXTURE_2D, pass->RenderTextures[0]);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+
+		pixels.resize(width * height * 4);
+		if (!pixels.empty())
+			glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_FLOAT, pixels.data());
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+	void RenderEngine::m_checkBarriers(int width, int height)
+	{
+		auto& systemVM = SystemVariableManager::Instance();
+
+		// both renders have to start from the same objects, frame index & ping-pong state
+		std::vector<BarrierSnapshot> snapshot = m_snapshotObjects();
+		if (snapshot.empty())
+			return;
+
+		std::vector<std::pair<pipe::ComputePass*, bool>> swapped;
+		for (PipelineItem* item : m_items)
+			if (item->Type == PipelineItem::ItemType::ComputePass) {
+				pipe::ComputePass* pass = (pipe::ComputePass*)item->Data;
+				swapped.push_back(std::make_pair(pass, pass->PingPongSwapped));
+			}
+		unsigned int frameIndex = systemVM.GetFrameIndex();
+		auto pendingBuffers = m_barrierBuffers;
+		auto pendingTextures = m_barrierTextures;
+		bool timers = m_gpuTimersEnabled;
+		bool pick = m_pickAwaiting;
+
+		systemVM.GetTimeClock().Pause();
+		m_gpuTimersEnabled = false;
+		m_pickAwaiting = false;
+		m_checkingBarriers = true;
+
+		std::vector<std::vector<unsigned char>> results[2];
+		for (int r = 0; r < 2; r++) {
+			m_fullBarriers = (r == 1);
+			Render(width, height);
+
+			glMemoryBarrier(GL_ALL_BARRIER_BITS);
+			results[r].resize(snapshot.size());
+			for (size_t s = 0; s < snapshot.size(); s++)
+				m_readObject(snapshot[s], results[r][s]);
+
+			// undo the frame - the real one is rendered after the check
+			m_restoreSnapshot(snapshot);
+			for (const auto& pass : swapped)
+				pass.first->PingPongSwapped = pass.second;
+			systemVM.SetFrameIndex(frameIndex);
+			m_barrierBuffers = pendingBuffers;
+			m_barrierTextures = pendingTextures;
+		}
+
+		m_fullBarriers = false;
+		m_checkingBarriers = false;
+		m_gpuTimersEnabled = timers;
+		m_pickAwaiting = pick;
+		systemVM.GetTimeClock().Resume();
+
+		std::set<std::string> mismatch;
+		for (size_t s = 0; s < snapshot.size(); s++)
+			if (results[0][s] != results[1][s])
+				mismatch.insert(snapshot[s].Name);
+		m_deleteSnapshot(snapshot);
+
+		// only report the changes - atomics & other order dependent writes can differ between two renders too
+		if (mismatch != m_barrierMismatch) {
+			for (const auto& name : mismatch)
+				if (m_barrierMismatch.count(name) == 0)
+					Logger::Get().Log("Memory barrier check: \"" + name + "\" differs from the render with GL_ALL_BARRIER_BITS", true);
+			if (mismatch.empty())
+				Logger::Get().Log("Memory barrier check: all objects match the render with GL_ALL_BARRIER_BITS");
+			m_barrierMismatch = mismatch;
+		}
+	}
+	std::vector<RenderEngine::BarrierSnapshot> RenderEngine::m_snapshotObjects()
+	{
+		std::vector<BarrierSnapshot> ret;
+
+		std::vector<std::pair<std::string, GLuint>> textures;
+		textures.push_back(std::make_pair("Window", m_rtColor));
+
+		for (const std::string& name : m_objects->GetObjects()) {
+			if (m_objects->IsBuffer(name)) {
+				BufferObject* buf = m_objects->GetBuffer(name);
+				if (buf->Size <= 0)
+					continue;
+
+				BarrierSnapshot obj;
+				obj.Name = name;
+				obj.Object = buf->ID;
+				obj.Target = GL_BUFFER;
+				obj.Size = glm::ivec3(buf->Size, 1, 1);
+
+				glGenBuffers(1, &obj.Copy);
+				glBindBuffer(GL_COPY_READ_BUFFER, obj.Object);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, obj.Copy);
+				glBufferData(GL_COPY_WRITE_BUFFER, buf->Size, NULL, GL_STATIC_COPY);
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, buf->Size);
+				ret.push_back(obj);
+			} else if (m_objects->IsImage(name))
+				textures.push_back(std::make_pair(name, m_objects->GetImage(name)->Texture));
+			else if (m_objects->IsImage3D(name))
+				textures.push_back(std::make_pair(name, m_objects->GetImage3D(name)->Texture));
+			else if (m_objects->IsRenderTexture(name))
+				textures.push_back(std::make_pair(name, m_objects->GetTexture(name)));
+		}
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		for (const auto& tex : textures) {
+			BarrierSnapshot obj;
+			obj.Name = tex.first;
+			obj.Object = tex.second;
+			obj.Target = m_objects->IsImage3D(tex.second) ? GL_TEXTURE_3D : GL_TEXTURE_2D;
+
+			GLint format = 0;
+			glBindTexture(obj.Target, obj.Object);
+			glGetTexLevelParameteriv(obj.Target, 0, GL_TEXTURE_WIDTH, &obj.Size.x);
+			glGetTexLevelParameteriv(obj.Target, 0, GL_TEXTURE_HEIGHT, &obj.Size.y);
+			glGetTexLevelParameteriv(obj.Target, 0, GL_TEXTURE_DEPTH, &obj.Size.z);
+			glGetTexLevelParameteriv(obj.Target, 0, GL_TEXTURE_INTERNAL_FORMAT, &format);
+			if (obj.Size.x * obj.Size.y * obj.Size.z == 0)
+				continue;
+
+			glGenTextures(1, &obj.Copy);
+			glBindTexture(obj.Target, obj.Copy);
+			if (obj.Target == GL_TEXTURE_3D)
+				glTexStorage3D(obj.Target, 1, format, obj.Size.x, obj.Size.y, obj.Size.z);
+			else
+				glTexStorage2D(obj.Target, 1, format, obj.Size.x, obj.Size.y);
+			glCopyImageSubData(obj.Object, obj.Target, 0, 0, 0, 0, obj.Copy, obj.Target, 0, 0, 0, 0, obj.Size.x, obj.Size.y, obj.Size.z);
+			glBindTexture(obj.Target, 0);
+
+			ret.push_back(obj);
+		}
+
+		return ret;
+	}
+	void RenderEngine::m_restoreSnapshot(const std::vector<BarrierSnapshot>& snapshot)
+	{
+		for (const auto& obj : snapshot) {
+			if (obj.Target == GL_BUFFER) {
+				glBindBuffer(GL_COPY_READ_BUFFER, obj.Copy);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, obj.Object);
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, obj.Size.x);
+			} else
+				glCopyImageSubData(obj.Copy, obj.Target, 0, 0, 0, 0, obj.Object, obj.Target, 0, 0, 0, 0, obj.Size.x, obj.Size.y, obj.Size.z);
+		}
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+	void RenderEngine::m_deleteSnapshot(const std::vector<BarrierSnapshot>& snapshot)
+	{
+		for (const auto& obj : snapshot) {
+			if (obj.Target == GL_BUFFER)
+				glDeleteBuffers(1, &obj.Copy);
+			else
+				glDeleteTextures(1, &obj.Copy);
+		}
+	}
+	void RenderEngine::m_readObject(const BarrierSnapshot& obj, std::vector<unsigned char>& data)
+	{
+		if (obj.Target == GL_BUFFER) {
+			data.resize(obj.Size.x);
+			glBindBuffer(GL_COPY_READ_BUFFER, obj.Object);
+			glGetBufferSubData(GL_COPY_READ_BUFFER, 0, obj.Size.x, data.data());
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			return;
+		}
+
+		// integer textures can't be read as floats
+		GLint type = 0;
+		glBindTexture(obj.Target, obj.Object);
+		glGetTexLevelParameteriv(obj.Target, 0, GL_TEXTURE_RED_TYPE, &type);
+
+		GLenum format = GL_RGBA, pixelType = GL_FLOAT;
+		if (type == GL_INT || type == GL_UNSIGNED_INT) {
+			format = GL_RGBA_INTEGER;
+			pixelType = type;
+		}
+
+		data.resize(obj.Size.x * obj.Size.y * obj.Size.z * 4 * sizeof(GLfloat));
+		glGetTexImage(obj.Target, 0, format, pixelType, data.data());
+		glBindTexture(obj.Target, 0);
+	}
+	void RenderEngine::FinishAsyncRecompiles()
+	{
+		m_finishLazySPIRV();
+		m_finishPermutation();
+
+		std::vector<std::shared_ptr<AsyncCompile>> finished;
+		{
+			std::unique_lock<std::mutex> lock(m_asyncCompile->Mutex);
+			if (m_asyncCompile->Finished.empty())
+				return;
+
+			for (const auto& job : m_asyncCompile->Finished) {
+				// superseded or cancelled in the meantime
+				auto it = m_asyncCompile->Latest.find(job->Name);
+				if (it == m_asyncCompile->Latest.end() || it->second != job->Generation)
+					continue;
+
+				m_asyncCompile->Latest.erase(it);
+				finished.push_back(job);
+			}
+			m_asyncCompile->Finished.clear();
+		}
+		if (finished.empty())
+			return;
+
+		for (const auto& job : finished) {
+			int index = -1;
+			for (int i = 0; i < m_items.size(); i++)
+				if (job->Name == m_items[i]->Name) {
+					index = i;
+					break;
+				}
+			if (index == -1)
+				continue; // item was deleted or renamed
+
+			PipelineItem* item = m_items[index];
+			const char* name = item->Name;
+
+			m_msgs->BuildOccured = true;
+			m_msgs->CurrentItem = name;
+
+			m_plugins->HandleApplicationEvent(plugin::ApplicationEvent::PipelineItemCompiled, (void*)name, nullptr);
+
+			m_msgs->ClearGroup(name);
+			m_msgs->Add(job->Messages);
+
+			if (item->Type == PipelineItem::ItemType::ShaderPass) {
+				pipe::ShaderPass* shader = (pipe::ShaderPass*)item->Data;
+
+				GLenum glTypes[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+				GLuint* current[3] = { &m_shaderSources[index].VS, &m_shaderSources[index].PS, &m_shaderSources[index].GS };
+				std::vector<unsigned int>* spv[3] = { &shader->VSSPV, &shader->PSSPV, &shader->GSSPV };
+				GLuint created[3] = { 0, 0, 0 };
+				std::string psContent = "";
+				bool compiled = true;
+				bool wasSPIRV = m_shaderSources[index].SPIRV;
+
+				// GL_ARB_gl_spirv
+				const std::vector<unsigned int>* newSPV[3] = { nullptr, nullptr, nullptr };
+				bool spvCompiled = true;
+				for (int s = 0; s < 3; s++)
+					if (!job->Stages[s].Source.empty()) {
+						newSPV[s] = &job->Stages[s].SPV;
+						spvCompiled &= job->Stages[s].Compiled;
+					}
+
+				eng::Timer backendTimer;
+				GLuint program = spvCompiled ? m_linkSPIRVPass(index, shader, newSPV, created) : 0;
+				if (program != 0) {
+					for (int s = 0; s < 3; s++) {
+						if (created[s] == 0)
+							continue;
+
+						if (*current[s] != 0)
+							glDeleteShader(*current[s]);
+						*current[s] = created[s];
+						if (newSPV[s] != nullptr)
+							*spv[s] = std::move(job->Stages[s].SPV);
+					}
+
+					if (m_shaders[index] != 0)
+						glDeleteProgram(m_shaders[index]);
+					m_shaders[index] = program;
+
+					shader->Variables.SetTextureList(m_shaderSources[index].Samplers);
+					shader->Variables.SetUniformLocations(m_shaderSources[index].Locations);
+					shader->Variables.UpdateUniformInfo(program);
+
+					SPIRVQueue.push_back(item);
+					m_hashSources(item);
+					m_resetSpecialized(item, job->Macros);
+
+					m_msgs->Add(MessageStack::Type::Message, name, "Compiled the shaders.");
+					m_logBackendTime(name, true, backendTimer.GetElapsedTime());
+					continue;
+				}
+
+				for (int s = 0; s < 3; s++) {
+					AsyncCompile::Stage& stage = job->Stages[s];
+					if (s == 2 && !(shader->GSUsed && strlen(shader->GSPath) > 0 && strlen(shader->GSEntry) > 0))
+						continue;
+
+					// SPIR-V and GLSL shader objects can't be linked together - regenerate the unchanged stages too
+					if (stage.Source.empty()) {
+						if (!wasSPIRV)
+							continue;
+
+						std::string content = m_spirvStageToGLSL(shader, s);
+						if (s == 1)
+							psContent = content;
+
+						created[s] = gl::CompileShader(glTypes[s], content.c_str());
+						compiled &= gl::CheckShaderCompilationStatus(created[s]);
+						continue;
+					}
+
+					std::string content = stage.GLSL;
+					if (stage.Language == ShaderLanguage::GLSL) {
+						int lineBias = 0;
+						content = stage.Source;
+						m_includeCheck(content, std::vector<std::string>(), lineBias);
+						m_applyMacros(content, shader);
+
+						m_queueLazySPIRV(item, stage.Type, stage.Path, stage.Source, stage.Entry, job->Macros);
+					}
+					if (s == 1)
+						psContent = content;
+
+					created[s] = gl::CompileShader(glTypes[s], content.c_str());
+					compiled &= stage.Compiled && gl::CheckShaderCompilationStatus(created[s]);
+				}
+
+				if (compiled) {
+					program = glCreateProgram();
+					for (int s = 0; s < 3; s++) {
+						if (s == 2 && !shader->GSUsed)
+							continue;
+						glAttachShader(program, created[s] != 0 ? created[s] : *current[s]);
+					}
+					glLinkProgram(program);
+
+					if (!gl::CheckShaderLinkStatus(program, nullptr)) {
+						glDeleteProgram(program);
+						program = 0;
+					}
+				}
+
+				// keep rendering with the last program that worked
+				if (program == 0) {
+					for (int s = 0; s < 3; s++)
+						if (created[s] != 0)
+							glDeleteShader(created[s]);
+
+					m_msgs->Add(MessageStack::Type::Error, name, "Failed to compile the shader(s) - using the last successfully compiled version");
+					continue;
+				}
+
+				for (int s = 0; s < 3; s++) {
+					if (created[s] == 0)
+						continue;
+
+					glDeleteShader(*current[s]);
+					*current[s] = created[s];
+					if (!job->Stages[s].Source.empty() && job->Stages[s].Language != ShaderLanguage::GLSL)
+						*spv[s] = std::move(job->Stages[s].SPV);
+				}
+
+				if (m_shaders[index] != 0)
+					glDeleteProgram(m_shaders[index]);
+				m_shaders[index] = program;
+
+				if (wasSPIRV) {
+					m_shaderSources[index].SPIRV = false;
+					m_shaderSources[index].Locations.clear();
+					m_shaderSources[index].NextLocation = 0;
+					m_shaderSources[index].Samplers.clear();
+				}
+
+				if (!psContent.empty())
+					shader->Variables.UpdateTextureList(psContent);
+				shader->Variables.SetUniformLocations(m_shaderSources[index].Locations);
+				shader->Variables.UpdateUniformInfo(program);
+
+				SPIRVQueue.push_back(item);
+				m_hashSources(item);
+				m_resetSpecialized(item, job->Macros);
+
+				m_msgs->Add(MessageStack::Type::Message, name, "Compiled the shaders.");
+				m_logBackendTime(name, false, backendTimer.GetElapsedTime());
+			} else if (item->Type == PipelineItem::ItemType::ComputePass) {
+				pipe::ComputePass* shader = (pipe::ComputePass*)item->Data;
+				AsyncCompile::Stage& stage = job->Stages[0];
+
+				std::string content = stage.GLSL;
+				if (stage.Language == ShaderLanguage::GLSL) {
+					int lineBias = 0;
+					content = stage.Source;
+					m_includeCheck(content, std::vector<std::string>(), lineBias);
+					m_applyMacros(content, shader);
+
+					m_queueLazySPIRV(item, stage.Type, stage.Path, stage.Source, stage.Entry, job->Macros);
+				}
+
+				GLuint cs = gl::CompileShader(GL_COMPUTE_SHADER, content.c_str());
+				GLuint program = 0;
+				if (stage.Compiled && gl::CheckShaderCompilationStatus(cs)) {
+					program = glCreateProgram();
+					glAttachShader(program, cs);
+					glLinkProgram(program);
+
+					if (!gl::CheckShaderLinkStatus(program, nullptr)) {
+						glDeleteProgram(program);
+						program = 0;
+					}
+				}
+				glDeleteShader(cs);
+
+				// keep rendering with the last program that worked
+				if (program == 0) {
+					m_msgs->Add(MessageStack::Type::Error, name, "Failed to compile the compute shader - using the last successfully compiled version");
+					continue;
+				}
+
+				if (m_shaders[index] != 0)
+					glDeleteProgram(m_shaders[index]);
+				m_shaders[index] = program;
+
+				if (stage.Language != ShaderLanguage::GLSL)
+					shader->SPV = std::move(stage.SPV);
+				shader->Variables.UpdateUniformInfo(program);
+
+				SPIRVQueue.push_back(item);
+				m_hashSources(item);
+				m_resetSpecialized(item, job->Macros);
+
+				m_msgs->Add(MessageStack::Type::Message, name, "Compiled the compute shader.");
+			}
+		}
+
+		// the preview isn't updated every frame while paused
+		if (m_paused)
+			Render();
+	}
+	void RenderEngine::m_cache()
+	{
+		// shaders of a project that was just opened are still compiled on the worker threads -
+		// caching now would compile them again on this thread
+		if (m_project->GetLoader().IsCompilingShaders())
+			return;
+
+		// check for any changes
+		std::vector<ed::PipelineItem*>& items = m_pipeline->GetList();
+
+		// check if no major changes were made, if so dont cache for another 0.25s
+		if (m_items.size() == items.size()) {
+			if (m_cacheTimer.GetElapsedTime() > 0.5f)
+				m_cacheTimer.Restart();
+			else
+				return;
+		}
+
+		// check if some item was added
+		for (int i = 0; i < items.size(); i++) {
+			bool found = false;
+			for (int j = 0; j < m_items.size(); j++)
+				if (items[i]->Data == m_items[j]->Data) {
+					found = true;
+					break;
 				}
 
 			if (!found) {
@@ -1755,6 +3856,8 @@ namespace ed {
 					m_shaderSources.insert(m_shaderSources.begin() + i, ShaderPack());
 					
 					SPIRVQueue.push_back(items[i]);
+					m_hashSources(items[i]);
+					m_resetSpecialized(items[i], data->Macros);
 
 					if (strlen(data->VSPath) == 0 || strlen(data->PSPath) == 0) {
 						Logger::Get().Log("No shader paths are set", true);
@@ -1787,12 +3890,15 @@ namespace ed {
 
 					if (vsLang == ShaderLanguage::Plugin)
 						vsCompiled = m_pluginCompileToSpirv(data->VSSPV, data->VSPath, vsEntry, plugin::ShaderStage::Vertex, data->Macros.data(), data->Macros.size());
-					else
+					else if (vsLang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
 						vsCompiled = ShaderCompiler::CompileToSPIRV(data->VSSPV, vsLang, data->VSPath, ShaderStage::Vertex, vsEntry, data->Macros, m_msgs, m_project);
+					else
+						vsCompiled = true;
 					
 					// generate glsl
 					if (vsLang == ShaderLanguage::GLSL) { // GLSL
 						vsContent = m_project->LoadProjectFile(data->VSPath);
+						m_queueLazySPIRV(items[i], ShaderStage::Vertex, data->VSPath, vsContent, data->VSEntry, data->Macros);
 						m_includeCheck(vsContent, std::vector<std::string>(), lineBias);
 						m_applyMacros(vsContent, data);
 					} else if (vsCompiled) {
@@ -1812,11 +3918,14 @@ namespace ed {
 
 					if (psLang == ShaderLanguage::Plugin)
 						psCompiled = m_pluginCompileToSpirv(data->PSSPV, data->PSPath, psEntry, plugin::ShaderStage::Pixel, data->Macros.data(), data->Macros.size());
-					else
+					else if (psLang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
 						psCompiled = ShaderCompiler::CompileToSPIRV(data->PSSPV, psLang, data->PSPath, ShaderStage::Pixel, psEntry, data->Macros, m_msgs, m_project);
+					else
+						psCompiled = true;
 					
 					if (psLang == ShaderLanguage::GLSL) { // GLSL
 						psContent = m_project->LoadProjectFile(data->PSPath);
+						m_queueLazySPIRV(items[i], ShaderStage::Pixel, data->PSPath, psContent, data->PSEntry, data->Macros);
 						m_includeCheck(psContent, std::vector<std::string>(), lineBias);
 						m_applyMacros(psContent, data);
 					} else if (psCompiled) { // HLSL / VK
@@ -1840,11 +3949,14 @@ namespace ed {
 						
 						if (gsLang == ShaderLanguage::Plugin)
 							gsCompiled = m_pluginCompileToSpirv(data->GSSPV, data->GSPath, gsEntry, plugin::ShaderStage::Geometry, data->Macros.data(), data->Macros.size());
-						else
+						else if (gsLang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
 							gsCompiled = ShaderCompiler::CompileToSPIRV(data->GSSPV, gsLang, data->GSPath, ShaderStage::Geometry, gsEntry, data->Macros, m_msgs, m_project);
+						else
+							gsCompiled = true;
 						
 						if (gsLang == ShaderLanguage::GLSL) { // GLSL
 							gsContent = m_project->LoadProjectFile(data->GSPath);
+							m_queueLazySPIRV(items[i], ShaderStage::Geometry, data->GSPath, gsContent, data->GSEntry, data->Macros);
 							m_includeCheck(gsContent, std::vector<std::string>(), lineBias);
 							m_applyMacros(gsContent, data);
 						} else if (gsCompiled) { // HLSL
@@ -1866,6 +3978,8 @@ namespace ed {
 						glDeleteProgram(m_debugShaders[i]);
 
 					if (!vsCompiled || !psCompiled || !gsCompiled) {
+						m_finishLazySPIRV(items[i], true); // glslang's error messages
+
 						m_msgs->Add(MessageStack::Type::Error, items[i]->Name, "Failed to compile the shader");
 						m_shaders[i] = 0;
 					} else {
@@ -1884,8 +3998,11 @@ namespace ed {
 						glLinkProgram(m_debugShaders[i]);
 					}
 
-					if (m_shaders[i] != 0)
+					if (m_shaders[i] != 0) {
 						data->Variables.UpdateUniformInfo(m_shaders[i]);
+						m_activePermutation[items[i]] = m_permutationKey(items[i], data->Macros);
+					}
+					WarmPermutations(items[i]);
 
 					m_shaderSources[i].VS = vs;
 					m_shaderSources[i].PS = ps;
@@ -1900,6 +4017,8 @@ namespace ed {
 					m_shaderSources.insert(m_shaderSources.begin() + i, ShaderPack());
 
 					SPIRVQueue.push_back(items[i]);
+					m_hashSources(items[i]);
+					m_resetSpecialized(items[i], data->Macros);
 
 					if (strlen(data->Path) == 0) {
 						Logger::Get().Log("No shader paths are set", true);
@@ -1923,11 +4042,14 @@ namespace ed {
 
 					if (lang == ShaderLanguage::Plugin)
 						compiled = m_pluginCompileToSpirv(data->SPV, data->Path, entry, plugin::ShaderStage::Compute, data->Macros.data(), data->Macros.size());
-					else
+					else if (lang != ShaderLanguage::GLSL) // GLSL SPIR-V is generated in the background
 						compiled = ShaderCompiler::CompileToSPIRV(data->SPV, lang, data->Path, ShaderStage::Compute, entry, data->Macros, m_msgs, m_project);
+					else
+						compiled = true;
 					
 					if (lang == ShaderLanguage::GLSL) { // GLSL
 						content = m_project->LoadProjectFile(data->Path);
+						m_queueLazySPIRV(items[i], ShaderStage::Compute, data->Path, content, data->Entry, data->Macros);
 						m_includeCheck(content, std::vector<std::string>(), lineBias);
 						m_applyMacros(content, data);
 					} else if (compiled) { // HLSL / VK
@@ -1945,6 +4067,8 @@ namespace ed {
 						glDeleteProgram(m_shaders[i]);
 
 					if (!compiled) {
+						m_finishLazySPIRV(items[i], true); // glslang's error messages
+
 						m_msgs->Add(MessageStack::Type::Error, items[i]->Name, "Failed to compile the compute shader");
 						m_shaders[i] = 0;
 					} else {
@@ -1955,8 +4079,11 @@ namespace ed {
 						glLinkProgram(m_shaders[i]);
 					}
 
-					if (m_shaders[i] != 0)
+					if (m_shaders[i] != 0) {
 						data->Variables.UpdateUniformInfo(m_shaders[i]);
+						m_activePermutation[items[i]] = m_permutationKey(items[i], data->Macros);
+					}
+					WarmPermutations(items[i]);
 
 					m_shaderSources[i].VS = 0;
 					m_shaderSources[i].PS = 0;
@@ -2010,6 +4137,14 @@ namespace ed {
 
 				Logger::Get().Log("Removing an item from cache");
 
+				m_cancelLazySPIRV(m_items[i]);
+				m_deleteSpecialized(m_items[i]);
+				m_deletePermutations(m_items[i]);
+				m_deleteGPUTimers(m_items[i]);
+				m_culled.erase(m_items[i]);
+				if (m_comparison.Item == m_items[i])
+					StopComparison();
+
 				if (m_items[i]->Type == PipelineItem::ItemType::ShaderPass)
 					m_fbos.erase((pipe::ShaderPass*)m_items[i]->Data);
 
@@ -2053,51 +4188,17 @@ namespace ed {
 	}
 	void RenderEngine::m_applyMacros(std::string& src, pipe::ShaderPass* pass)
 	{
-		size_t verLoc = src.find_first_of("#version");
-		size_t lineLoc = src.find_first_of('\n', verLoc + 1) + 1;
-		std::string strMacro = "";
-
-#ifdef SHADERED_WEB
-		strMacro += "#define SHADERED_WEB\n";
-#else
-		strMacro += "#define SHADERED_DESKTOP\n";
-#endif
-		strMacro += "#define SHADERED_VERSION " + std::to_string(SHADERED_VERSION) + "\n";
-
-		for (auto& macro : pass->Macros) {
-			if (!macro.Active)
-				continue;
-
-			strMacro += "#define " + std::string(macro.Name) + " " + std::string(macro.Value) + "\n";
-		}
-
-		if (strMacro.size() > 0)
-			src.insert(lineLoc, strMacro);
+		m_applyMacros(src, pass->Macros);
 	}
 	void RenderEngine::m_applyMacros(std::string& src, pipe::ComputePass* pass)
 	{
-		size_t verLoc = src.find_first_of("#version");
-		size_t lineLoc = src.find_first_of('\n', verLoc + 1) + 1;
-		std::string strMacro = "";
-
-#ifdef SHADERED_WEB
-		strMacro += "#define SHADERED_WEB\n";
-#else
-		strMacro += "#define SHADERED_DESKTOP\n";
-#endif
-		strMacro += "#define SHADERED_VERSION " + std::to_string(SHADERED_VERSION) + "\n";
-
-		for (auto& macro : pass->Macros) {
-			if (!macro.Active)
-				continue;
-
-			strMacro += "#define " + std::string(macro.Name) + " " + std::string(macro.Value) + "\n";
-		}
-
-		if (strMacro.size() > 0)
-			src.insert(lineLoc, strMacro);
+		m_applyMacros(src, pass->Macros);
 	}
 	void RenderEngine::m_applyMacros(std::string& src, pipe::AudioPass* pass)
+	{
+		m_applyMacros(src, pass->Macros);
+	}
+	void RenderEngine::m_applyMacros(std::string& src, const std::vector<ShaderMacro>& macros)
 	{
 		size_t verLoc = src.find_first_of("#version");
 		size_t lineLoc = src.find_first_of('\n', verLoc + 1) + 1;
@@ -2110,7 +4211,7 @@ namespace ed {
 #endif
 		strMacro += "#define SHADERED_VERSION " + std::to_string(SHADERED_VERSION) + "\n";
 
-		for (auto& macro : pass->Macros) {
+		for (auto& macro : macros) {
 			if (!macro.Active)
 				continue;
 
@@ -2127,7 +4228,7 @@ namespace ed {
 		bool ret = false;
 
 		int plLang = 0;
-		IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&plLang, path, m_plugins->Plugins());
+		IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&plLang, path, m_plugins);
 
 		return plugin->CustomLanguage_ProcessGeneratedGLSL(plLang, src);
 	}
@@ -2136,7 +4237,7 @@ namespace ed {
 		bool ret = false;
 
 		int plLang = 0;
-		IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&plLang, path, m_plugins->Plugins());
+		IPlugin1* plugin = ShaderCompiler::GetPluginLanguageFromExtension(&plLang, path, m_plugins);
 		if (plugin == nullptr) {
 			spvvec.clear();
 			return false;
@@ -2146,8 +4247,16 @@ namespace ed {
 		if (actualSource.empty())
 			source = m_project->LoadProjectFile(path);
 
+		// plugins use the original ShaderMacro layout
+		std::vector<plugin::ShaderMacro> plMacros(macroCount);
+		for (size_t i = 0; i < macroCount; i++) {
+			plMacros[i].Active = macros[i].Active;
+			memcpy(plMacros[i].Name, macros[i].Name, sizeof(plMacros[i].Name));
+			memcpy(plMacros[i].Value, macros[i].Value, sizeof(plMacros[i].Value));
+		}
+
 		size_t spv_length = 0;
-		const unsigned int* spv = plugin->CustomLanguage_CompileToSPIRV(plLang, source.c_str(), source.size(), stage, entry.c_str(), (plugin::ShaderMacro*)macros, macroCount, &spv_length, &ret);
+		const unsigned int* spv = plugin->CustomLanguage_CompileToSPIRV(plLang, source.c_str(), source.size(), stage, entry.c_str(), plMacros.data(), macroCount, &spv_length, &ret);
 
 		spvvec = std::vector<GLuint>(spv, spv + spv_length);
 		
@@ -2206,6 +4315,286 @@ namespace ed {
 			incLoc = src.find("#include", incLoc + 1);
 		}
 	}
+	GLuint RenderEngine::m_createSPIRVShader(GLenum type, std::vector<unsigned int> spv, ShaderPack& pack)
+	{
+		if (Settings::Instance().Project.OptimizeSPIRV)
+			ShaderCompiler::OptimizeSPIRV(spv);
+
+		std::string entry = "main";
+		if (!ShaderCompiler::PrepareGLSPIRV(spv, pack.Locations, pack.NextLocation, pack.Samplers, entry))
+			return 0;
+
+		GLuint ret = glCreateShader(type);
+		glShaderBinary(1, &ret, GL_SHADER_BINARY_FORMAT_SPIR_V_ARB, spv.data(), spv.size() * sizeof(unsigned int));
+		glSpecializeShaderARB(ret, entry.c_str(), 0, nullptr, nullptr);
+
+		if (!gl::CheckShaderCompilationStatus(ret)) {
+			glDeleteShader(ret);
+			return 0;
+		}
+
+		return ret;
+	}
+	GLuint RenderEngine::m_linkSPIRVPass(int index, pipe::ShaderPass* pass, const std::vector<unsigned int>* spv[3], GLuint created[3])
+	{
+		created[0] = created[1] = created[2] = 0;
+
+		if (!ShaderCompiler::IsGLSPIRVSupported())
+			return 0;
+
+		bool gsUsed = pass->GSUsed && strlen(pass->GSPath) > 0 && strlen(pass->GSEntry) > 0;
+		if (pass->GSUsed && !gsUsed)
+			return 0;
+
+		// every stage has to go through SPIR-V
+		const char* paths[3] = { pass->VSPath, pass->PSPath, pass->GSPath };
+		int stageCount = gsUsed ? 3 : 2;
+		for (int s = 0; s < stageCount; s++)
+			if (strlen(paths[s]) == 0 || ShaderCompiler::GetShaderLanguageFromExtension(paths[s]) == ShaderLanguage::GLSL)
+				return 0;
+
+		ShaderPack& current = m_shaderSources[index];
+		GLuint currentObjs[3] = { current.VS, current.PS, current.GS };
+		const std::vector<unsigned int>* storedSPV[3] = { &pass->VSSPV, &pass->PSSPV, &pass->GSSPV };
+		bool keep[3] = { false, false, false };
+		for (int s = 0; s < stageCount; s++)
+			keep[s] = spv[s] == nullptr && current.SPIRV && currentObjs[s] != 0;
+
+		// kept shaders already have their uniform locations and sampler bindings baked in
+		ShaderPack pack;
+		if (keep[0] || keep[1] || keep[2]) {
+			pack.Locations = current.Locations;
+			pack.NextLocation = current.NextLocation;
+		}
+		if (keep[1])
+			pack.Samplers = current.Samplers;
+
+		// pixel shader first so that its samplers get the first texture units
+		GLenum glTypes[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+		int order[3] = { 1, 0, 2 };
+		bool success = true;
+		for (int o = 0; o < 3 && success; o++) {
+			int s = order[o];
+			if (s >= stageCount || keep[s])
+				continue;
+
+			const std::vector<unsigned int>* code = spv[s] != nullptr ? spv[s] : storedSPV[s];
+			created[s] = m_createSPIRVShader(glTypes[s], *code, pack);
+			success = created[s] != 0;
+		}
+
+		GLuint program = 0;
+		if (success) {
+			program = glCreateProgram();
+			for (int s = 0; s < stageCount; s++)
+				glAttachShader(program, keep[s] ? currentObjs[s] : created[s]);
+			glLinkProgram(program);
+
+			if (!gl::CheckShaderLinkStatus(program, nullptr)) {
+				glDeleteProgram(program);
+				program = 0;
+			}
+		}
+
+		if (program == 0) {
+			for (int s = 0; s < 3; s++) {
+				if (created[s] != 0)
+					glDeleteShader(created[s]);
+				created[s] = 0;
+			}
+			return 0;
+		}
+
+		current.SPIRV = true;
+		current.Locations = pack.Locations;
+		current.NextLocation = pack.NextLocation;
+		current.Samplers = pack.Samplers;
+
+		return program;
+	}
+	std::string RenderEngine::m_spirvStageToGLSL(pipe::ShaderPass* pass, int stage)
+	{
+		const char* paths[3] = { pass->VSPath, pass->PSPath, pass->GSPath };
+		const std::vector<unsigned int>* spv[3] = { &pass->VSSPV, &pass->PSSPV, &pass->GSSPV };
+		ShaderStage types[3] = { ShaderStage::Vertex, ShaderStage::Pixel, ShaderStage::Geometry };
+
+		ShaderLanguage lang = ShaderCompiler::GetShaderLanguageFromExtension(paths[stage]);
+		std::string ret = ShaderCompiler::ConvertToGLSL(*spv[stage], lang, types[stage], pass->GSUsed, m_msgs);
+		if (lang == ShaderLanguage::Plugin)
+			ret = m_pluginProcessGLSL(paths[stage], ret.c_str());
+
+		return ret;
+	}
+	void RenderEngine::m_convertPassToGLSL(int index, pipe::ShaderPass* pass)
+	{
+		ShaderPack& pack = m_shaderSources[index];
+		if (!pack.SPIRV)
+			return;
+
+		GLenum glTypes[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+		GLuint* objs[3] = { &pack.VS, &pack.PS, &pack.GS };
+		for (int s = 0; s < 3; s++) {
+			if (*objs[s] == 0)
+				continue;
+
+			std::string content = m_spirvStageToGLSL(pass, s);
+			if (s == 1)
+				pass->Variables.UpdateTextureList(content);
+
+			glDeleteShader(*objs[s]);
+			*objs[s] = gl::CompileShader(glTypes[s], content.c_str());
+		}
+
+		pack.SPIRV = false;
+		pack.Locations.clear();
+		pack.NextLocation = 0;
+		pack.Samplers.clear();
+	}
+	void RenderEngine::m_logBackendTime(const char* name, bool spirv, float time)
+	{
+		m_backendTime[spirv] += time;
+		m_backendCount[spirv]++;
+
+		if (!spirv)
+			return;
+
+		std::stringstream msg;
+		msg << std::fixed << std::setprecision(2) << "Created " << name << " from SPIR-V in " << time * 1000.0f << " ms";
+		if (m_backendCount[0] > 0)
+			msg << " (GLSL path average: " << m_backendTime[0] * 1000.0f / m_backendCount[0] << " ms)";
+		Logger::Get().Log(msg.str());
+	}
+	void RenderEngine::m_resetSpecialized(PipelineItem* item, const std::vector<ShaderMacro>& macros)
+	{
+		m_activePermutation.erase(item); // set again by the callers that compile from the files
+
+		SpecializedPrograms& spec = m_specialized[item];
+		m_deleteProgramVariants(spec);
+		spec.Signature = getMacroSignature(macros);
+		spec.Current = getSpecializationKey(macros);
+	}
+	void RenderEngine::m_deleteProgramVariant(const ProgramVariant& variant)
+	{
+		glDeleteProgram(variant.Program);
+		glDeleteShader(variant.Pack.VS);
+		glDeleteShader(variant.Pack.PS);
+		glDeleteShader(variant.Pack.GS);
+	}
+	void RenderEngine::m_deleteProgramVariants(SpecializedPrograms& spec)
+	{
+		for (auto& variant : spec.Variants)
+			m_deleteProgramVariant(variant.second);
+		spec.Variants.clear();
+	}
+	void RenderEngine::m_evictProgramVariant(SpecializedPrograms& spec)
+	{
+		if (spec.Variants.empty())
+			return;
+
+		auto oldest = spec.Variants.begin();
+		for (auto it = spec.Variants.begin(); it != spec.Variants.end(); it++)
+			if (it->second.LastUse < oldest->second.LastUse)
+				oldest = it;
+
+		m_deleteProgramVariant(oldest->second);
+		spec.Variants.erase(oldest);
+	}
+	void RenderEngine::m_deleteSpecialized(PipelineItem* item)
+	{
+		for (auto it = m_specialized.begin(); it != m_specialized.end();) {
+			if (item == nullptr || it->first == item) {
+				m_deleteProgramVariants(it->second);
+				it = m_specialized.erase(it);
+			} else
+				++it;
+		}
+	}
+	GLuint RenderEngine::m_buildSpecializedPass(int index, pipe::ShaderPass* pass)
+	{
+		// SPIR-V was already patched with the new values - only GLSL stages need their source
+		const std::vector<unsigned int>* spv[3] = { &pass->VSSPV, &pass->PSSPV, &pass->GSSPV };
+		GLuint created[3] = { 0, 0, 0 };
+		GLuint program = m_linkSPIRVPass(index, pass, spv, created);
+		if (program != 0) {
+			m_shaderSources[index].VS = created[0];
+			m_shaderSources[index].PS = created[1];
+			m_shaderSources[index].GS = created[2];
+
+			pass->Variables.SetTextureList(m_shaderSources[index].Samplers);
+			pass->Variables.SetUniformLocations(m_shaderSources[index].Locations);
+			return program;
+		}
+
+		const char* paths[3] = { pass->VSPath, pass->PSPath, pass->GSPath };
+		GLenum glTypes[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+		int stageCount = (pass->GSUsed && strlen(pass->GSPath) > 0 && strlen(pass->GSEntry) > 0) ? 3 : 2;
+		bool compiled = !pass->GSUsed || stageCount == 3;
+		for (int s = 0; s < stageCount; s++) {
+			std::string content = "";
+			if (ShaderCompiler::GetShaderLanguageFromExtension(paths[s]) == ShaderLanguage::GLSL) {
+				int lineBias = 0;
+				content = m_project->LoadProjectFile(paths[s]);
+				m_includeCheck(content, std::vector<std::string>(), lineBias);
+				m_applyMacros(content, pass);
+			} else
+				content = m_spirvStageToGLSL(pass, s);
+
+			if (s == 1)
+				pass->Variables.UpdateTextureList(content);
+
+			created[s] = gl::CompileShader(glTypes[s], content.c_str());
+			compiled &= !content.empty() && gl::CheckShaderCompilationStatus(created[s]);
+		}
+
+		m_shaderSources[index].VS = created[0];
+		m_shaderSources[index].PS = created[1];
+		m_shaderSources[index].GS = created[2];
+		pass->Variables.SetUniformLocations(m_shaderSources[index].Locations);
+
+		if (!compiled)
+			return 0;
+
+		program = glCreateProgram();
+		for (int s = 0; s < stageCount; s++)
+			glAttachShader(program, created[s]);
+		glLinkProgram(program);
+
+		if (!gl::CheckShaderLinkStatus(program, nullptr)) {
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		return program;
+	}
+	GLuint RenderEngine::m_buildSpecializedCompute(int index, pipe::ComputePass* pass)
+	{
+		ShaderLanguage lang = ShaderCompiler::GetShaderLanguageFromExtension(pass->Path);
+
+		std::string content = "";
+		if (lang == ShaderLanguage::GLSL) {
+			int lineBias = 0;
+			content = m_project->LoadProjectFile(pass->Path);
+			m_includeCheck(content, std::vector<std::string>(), lineBias);
+			m_applyMacros(content, pass);
+		} else
+			content = ShaderCompiler::ConvertToGLSL(pass->SPV, lang, ShaderStage::Compute, false, m_msgs);
+
+		GLuint cs = gl::CompileShader(GL_COMPUTE_SHADER, content.c_str());
+		GLuint program = 0;
+		if (!content.empty() && gl::CheckShaderCompilationStatus(cs)) {
+			program = glCreateProgram();
+			glAttachShader(program, cs);
+			glLinkProgram(program);
+
+			if (!gl::CheckShaderLinkStatus(program, nullptr)) {
+				glDeleteProgram(program);
+				program = 0;
+			}
+		}
+		glDeleteShader(cs);
+
+		return program;
+	}
 	void RenderEngine::m_updatePassFBO(ed::pipe::ShaderPass* pass)
 	{
 		bool changed = false;
@@ -5,8 +5,14 @@
 #include <SHADERed/Objects/PipelineManager.h>
 #include <SHADERed/Objects/PluginManager.h>
 #include <SHADERed/Objects/ProjectParser.h>
+#include <SHADERed/Objects/ShaderLanguage.h>
 
+#include <condition_variable>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <unordered_map>
 
 #include <glm/glm.hpp>
@@ -36,6 +42,54 @@ namespace ed {
 		void Recompile(const char* name);
 		void RecompileFile(const char* fname);
 		void RecompileFromSource(const char* name, const std::string& vs = "", const std::string& ps = "", const std::string& gs = "");
+		void UpdateSpecializationConstants(const char* name); // only macros lowered to specialization constants changed - falls back to Recompile()
+		void RecompileFromSourceAsync(const char* name, const std::string& vs = "", const std::string& ps = "", const std::string& gs = ""); // keeps the current program until the new one links
+		void FinishAsyncRecompiles(); // swaps in the programs compiled in the background, called once per frame
+		void RequireSPIRV(PipelineItem* item); // waits for the SPIR-V of GLSL shaders that is still being generated (debugger, stats)
+		bool IsSPIRVPending(PipelineItem* item);
+
+		/* macro permutations */
+		enum class PermutationState {
+			None,
+			Compiling,
+			Cached,
+			Active
+		};
+		void WarmPermutations(PipelineItem* item);			  // compiles the item's permutations that aren't cached yet on idle worker threads
+		bool ApplyPermutation(PipelineItem* item, int index); // copies the macros to the item, returns false if the program wasn't cached and had to be recompiled
+		PermutationState GetPermutationState(PipelineItem* item, int index);
+		inline size_t GetPermutationCount() { return m_permutations.size(); }
+		size_t GetPermutationMemory(); // estimated - program binary + SPIR-V size
+
+		/* GPU timers - GL_TIME_ELAPSED queries around shader & compute passes */
+		inline void EnableGPUTimers(bool enable) { m_gpuTimersEnabled = enable; }
+		inline bool AreGPUTimersEnabled() { return m_gpuTimersEnabled; }
+		void ResetGPUTimer(PipelineItem* item); // drops the collected samples and the queries that are still in flight
+		float GetGPUTime(PipelineItem* item);	// mean of the collected samples in milliseconds, -1 if there aren't any
+		int GetGPUTimeSampleCount(PipelineItem* item);
+
+		/* pass culling - passes whose outputs nothing reads in the current frame are skipped (Preview.CullPasses) */
+		inline bool IsCulled(PipelineItem* item) { return m_culled.count(item) > 0; }
+		inline int GetCulledCount() { return m_culled.size(); }
+		inline void SetObservedObjects(const std::vector<std::string>& names) { m_observed = names; } // objects shown in the object preview windows
+
+		/* A/B comparison - two versions of a shader pass take turns on alternating frames, each one with its own GPU timer */
+		struct ComparisonResult {
+			int Samples[2];						   // without the warm-up samples
+			float Mean[2], Median[2], Variance[2]; // milliseconds
+			float Difference;					   // mean of B - mean of A
+			float Confidence;					   // half-width of the 95% confidence interval of the difference
+			bool Finished;
+			bool Checked; // output of both versions was compared
+			float MaxError;
+			int DifferentPixels;
+		};
+		bool StartComparison(PipelineItem* item, ShaderStage stage, const std::string& sourceA, const std::string& sourceB); // empty source -> saved file, returns false if a version can't be built
+		void StopComparison();
+		inline PipelineItem* GetComparisonItem() { return m_comparison.Item; }
+		inline void RequestComparisonCheck() { m_comparison.CheckRequested = true; } // renders both versions once with the time stopped and compares the first render texture
+		ComparisonResult GetComparisonResult();
+
 		void Pick(float sx, float sy, bool multiPick, std::function<void(PipelineItem*)> func = nullptr);
 		void Pick(PipelineItem* item, bool add = false);
 		inline bool IsPicked(PipelineItem* item) { return std::count(m_pick.begin(), m_pick.end(), item); }
@@ -118,7 +172,8 @@ namespace ed {
 		// apply macros to GLSL source code
 		void m_applyMacros(std::string& source, pipe::ShaderPass* pass);
 		void m_applyMacros(std::string& source, pipe::ComputePass* pass);
-		void m_applyMacros(std::string& source, pipe::AudioPass* pass); // TODO: merge this function with the ones above
+		void m_applyMacros(std::string& source, pipe::AudioPass* pass);
+		void m_applyMacros(std::string& source, const std::vector<ShaderMacro>& macros);
 
 		// compile to spirv - plugin edition
 		bool m_pluginCompileToSpirv(std::vector<GLuint>& spv, const std::string& path, const std::string& entry, plugin::ShaderStage stage, ed::ShaderMacro* macros, size_t macroCount, const std::string& actualSrc = "");
@@ -143,18 +198,210 @@ namespace ed {
 		std::unordered_map<pipe::ShaderPass*, GLuint> m_fboCount;
 		std::unordered_map<pipe::ComputePass*, int> m_uboMax;
 		struct ShaderPack {
-			ShaderPack() { VS = GS = PS = 0; }
+			ShaderPack()
+			{
+				VS = GS = PS = 0;
+				SPIRV = false;
+				NextLocation = 0;
+			}
 			GLuint VS, PS, GS;
+
+			// GL_ARB_gl_spirv
+			bool SPIRV;							  // shader objects were created with glShaderBinary
+			std::map<std::string, int> Locations; // uniform name -> location, shared by all stages
+			int NextLocation;
+			std::vector<std::string> Samplers; // texture unit -> sampler name
 		};
 		std::vector<ShaderPack> m_shaderSources;
 
+		/* GL_ARB_gl_spirv - SPIR-V is handed to the driver directly instead of going through SPIRV-Cross and the GLSL compiler */
+		GLuint m_createSPIRVShader(GLenum type, std::vector<unsigned int> spv, ShaderPack& pack);
+		// stages with spv[i] == nullptr are either kept (if they already are SPIR-V) or created from the last SPIR-V,
+		// returns 0 if the pass can't be used through GL_ARB_gl_spirv - the caller owns the created[] shaders
+		GLuint m_linkSPIRVPass(int index, pipe::ShaderPass* pass, const std::vector<unsigned int>* spv[3], GLuint created[3]);
+		void m_convertPassToGLSL(int index, pipe::ShaderPass* pass); // SPIR-V and GLSL shaders can't be linked together
+		std::string m_spirvStageToGLSL(pipe::ShaderPass* pass, int stage); // 0 - VS, 1 - PS, 2 - GS
+		float m_backendTime[2]; // total time spent in SPIRV-Cross + driver compile + link: [0] GLSL, [1] SPIR-V
+		int m_backendCount[2];
+		void m_logBackendTime(const char* name, bool spirv, float time);
+
 		GLuint m_generalDebugShader;
 
 		void m_updatePassFBO(ed::pipe::ShaderPass* pass);
+		void m_bindStorage(int slot, GLuint id); // buffer, image or plugin object bound to a compute pass
 
 		std::vector<ItemVariableValue> m_itemValues; // list of all values to apply once we start rendering
 
 		eng::Timer m_cacheTimer;
 		void m_cache();
+
+		/* background recompiles - glslang & SPIRV-Cross run on the ThreadPool, driver compile + link on the GL thread */
+		struct AsyncCompile {
+			struct Stage {
+				Stage() { Compiled = false; }
+				ShaderStage Type;
+				ShaderLanguage Language;
+				std::string Path, Entry;
+				std::string Source; // empty -> stage wasn't changed
+				std::vector<unsigned int> SPV;
+				std::string GLSL; // output of SPIRV-Cross (not used for GLSL shaders)
+				bool Compiled;
+			};
+
+			std::string Name;
+			unsigned int Generation;
+			Stage Stages[3]; // vertex/compute, pixel, geometry
+			std::vector<ShaderMacro> Macros;
+			bool GSUsed;
+			std::vector<std::string> IncludePaths; // taken on the GL thread - the job can't touch the project or the settings
+			std::vector<MessageStack::Message> Messages;
+		};
+		struct AsyncCompileQueue {
+			AsyncCompileQueue() { Counter = 0; }
+			std::mutex Mutex;
+			unsigned int Counter;
+			std::unordered_map<std::string, unsigned int> Latest; // item name -> generation of the newest job
+			std::vector<std::shared_ptr<AsyncCompile>> Finished;
+		};
+		std::shared_ptr<AsyncCompileQueue> m_asyncCompile; // shared with the jobs so that they can outlive the RenderEngine
+		void m_cancelAsyncCompile(const std::string& name);
+
+		/* lazy SPIR-V - GLSL goes to the driver directly, its SPIR-V is only used for reflection, autocomplete, auto-uniforms and the debugger */
+		struct LazySPIRV {
+			LazySPIRV() { Compiled = Done = false; }
+			PipelineItem* Item;
+			ShaderStage Type;
+			std::string Name, Path, Entry, Source;
+			std::vector<ShaderMacro> Macros;
+			std::vector<std::string> IncludePaths; // taken on the GL thread
+			std::vector<unsigned int> SPV;
+			std::vector<MessageStack::Message> Messages;
+			bool Compiled, Done;
+		};
+		struct LazySPIRVQueue {
+			std::mutex Mutex;
+			std::condition_variable Finished;
+			std::map<std::pair<PipelineItem*, ShaderStage>, std::shared_ptr<LazySPIRV>> Pending; // newest job for each stage
+		};
+		std::shared_ptr<LazySPIRVQueue> m_lazySPIRV;
+		void m_queueLazySPIRV(PipelineItem* item, ShaderStage stage, const std::string& path, const std::string& source, const std::string& entry, const std::vector<ShaderMacro>& macros);
+		void m_cancelLazySPIRV(PipelineItem* item = nullptr); // nullptr -> all items
+		void m_finishLazySPIRV(PipelineItem* item = nullptr, bool wait = false); // wait: block until the SPIR-V of the item is ready
+
+		/* specialization constants - programs built for other macro values are kept so that switching back is instant */
+		struct ProgramVariant {
+			GLuint Program;
+			ShaderPack Pack;
+			std::vector<std::string> Samplers; // texture list of the pass
+			unsigned int LastUse = 0;		   // when the variant was deactivated
+		};
+		struct SpecializedPrograms {
+			std::string Signature;							// macros that aren't specialization constants - changing them needs a full recompile
+			std::string Current;							// specialization constant values of the active program
+			std::map<std::string, ProgramVariant> Variants; // inactive programs
+			unsigned int Clock = 0;
+		};
+		std::unordered_map<PipelineItem*, SpecializedPrograms> m_specialized;
+		void m_resetSpecialized(PipelineItem* item, const std::vector<ShaderMacro>& macros); // called on every full compile
+		void m_deleteSpecialized(PipelineItem* item = nullptr);							 // nullptr -> all items
+		void m_deleteProgramVariant(const ProgramVariant& variant);
+		void m_deleteProgramVariants(SpecializedPrograms& spec);
+		void m_evictProgramVariant(SpecializedPrograms& spec); // least recently used
+		GLuint m_buildSpecializedPass(int index, pipe::ShaderPass* pass);
+		GLuint m_buildSpecializedCompute(int index, pipe::ComputePass* pass);
+
+		/* macro permutations - glslang & SPIRV-Cross on idle worker threads, one driver compile per frame on the GL thread */
+		struct CachedPermutation {
+			PipelineItem* Item;
+			ProgramVariant Variant;
+			std::vector<unsigned int> SPV[3]; // vertex/compute, pixel, geometry - not stored for GLSL
+			size_t Memory;
+			unsigned int LastUse;
+		};
+		struct PermutationQueue {
+			std::mutex Mutex;
+			std::set<std::string> Pending; // keys that are being compiled
+			std::vector<std::pair<std::string, std::shared_ptr<AsyncCompile>>> Finished;
+		};
+		std::unordered_map<std::string, CachedPermutation> m_permutations; // key -> program
+		std::unordered_map<PipelineItem*, std::string> m_activePermutation; // key of the program that is currently used, if it was compiled from the files
+		std::shared_ptr<PermutationQueue> m_permutationQueue;
+		unsigned int m_permutationClock;
+		std::vector<MacroPermutation>* m_getPermutations(PipelineItem* item);
+		std::unordered_map<PipelineItem*, std::string> m_sourceHash; // stage files and their #includes, hashed once per compile
+		void m_hashSources(PipelineItem* item);
+		void m_hashFile(const std::string& path, size_t& hash, std::vector<std::string>& visited);
+		std::string m_permutationKey(PipelineItem* item, const std::vector<ShaderMacro>& macros); // item + sources + macros
+		PermutationState m_permutationState(PipelineItem* item, const std::string& key);
+		void m_finishPermutation(); // links at most one finished permutation
+		GLuint m_linkPermutation(PipelineItem* item, AsyncCompile& job, ShaderPack& pack, std::vector<std::string>& samplers);
+		size_t m_programMemory(GLuint program, const std::vector<unsigned int>* spv, int count);
+		void m_evictPermutations();
+		void m_deletePermutations(PipelineItem* item = nullptr); // nullptr -> all items
+
+		/* GPU timers - results are read a few frames later so that the queries don't stall the pipeline */
+		static const int GPUTimerLatency = 4;
+		static const int MaxGPUTimerSamples = 240;
+		struct GPUTimer {
+			GLuint Queries[GPUTimerLatency];
+			bool Pending[GPUTimerLatency];
+			std::vector<float> Samples; // milliseconds
+		};
+		bool m_gpuTimersEnabled;
+		unsigned int m_gpuTimerFrame;
+		std::unordered_map<PipelineItem*, GPUTimer> m_gpuTimers;
+		void m_beginGPUTimer(PipelineItem* item);
+		void m_endGPUTimer();
+		void m_beginGPUTimer(GPUTimer& timer, size_t maxSamples);
+		void m_deleteGPUTimers(PipelineItem* item = nullptr); // nullptr -> all items
+
+		/* A/B comparison */
+		static const int ComparisonWarmup = 30;	  // samples of each version that are thrown away
+		static const int ComparisonSamples = 300; // samples of each version that are kept
+		struct Comparison {
+			PipelineItem* Item;
+			ProgramVariant Versions[2];
+			GPUTimer Timers[2];
+			int Current;					   // version used in the current frame
+			GLuint Program;					   // program of the pass while a version is swapped in
+			std::vector<std::string> Samplers; // texture list of the pass while a version is swapped in
+			bool CheckRequested, Checking, Checked;
+			float MaxError;
+			int DifferentPixels;
+		};
+		Comparison m_comparison;
+		bool m_buildComparisonVersion(PipelineItem* item, ShaderStage stage, const std::string& source, ProgramVariant& version);
+		bool m_isComparisonFinished();
+		int m_beginComparisonFrame(); // returns the index of the pass or -1
+		void m_endComparisonFrame(int index);
+		void m_checkComparison(int width, int height);
+		void m_readFirstTarget(pipe::ShaderPass* pass, std::vector<float>& pixels); // RGBA, float
+
+		/* memory barriers - derived from the way the passes use the objects that compute passes write to */
+		static const int BarrierCheckInterval = 120; // frames between two barrier checks
+		struct BarrierSnapshot {
+			std::string Name;
+			GLuint Object, Copy;
+			GLenum Target;	 // GL_TEXTURE_2D, GL_TEXTURE_3D or GL_BUFFER
+			glm::ivec3 Size; // size in bytes for buffers
+		};
+		std::unordered_map<GLuint, GLbitfield> m_barrierBuffers, m_barrierTextures; // written by a dispatch -> barrier bits issued since the write
+		bool m_fullBarriers;					 // GL_ALL_BARRIER_BITS after every dispatch
+		bool m_checkingBarriers;
+		unsigned int m_barrierCheckFrame;
+		std::set<std::string> m_barrierMismatch; // objects that differed in the last check
+		void m_syncPass(PipelineItem* item);	 // issues the barrier that the pass needs before it reads the results of earlier dispatches
+		void m_markWritten(const std::vector<GLuint>& storage);
+		void m_issueBarrier(GLbitfield bits);
+		void m_checkBarriers(int width, int height); // renders the frame with the derived barriers and with GL_ALL_BARRIER_BITS, then compares the objects
+		std::vector<BarrierSnapshot> m_snapshotObjects();
+		void m_restoreSnapshot(const std::vector<BarrierSnapshot>& snapshot);
+		void m_deleteSnapshot(const std::vector<BarrierSnapshot>& snapshot);
+		void m_readObject(const BarrierSnapshot& obj, std::vector<unsigned char>& data);
+
+		/* pass culling */
+		std::set<PipelineItem*> m_culled;
+		std::vector<std::string> m_observed;
+		void m_cullPasses();
 	};
 }
\ No newline at end of file
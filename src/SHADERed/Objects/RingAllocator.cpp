@@ -0,0 +1,67 @@
+#include <SHADERed/Objects/RingAllocator.h>
+
+namespace ed {
+	RingAllocator::RingAllocator(size_t size, size_t alignment)
+	{
+		m_size = size;
+		m_alignment = alignment;
+		m_head = 0;
+	}
+
+	bool RingAllocator::Allocate(size_t size, size_t& offset)
+	{
+		size_t aligned = m_align(size);
+		if (size == 0 || aligned > m_size)
+			return false;
+
+		if (m_head + aligned > m_size)
+			m_head = 0;
+
+		// after a wrap, regions from before and after it are both in the list - every one of them has to
+		// be checked, the first live region that doesn't overlap says nothing about the ones after it
+		for (auto it = m_regions.begin(); it != m_regions.end();) {
+			bool overlaps = it->Offset < m_head + aligned && m_head < it->Offset + it->Size;
+
+			bool done = Poll(it->Fence, false);
+			if (!done && !overlaps) {
+				++it;
+				continue;
+			}
+
+			// the GPU still reads the old data
+			if (!done)
+				done = Poll(it->Fence, true);
+
+			Release(it->Fence);
+			it = m_regions.erase(it);
+
+			if (!done)
+				return false;
+		}
+
+		offset = m_head;
+		m_head += aligned;
+
+		return true;
+	}
+	void RingAllocator::Submit(size_t offset, size_t size, void* fence)
+	{
+		Region region;
+		region.Offset = offset;
+		region.Size = m_align(size);
+		region.Fence = fence;
+		m_regions.push_back(region);
+	}
+	void RingAllocator::Clear()
+	{
+		for (auto& region : m_regions)
+			Release(region.Fence);
+		m_regions.clear();
+		m_head = 0;
+	}
+
+	size_t RingAllocator::m_align(size_t size)
+	{
+		return (size + m_alignment - 1) & ~(m_alignment - 1);
+	}
+}
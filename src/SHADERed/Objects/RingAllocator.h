@@ -0,0 +1,38 @@
+#pragma once
+#include <deque>
+#include <functional>
+
+namespace ed {
+	/* hands out aligned regions of a ring buffer - a region stays in use until its fence is signaled,
+		fences are opaque here (GLsync in the StreamingUploader) and are checked through Poll/Release */
+	class RingAllocator {
+	public:
+		RingAllocator(size_t size, size_t alignment);
+
+		// true if the fence was signaled, wait -> block until it is (false only if the wait failed)
+		std::function<bool(void* fence, bool wait)> Poll;
+		std::function<void(void* fence)> Release;
+
+		// false if the region can't be used (too big or a wait failed)
+		bool Allocate(size_t size, size_t& offset);
+		void Submit(size_t offset, size_t size, void* fence);
+		void Clear(); // releases every fence, starts from the beginning again
+
+		inline size_t GetSize() { return m_size; }
+		inline size_t GetAlignment() { return m_alignment; }
+		inline size_t GetHead() { return m_head; }
+		inline size_t GetRegionCount() { return m_regions.size(); }
+
+	private:
+		struct Region {
+			size_t Offset, Size;
+			void* Fence;
+		};
+
+		size_t m_align(size_t size);
+
+		size_t m_size, m_alignment;
+		size_t m_head;
+		std::deque<Region> m_regions; // in submission order
+	};
+}
@@ -20,6 +20,104 @@ namespace ed {
 		return ret;
 	}
 
+	SPIRVParser::InstructionClass SPIRVParser::GetInstructionClass(unsigned int opcode)
+	{
+		switch (opcode) {
+		case spv::OpSNegate: case spv::OpFNegate:
+		case spv::OpIAdd: case spv::OpFAdd:
+		case spv::OpISub: case spv::OpFSub:
+		case spv::OpIMul: case spv::OpFMul:
+		case spv::OpUDiv: case spv::OpSDiv:
+		case spv::OpFDiv: case spv::OpUMod:
+		case spv::OpSRem: case spv::OpSMod:
+		case spv::OpFRem: case spv::OpFMod:
+		case spv::OpVectorTimesScalar:
+		case spv::OpMatrixTimesScalar:
+		case spv::OpVectorTimesMatrix:
+		case spv::OpMatrixTimesVector:
+		case spv::OpMatrixTimesMatrix:
+		case spv::OpOuterProduct:
+		case spv::OpDot:
+		case spv::OpIAddCarry:
+		case spv::OpISubBorrow:
+		case spv::OpUMulExtended:
+		case spv::OpSMulExtended:
+			return InstructionClass::Arithmetic;
+
+		case spv::OpShiftRightLogical:
+		case spv::OpShiftRightArithmetic:
+		case spv::OpShiftLeftLogical:
+		case spv::OpBitwiseOr:
+		case spv::OpBitwiseXor:
+		case spv::OpBitwiseAnd:
+		case spv::OpNot:
+		case spv::OpBitFieldInsert:
+		case spv::OpBitFieldSExtract:
+		case spv::OpBitFieldUExtract:
+		case spv::OpBitReverse:
+		case spv::OpBitCount:
+			return InstructionClass::Bit;
+
+		case spv::OpAny: case spv::OpAll:
+		case spv::OpIsNan: case spv::OpIsInf:
+		case spv::OpIsFinite: case spv::OpIsNormal:
+		case spv::OpSignBitSet: case spv::OpLessOrGreater:
+		case spv::OpOrdered: case spv::OpUnordered:
+		case spv::OpLogicalEqual: case spv::OpLogicalNotEqual:
+		case spv::OpLogicalOr: case spv::OpLogicalAnd:
+		case spv::OpLogicalNot: case spv::OpSelect:
+		case spv::OpIEqual: case spv::OpINotEqual:
+		case spv::OpUGreaterThan: case spv::OpSGreaterThan:
+		case spv::OpUGreaterThanEqual: case spv::OpSGreaterThanEqual:
+		case spv::OpULessThan: case spv::OpSLessThan:
+		case spv::OpULessThanEqual: case spv::OpSLessThanEqual:
+		case spv::OpFOrdEqual: case spv::OpFUnordEqual:
+		case spv::OpFOrdNotEqual: case spv::OpFUnordNotEqual:
+		case spv::OpFOrdLessThan: case spv::OpFUnordLessThan:
+		case spv::OpFOrdGreaterThan: case spv::OpFUnordGreaterThan:
+		case spv::OpFOrdLessThanEqual: case spv::OpFUnordLessThanEqual:
+		case spv::OpFOrdGreaterThanEqual: case spv::OpFUnordGreaterThanEqual:
+			return InstructionClass::Logical;
+
+		case spv::OpImageSampleImplicitLod:
+		case spv::OpImageSampleExplicitLod:
+		case spv::OpImageSampleDrefImplicitLod:
+		case spv::OpImageSampleDrefExplicitLod:
+		case spv::OpImageSampleProjImplicitLod:
+		case spv::OpImageSampleProjExplicitLod:
+		case spv::OpImageSampleProjDrefImplicitLod:
+		case spv::OpImageSampleProjDrefExplicitLod:
+		case spv::OpImageFetch: case spv::OpImageGather:
+		case spv::OpImageDrefGather: case spv::OpImageRead:
+		case spv::OpImageWrite:
+			return InstructionClass::Texture;
+
+		case spv::OpDPdx:
+		case spv::OpDPdy:
+		case spv::OpFwidth:
+		case spv::OpDPdxFine:
+		case spv::OpDPdyFine:
+		case spv::OpFwidthFine:
+		case spv::OpDPdxCoarse:
+		case spv::OpDPdyCoarse:
+		case spv::OpFwidthCoarse:
+			return InstructionClass::Derivative;
+
+		case spv::OpPhi:
+		case spv::OpLoopMerge:
+		case spv::OpSelectionMerge:
+		case spv::OpLabel:
+		case spv::OpBranch:
+		case spv::OpBranchConditional:
+		case spv::OpSwitch:
+		case spv::OpKill:
+		case spv::OpReturn:
+		case spv::OpReturnValue:
+			return InstructionClass::ControlFlow;
+		}
+
+		return InstructionClass::Other;
+	}
 	void SPIRVParser::Parse(const std::vector<unsigned int>& ir)
 	{
 		Functions.clear();
@@ -223,103 +321,16 @@ namespace ed {
 				BarrierUsed = true;
 			} break;
 
-			case spv::OpSNegate: case spv::OpFNegate:
-			case spv::OpIAdd: case spv::OpFAdd:
-			case spv::OpISub: case spv::OpFSub:
-			case spv::OpIMul: case spv::OpFMul:
-			case spv::OpUDiv: case spv::OpSDiv:
-			case spv::OpFDiv: case spv::OpUMod:
-			case spv::OpSRem: case spv::OpSMod:
-			case spv::OpFRem: case spv::OpFMod:
-			case spv::OpVectorTimesScalar:
-			case spv::OpMatrixTimesScalar:
-			case spv::OpVectorTimesMatrix:
-			case spv::OpMatrixTimesVector:
-			case spv::OpMatrixTimesMatrix:
-			case spv::OpOuterProduct:
-			case spv::OpDot:
-			case spv::OpIAddCarry:
-			case spv::OpISubBorrow:
-			case spv::OpUMulExtended:
-			case spv::OpSMulExtended:
-				ArithmeticInstCount++;
-				break;
-
-				
-			case spv::OpShiftRightLogical:
-			case spv::OpShiftRightArithmetic:
-			case spv::OpShiftLeftLogical:
-			case spv::OpBitwiseOr:
-			case spv::OpBitwiseXor:
-			case spv::OpBitwiseAnd:
-			case spv::OpNot:
-			case spv::OpBitFieldInsert:
-			case spv::OpBitFieldSExtract:
-			case spv::OpBitFieldUExtract:
-			case spv::OpBitReverse:
-			case spv::OpBitCount:
-				BitInstCount++;
-				break;
-
-			case spv::OpAny: case spv::OpAll:
-			case spv::OpIsNan: case spv::OpIsInf:
-			case spv::OpIsFinite: case spv::OpIsNormal:
-			case spv::OpSignBitSet: case spv::OpLessOrGreater:
-			case spv::OpOrdered: case spv::OpUnordered:
-			case spv::OpLogicalEqual: case spv::OpLogicalNotEqual:
-			case spv::OpLogicalOr: case spv::OpLogicalAnd:
-			case spv::OpLogicalNot: case spv::OpSelect:
-			case spv::OpIEqual: case spv::OpINotEqual:
-			case spv::OpUGreaterThan: case spv::OpSGreaterThan:
-			case spv::OpUGreaterThanEqual: case spv::OpSGreaterThanEqual:
-			case spv::OpULessThan: case spv::OpSLessThan:
-			case spv::OpULessThanEqual: case spv::OpSLessThanEqual:
-			case spv::OpFOrdEqual: case spv::OpFUnordEqual:
-			case spv::OpFOrdNotEqual: case spv::OpFUnordNotEqual:
-			case spv::OpFOrdLessThan: case spv::OpFUnordLessThan:
-			case spv::OpFOrdGreaterThan: case spv::OpFUnordGreaterThan:
-			case spv::OpFOrdLessThanEqual: case spv::OpFUnordLessThanEqual:
-			case spv::OpFOrdGreaterThanEqual: case spv::OpFUnordGreaterThanEqual:
-				LogicalInstCount++;
-				break;
-
-			case spv::OpImageSampleImplicitLod:
-			case spv::OpImageSampleExplicitLod:
-			case spv::OpImageSampleDrefImplicitLod:
-			case spv::OpImageSampleDrefExplicitLod:
-			case spv::OpImageSampleProjImplicitLod:
-			case spv::OpImageSampleProjExplicitLod:
-			case spv::OpImageSampleProjDrefImplicitLod:
-			case spv::OpImageSampleProjDrefExplicitLod:
-			case spv::OpImageFetch: case spv::OpImageGather:
-			case spv::OpImageDrefGather: case spv::OpImageRead:
-			case spv::OpImageWrite:
-				TextureInstCount++;
-				break;
-
-			case spv::OpDPdx:
-			case spv::OpDPdy:
-			case spv::OpFwidth:
-			case spv::OpDPdxFine:
-			case spv::OpDPdyFine:
-			case spv::OpFwidthFine:
-			case spv::OpDPdxCoarse:
-			case spv::OpDPdyCoarse:
-			case spv::OpFwidthCoarse:
-				DerivativeInstCount++;
-				break;
-
-			case spv::OpPhi:
-			case spv::OpLoopMerge:
-			case spv::OpSelectionMerge:
-			case spv::OpLabel:
-			case spv::OpBranch:
-			case spv::OpBranchConditional:
-			case spv::OpSwitch:
-			case spv::OpKill:
-			case spv::OpReturn:
-			case spv::OpReturnValue:
-				ControlFlowInstCount++;
+			default:
+				switch (GetInstructionClass(opcode)) {
+				case InstructionClass::Arithmetic: ArithmeticInstCount++; break;
+				case InstructionClass::Bit: BitInstCount++; break;
+				case InstructionClass::Logical: LogicalInstCount++; break;
+				case InstructionClass::Texture: TextureInstCount++; break;
+				case InstructionClass::Derivative: DerivativeInstCount++; break;
+				case InstructionClass::ControlFlow: ControlFlowInstCount++; break;
+				default: break;
+				}
 				break;
 			}
 
@@ -9,6 +9,17 @@ namespace ed {
 	public:
 		void Parse(const std::vector<unsigned int>& spv);
 
+		enum class InstructionClass {
+			Arithmetic,
+			Bit,
+			Logical,
+			Texture,
+			Derivative,
+			ControlFlow,
+			Other
+		};
+		static InstructionClass GetInstructionClass(unsigned int opcode);
+
 		struct Function {
 			int LineStart;
 			int LineEnd;
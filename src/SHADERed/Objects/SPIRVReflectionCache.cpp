@@ -0,0 +1,67 @@
+#include <SHADERed/Objects/SPIRVReflectionCache.h>
+
+#include <string_view>
+
+namespace ed {
+	const size_t SPIRVReflectionCache::MaxEntries = 256;
+
+	SPIRVReflectionCache::SPIRVReflectionCache()
+	{
+		m_clock = 0;
+		m_hits = 0;
+		m_misses = 0;
+	}
+
+	std::shared_ptr<const SPIRVParser> SPIRVReflectionCache::Get(const std::vector<unsigned int>& spv)
+	{
+		size_t hash = m_hash(spv);
+
+		// cache hit
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			auto it = m_entries.find(hash);
+			if (it != m_entries.end() && it->second.SPV == spv) {
+				m_hits++;
+				it->second.LastUse = ++m_clock;
+				return it->second.Data;
+			}
+		}
+		m_misses++;
+
+		// parse outside of the lock
+		std::shared_ptr<SPIRVParser> data = std::make_shared<SPIRVParser>();
+		data->Parse(spv);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_entries.size() >= MaxEntries && m_entries.count(hash) == 0) {
+			auto oldest = m_entries.begin();
+			for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+				if (it->second.LastUse < oldest->second.LastUse)
+					oldest = it;
+			m_entries.erase(oldest);
+		}
+
+		Entry& entry = m_entries[hash]; // a colliding module is replaced
+		entry.SPV = spv;
+		entry.Data = data;
+		entry.LastUse = ++m_clock;
+
+		return data;
+	}
+
+	void SPIRVReflectionCache::Clear()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_entries.clear();
+	}
+	size_t SPIRVReflectionCache::GetEntryCount()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_entries.size();
+	}
+
+	size_t SPIRVReflectionCache::m_hash(const std::vector<unsigned int>& spv)
+	{
+		return std::hash<std::string_view>()(std::string_view((const char*)spv.data(), spv.size() * sizeof(unsigned int)));
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <SHADERed/Objects/SPIRVParser.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ed {
+	// process-wide cache of SPIRVParser results keyed by the SPIR-V content hash - every
+	// module is parsed once after it was compiled, autocomplete, auto uniforms, stats and the
+	// debugger all read the same result
+	class SPIRVReflectionCache {
+	public:
+		SPIRVReflectionCache();
+
+		static SPIRVReflectionCache& Instance()
+		{
+			static SPIRVReflectionCache ret;
+			return ret;
+		}
+
+		static const size_t MaxEntries; // least recently used modules are dropped first
+
+		// parses the module on a miss, the returned data is never modified
+		std::shared_ptr<const SPIRVParser> Get(const std::vector<unsigned int>& spv);
+
+		void Clear();
+
+		inline size_t GetHitCount() { return m_hits; }
+		inline size_t GetMissCount() { return m_misses; }
+		size_t GetEntryCount();
+
+	private:
+		struct Entry {
+			std::vector<unsigned int> SPV; // compared on a hit, hashes can collide
+			std::shared_ptr<const SPIRVParser> Data;
+			unsigned int LastUse;
+		};
+
+		size_t m_hash(const std::vector<unsigned int>& spv);
+
+		std::mutex m_mutex;
+		std::unordered_map<size_t, Entry> m_entries;
+		unsigned int m_clock;
+		std::atomic<size_t> m_hits, m_misses;
+	};
+}
@@ -0,0 +1,85 @@
+#include <SHADERed/Objects/SPIRVSpecialization.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+namespace ed {
+	bool SPIRVSpecialization::IsSpecializable(const ShaderMacro& macro)
+	{
+		if (!macro.Specialize)
+			return false;
+
+		if (strcmp(macro.Value, "true") == 0 || strcmp(macro.Value, "false") == 0)
+			return true;
+
+		const char* val = macro.Value;
+		if (*val == '-')
+			val++;
+		if (*val == 0)
+			return false;
+		for (; *val != 0; val++)
+			if (!isdigit(*val))
+				return false;
+		return true;
+	}
+	std::string SPIRVSpecialization::Declare(const std::vector<ShaderMacro>& macros, bool hlsl)
+	{
+		std::string ret = "";
+		int specID = 0;
+		for (const auto& macro : macros) {
+			if (!IsSpecializable(macro))
+				continue;
+
+			bool isBool = strcmp(macro.Value, "true") == 0 || strcmp(macro.Value, "false") == 0;
+			std::string value = macro.Active ? std::string(macro.Value) : (isBool ? "false" : "0"); // can't be undefined
+			std::string decl = std::string(isBool ? "bool " : "int ") + macro.Name + " = " + value + ";\n";
+
+			if (hlsl)
+				ret += "[[vk::constant_id(" + std::to_string(specID) + ")]] const " + decl;
+			else
+				ret += "layout(constant_id = " + std::to_string(specID) + ") const " + decl;
+			specID++;
+		}
+		return ret;
+	}
+	void SPIRVSpecialization::Apply(std::vector<unsigned int>& spv, const std::vector<ShaderMacro>& macros)
+	{
+		const unsigned int OpDecorate = 71, OpSpecConstantTrue = 48, OpSpecConstantFalse = 49, OpSpecConstant = 50;
+		const unsigned int DecorationSpecId = 1;
+
+		std::vector<const ShaderMacro*> specMacros;
+		for (const auto& macro : macros)
+			if (IsSpecializable(macro))
+				specMacros.push_back(&macro);
+		if (specMacros.empty() || spv.size() < 5)
+			return;
+
+		std::unordered_map<unsigned int, unsigned int> specIDs; // result id -> SpecId
+		for (size_t i = 5; i < spv.size();) {
+			unsigned int opcode = spv[i] & 0xFFFF;
+			unsigned int count = spv[i] >> 16;
+			if (count == 0 || i + count > spv.size())
+				return;
+
+			if (opcode == OpDecorate && count >= 4 && spv[i + 2] == DecorationSpecId)
+				specIDs[spv[i + 1]] = spv[i + 3];
+			else if ((opcode == OpSpecConstantTrue || opcode == OpSpecConstantFalse || opcode == OpSpecConstant) && count >= 3) {
+				auto it = specIDs.find(spv[i + 2]);
+				if (it != specIDs.end() && it->second < specMacros.size()) {
+					const ShaderMacro* macro = specMacros[it->second];
+
+					if (opcode == OpSpecConstant && count == 4)
+						spv[i + 3] = macro->Active ? (unsigned int)atoi(macro->Value) : 0;
+					else if (opcode != OpSpecConstant) {
+						bool value = macro->Active && strcmp(macro->Value, "true") == 0;
+						spv[i] = (count << 16) | (value ? OpSpecConstantTrue : OpSpecConstantFalse);
+					}
+				}
+			}
+
+			i += count;
+		}
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <SHADERed/Objects/ShaderMacro.h>
+
+#include <string>
+#include <vector>
+
+namespace ed {
+	/* HLSL and Vulkan GLSL: macros marked as Specialize with an int/bool value become specialization constants,
+		their SpecId is the index among such macros - changing their value only needs Apply(), not glslang */
+	class SPIRVSpecialization {
+	public:
+		static bool IsSpecializable(const ShaderMacro& macro);
+
+		// constant declarations that replace the #defines of specializable macros
+		static std::string Declare(const std::vector<ShaderMacro>& macros, bool hlsl);
+
+		// writes the current values into the spec constant defaults
+		static void Apply(std::vector<unsigned int>& spv, const std::vector<ShaderMacro>& macros);
+	};
+}
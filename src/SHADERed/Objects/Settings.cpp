@@ -34,7 +34,10 @@ namespace ed {
 		General.AutoScale = true;
 		General.Log = true;
 		General.PipeLogsToTerminal = false;
+		General.LogLevel = 1;
 		General.Tips = false;
+		General.ArchiveAssets = true;
+		General.DirectSPIRV = true;
 		DPIScale = 1.0f;
 		strcpy(General.Font, "null");
 		General.FontSize = 15;
@@ -63,6 +66,7 @@ namespace ed {
 		Debug.AutoFetch = false;
 		Debug.PrimitiveOutline = true;
 		Debug.PixelOutline = true;
+		Debug.ValidateBarriers = false;
 
 		Preview.PausedOnStartup = false;
 		Preview.SwitchLeftRightClick = false;
@@ -80,6 +84,7 @@ namespace ed {
 		Preview.ApplyFPSLimitToApp = false;
 		Preview.LostFocusLimitFPS = false;
 		Preview.MSAA = 1;
+		Preview.CullPasses = true;
 	}
 	void Settings::Load()
 	{
@@ -105,6 +110,8 @@ namespace ed {
 		General.Log = ini.GetBoolean("general", "log", false);
 		General.StreamLogs = ini.GetBoolean("general", "streamlogs", false);
 		General.PipeLogsToTerminal = ini.GetBoolean("general", "pipelogsterminal", false);
+		General.LogLevel = ini.GetInteger("general", "loglevel", 1);
+		Logger::Get().SetLevel((Logger::Level)General.LogLevel);
 		General.ReopenShaders = ini.GetBoolean("general", "reopenshaders", false);
 		General.UseExternalEditor = ini.GetBoolean("general", "useexternaleditor", false);
 		General.OpenShadersOnDblClk = ini.GetBoolean("general", "openshadersdblclk", true);
@@ -119,6 +126,8 @@ namespace ed {
 		General.StartUpTemplate = ini.Get("general", "template", "GLSL");
 		General.AutoScale = ini.GetBoolean("general", "autoscale", true);
 		General.Tips = ini.GetBoolean("general", "tips", false);
+		General.ArchiveAssets = ini.GetBoolean("general", "archiveassets", true);
+		General.DirectSPIRV = ini.GetBoolean("general", "directspirv", true);
 		DPIScale = ini.GetReal("general", "uiscale", 1.0f);
 		strcpy(General.Font, ini.Get("general", "font", "data/NotoSans.ttf").c_str());
 		General.FontSize = ini.GetInteger("general", "fontsize", 18);
@@ -148,6 +157,7 @@ namespace ed {
 		Debug.AutoFetch = ini.GetBoolean("debug", "autofetch", false);
 		Debug.PixelOutline = ini.GetBoolean("debug", "pixeloutline", true);
 		Debug.PrimitiveOutline = ini.GetBoolean("debug", "primitiveoutline", true);
+		Debug.ValidateBarriers = ini.GetBoolean("debug", "validatebarriers", false);
 
 		Preview.PausedOnStartup = ini.GetBoolean("preview", "pausedonstartup", false);
 		Preview.SwitchLeftRightClick = ini.GetBoolean("preview", "switchleftrightclick", false);
@@ -165,6 +175,7 @@ namespace ed {
 		Preview.ApplyFPSLimitToApp = ini.GetBoolean("preview", "fpslimitwholeapp", false);
 		Preview.LostFocusLimitFPS = ini.GetBoolean("preview", "fpslimitlostfocus", false);
 		Preview.MSAA = ini.GetInteger("preview", "msaa", 1);
+		Preview.CullPasses = ini.GetBoolean("preview", "cullpasses", true);
 
 		m_parseExt(ini.Get("plugins", "notloaded", ""), Plugins.NotLoaded);
 
@@ -195,6 +206,7 @@ namespace ed {
 		ini << "log=" << General.Log << std::endl;
 		ini << "streamlogs=" << General.StreamLogs << std::endl;
 		ini << "pipelogsterminal=" << General.PipeLogsToTerminal << std::endl;
+		ini << "loglevel=" << General.LogLevel << std::endl;
 		ini << "reopenshaders=" << General.ReopenShaders << std::endl;
 		ini << "useexternaleditor=" << General.UseExternalEditor << std::endl;
 		ini << "openshadersdblclk=" << General.OpenShadersOnDblClk << std::endl;
@@ -212,6 +224,8 @@ namespace ed {
 		ini << "autoscale=" << General.AutoScale << std::endl;
 		ini << "uiscale=" << DPIScale << std::endl;
 		ini << "tips=" << General.Tips << std::endl;
+		ini << "archiveassets=" << General.ArchiveAssets << std::endl;
+		ini << "directspirv=" << General.DirectSPIRV << std::endl;
 
 		ini << "hlslext=";
 		for (int i = 0; i < General.HLSLExtensions.size(); i++) {
@@ -257,6 +271,7 @@ namespace ed {
 		ini << "fpslimitwholeapp=" << Preview.ApplyFPSLimitToApp << std::endl;
 		ini << "fpslimitlostfocus=" << Preview.LostFocusLimitFPS << std::endl;
 		ini << "msaa=" << Preview.MSAA << std::endl;
+		ini << "cullpasses=" << Preview.CullPasses << std::endl;
 
 		ini << "[editor]" << std::endl;
 		ini << "smartpred=" << Editor.SmartPredictions << std::endl;
@@ -282,6 +297,7 @@ namespace ed {
 		ini << "autofetch=" << Debug.AutoFetch << std::endl;
 		ini << "pixeloutline=" << Debug.PixelOutline << std::endl;
 		ini << "primitiveoutline=" << Debug.PrimitiveOutline << std::endl;
+		ini << "validatebarriers=" << Debug.ValidateBarriers << std::endl;
 
 		ini << "[plugins]" << std::endl;
 		ini << "notloaded=";
@@ -38,11 +38,14 @@ namespace ed {
 			bool Log;
 			bool StreamLogs;
 			bool PipeLogsToTerminal;
+			int LogLevel; // Logger::Level
 			std::string StartUpTemplate;
 			char Font[SHADERED_MAX_PATH];
 			int FontSize;
 			bool AutoScale;
 			bool Tips;
+			bool ArchiveAssets; // pack textures, models and audio files into .sprjz projects
+			bool DirectSPIRV;	// load HLSL/Vulkan GLSL/plugin shaders as SPIR-V binaries (GL_ARB_gl_spirv)
 			std::vector<std::string> HLSLExtensions;
 			std::vector<std::string> VulkanGLSLExtensions;
 			std::unordered_map<std::string, std::vector<std::string>> PluginShaderExtensions;
@@ -73,6 +76,7 @@ namespace ed {
 			bool AutoFetch;
 			bool PrimitiveOutline;
 			bool PixelOutline;
+			bool ValidateBarriers; // compare the derived memory barriers with GL_ALL_BARRIER_BITS every few frames
 		} Debug;
 
 		struct strPreview {
@@ -91,11 +95,13 @@ namespace ed {
 			bool ApplyFPSLimitToApp; // apply FPSLimit to whole app, not only preview
 			bool LostFocusLimitFPS;	 // limit to 30FPS when app loses focus
 			int MSAA;				 // 1 (off), 2, 4, 8
+			bool CullPasses;		 // skip the passes whose outputs aren't used by anything
 		} Preview;
 
 		struct strProject {
 			bool FPCamera;
 			bool UseAlphaChannel;
+			bool OptimizeSPIRV; // run spirv-opt before SPIRV-Cross or GL_ARB_gl_spirv
 			glm::vec4 ClearColor;
 			std::vector<std::string> IncludePaths;
 		} Project;
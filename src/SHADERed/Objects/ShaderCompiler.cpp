@@ -1,19 +1,27 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #include <SHADERed/Engine/GLUtils.h>
+#include <SHADERed/Objects/FileCache.h>
 #include <SHADERed/Objects/HLSLFileIncluder.h>
 #include <SHADERed/Objects/Logger.h>
+#include <SHADERed/Objects/PluginManager.h>
+#include <SHADERed/Objects/SPIRVSpecialization.h>
 #include <SHADERed/Objects/Settings.h>
 #include <SHADERed/Objects/ShaderCompiler.h>
+#include <SHADERed/Objects/StartupTrace.h>
 #include <glslang/SPIRV/GlslangToSpv.h>
 #include <glslang/StandAlone/DirStackFileIncluder.h>
 #include <glslang/glslang/Public/ShaderLang.h>
 #include <SPIRVCross/spirv_cross_util.hpp>
 #include <SPIRVCross/spirv_glsl.hpp>
+#include <spirv-tools/optimizer.hpp>
 
 const TBuiltInResource DefaultTBuiltInResource = {
 	/* .MaxLights = */ 32,
@@ -124,14 +132,34 @@ const TBuiltInResource DefaultTBuiltInResource = {
 	}
 };
 
+// glslang is initialized on the first compile rather than on startup (compiles can also run on the worker threads)
+static void initGlslang()
+{
+	static std::once_flag initFlag;
+	std::call_once(initFlag, []() {
+		ed::StartupTrace::Instance().Begin("glslang");
+		bool glslangInit = glslang::InitializeProcess();
+		ed::StartupTrace::Instance().End();
+
+		if (glslangInit)
+			ed::Logger::Get().Log("Finished glslang initialization");
+		else
+			ed::Logger::Get().Log("Failed to initialize glslang", true);
+	});
+}
+
 namespace ed {
 	std::string ShaderCompiler::ConvertToGLSL(const std::vector<unsigned int>& spvIn, ShaderLanguage inLang, ShaderStage sType, bool gsUsed, MessageStack* msgs)
 	{
 		if (spvIn.empty())
 			return "";
 
+		std::vector<unsigned int> code = spvIn;
+		if (Settings::Instance().Project.OptimizeSPIRV)
+			OptimizeSPIRV(code);
+
 		// Read SPIR-V
-		spirv_cross::CompilerGLSL glsl(std::move(spvIn));
+		spirv_cross::CompilerGLSL glsl(std::move(code));
 
 		// Set options
 		spirv_cross::CompilerGLSL::Options options;
@@ -321,26 +349,25 @@ namespace ed {
 			source = project->LoadProjectFile(filename);
 		else {
 			//Load source into a string
-			std::ifstream file(filename);
-
-			if (!file.is_open()) {
+			if (!FileCache::Instance().Read(filename, source)) {
 				if (msgs != nullptr)
 					msgs->Add(MessageStack::Type::Error, msgs->CurrentItem, "Failed to open file " + filename, -1, sType);
-				file.close();
 				return false;
 			}
-			source = std::string((std::istreambuf_iterator<char>(file)),
-				std::istreambuf_iterator<char>());
-
-			file.close();
 		}
 
-		return ShaderCompiler::CompileSourceToSPIRV(spvOut, inLang, filename, source, sType, entry, macros, msgs, project);	
+		// already compiled while the project was loading
+		if (project != nullptr && project->GetLoader().TakeSPIRV(inLang, filename, source, sType, entry, macros, spvOut))
+			return true;
+
+		return ShaderCompiler::CompileSourceToSPIRV(spvOut, inLang, filename, source, sType, entry, macros, msgs, project);
 	}
-	bool ShaderCompiler::CompileSourceToSPIRV(std::vector<unsigned int>& spvOut, ShaderLanguage inLang, const std::string& filename, const std::string& source, ShaderStage sType, const std::string& entry, std::vector<ShaderMacro>& macros, MessageStack* msgs, ProjectParser* project)
+	bool ShaderCompiler::CompileSourceToSPIRV(std::vector<unsigned int>& spvOut, ShaderLanguage inLang, const std::string& filename, const std::string& source, ShaderStage sType, const std::string& entry, std::vector<ShaderMacro>& macros, MessageStack* msgs, ProjectParser* project, bool glSPIRV, const std::vector<std::string>* includePaths)
 	{
 		spvOut.clear();
 
+		initGlslang();
+
 		const char* inputStr = source.c_str();
 
 		// create shader
@@ -369,11 +396,33 @@ namespace ed {
 #endif
 		preambleStr += "#define SHADERED_VERSION " + std::to_string(SHADERED_VERSION) + "\n";
 
+		std::string specDecls = "";
+		if (inLang != ShaderLanguage::GLSL)
+			specDecls = SPIRVSpecialization::Declare(macros, inLang == ShaderLanguage::HLSL);
 		for (auto& macro : macros) {
+			if (inLang != ShaderLanguage::GLSL && SPIRVSpecialization::IsSpecializable(macro))
+				continue;
 			if (!macro.Active)
 				continue;
 			preambleStr += "#define " + std::string(macro.Name) + " " + std::string(macro.Value) + "\n";
 		}
+
+		// declarations are added to the source (after #version) since the preamble only survives preprocessing as macros
+		std::string specSource;
+		if (!specDecls.empty()) {
+			size_t verLoc = (inLang == ShaderLanguage::HLSL) ? std::string::npos : source.find("#version");
+			if (verLoc == std::string::npos)
+				specSource = specDecls + "#line 1\n" + source;
+			else {
+				size_t lineEnd = std::min(source.find('\n', verLoc), source.size());
+				int nextLine = std::count(source.begin(), source.begin() + lineEnd, '\n') + 2;
+
+				specSource = source.substr(0, lineEnd) + "\n" + specDecls + "#line " + std::to_string(nextLine) + "\n" + source.substr(std::min(lineEnd + 1, source.size()));
+			}
+
+			inputStr = specSource.c_str();
+			shader.setStrings(&inputStr, 1);
+		}
 		if (preambleStr.size() > 0)
 			shader.setPreamble(preambleStr.c_str());
 		
@@ -381,7 +430,7 @@ namespace ed {
 		// set up
 		int sVersion = (sType == ShaderStage::Compute) ? 430 : 330;
 		glslang::EShTargetClientVersion targetClientVersion = glslang::EShTargetOpenGL_450;
-		glslang::EShTargetLanguageVersion targetLanguageVersion = glslang::EShTargetSpv_1_5;
+		glslang::EShTargetLanguageVersion targetLanguageVersion = (glSPIRV || IsGLSPIRVSupported()) ? glslang::EShTargetSpv_1_0 : glslang::EShTargetSpv_1_5; // GL_ARB_gl_spirv only accepts SPIR-V 1.0
 
 		shader.setEnvInput(inLang == ShaderLanguage::HLSL ? glslang::EShSourceHlsl : glslang::EShSourceGlsl, shaderType, glslang::EShClientOpenGL, sVersion);
 		shader.setEnvClient(glslang::EShClientOpenGL, targetClientVersion);
@@ -395,7 +444,10 @@ namespace ed {
 		// includer
 		ed::HLSLFileIncluder includer;
 		includer.pushExternalLocalDirectory(filename.substr(0, filename.find_last_of("/\\")));
-		if (project != nullptr)
+		if (includePaths != nullptr) {
+			for (auto& str : *includePaths)
+				includer.pushExternalLocalDirectory(str);
+		} else if (project != nullptr)
 			for (auto& str : Settings::Instance().Project.IncludePaths)
 				includer.pushExternalLocalDirectory(project->GetProjectPath(str));
 
@@ -439,14 +491,185 @@ namespace ed {
 
 		spvOptions.optimizeSize = false;
 		spvOptions.disableOptimizer = true;
-		spvOptions.generateDebugInfo = true;
+		spvOptions.generateDebugInfo = !glSPIRV;
 		spvOptions.validate = true;
 
 		glslang::GlslangToSpv(*prog.getIntermediate(shaderType), spvOut, &logger, &spvOptions);
 	
 		return true;
 	}
-	IPlugin1* ShaderCompiler::GetPluginLanguageFromExtension(int* lang, const std::string& filename, const std::vector<IPlugin1*>& pls)
+	bool ShaderCompiler::PrepareGLSPIRV(std::vector<unsigned int>& spv, std::map<std::string, int>& locations, int& nextLocation, std::vector<std::string>& samplers, std::string& entry)
+	{
+		const unsigned int OpName = 5, OpEntryPoint = 15, OpDecorate = 71, OpTypeImage = 25, OpTypeSampler = 26, OpTypeSampledImage = 27, OpTypeArray = 28, OpTypePointer = 32, OpConstant = 43, OpVariable = 59;
+		const unsigned int DecorationBlock = 2, DecorationBufferBlock = 3, DecorationLocation = 30, DecorationBinding = 33;
+		const unsigned int StorageUniformConstant = 0, StorageUniform = 2, StorageBuffer = 12;
+
+		// instructions that have to be placed before the annotations end
+		static const std::set<unsigned int> preamble = { 2, 3, 4, 5, 6, 7, 8, 10, 11, 14, 15, 16, 17, 71, 72, 73, 74, 75, 317, 330, 331, 332, 5632, 5633 };
+
+		if (spv.size() < 5)
+			return false;
+
+		std::unordered_map<unsigned int, std::string> names;
+		std::unordered_map<unsigned int, unsigned int> pointers;						   // pointer type -> pointee type
+		std::unordered_map<unsigned int, std::pair<unsigned int, unsigned int>> arrays; // array type -> element type, length id
+		std::unordered_map<unsigned int, unsigned int> constants;
+		std::unordered_map<unsigned int, size_t> bindings; // id -> position of the binding number in spv
+		std::set<unsigned int> samplerTypes, storageImages, separateSamplers, uniformBlocks, bufferBlocks, located;
+		std::vector<std::pair<unsigned int, unsigned int>> uniforms, buffers; // variable, pointer type
+		size_t insertPos = 0;
+
+		for (size_t i = 5; i < spv.size();) {
+			unsigned int opcode = spv[i] & 0xFFFF;
+			unsigned int count = spv[i] >> 16;
+			if (count == 0 || i + count > spv.size())
+				return false;
+
+			const unsigned int* w = &spv[i];
+			if (opcode == OpName)
+				names[w[1]] = std::string((const char*)&w[2]);
+			else if (opcode == OpEntryPoint)
+				entry = std::string((const char*)&w[3]);
+			else if (opcode == OpDecorate) {
+				if (w[2] == DecorationLocation)
+					located.insert(w[1]);
+				else if (w[2] == DecorationBinding)
+					bindings[w[1]] = i + 3;
+				else if (w[2] == DecorationBlock)
+					uniformBlocks.insert(w[1]);
+				else if (w[2] == DecorationBufferBlock)
+					bufferBlocks.insert(w[1]);
+			} else if (opcode == OpTypeImage) {
+				if (w[7] == 2)
+					storageImages.insert(w[1]); // image load/store
+				else
+					samplerTypes.insert(w[1]);
+			} else if (opcode == OpTypeSampledImage)
+				samplerTypes.insert(w[1]);
+			else if (opcode == OpTypeSampler)
+				separateSamplers.insert(w[1]);
+			else if (opcode == OpTypeArray)
+				arrays[w[1]] = std::make_pair(w[2], w[3]);
+			else if (opcode == OpTypePointer)
+				pointers[w[1]] = w[3];
+			else if (opcode == OpConstant)
+				constants[w[2]] = w[3];
+			else if (opcode == OpVariable) {
+				if (w[3] == StorageUniformConstant)
+					uniforms.push_back(std::make_pair(w[2], w[1]));
+				else if (w[3] == StorageUniform || w[3] == StorageBuffer)
+					buffers.push_back(std::make_pair(w[2], w[1]));
+			}
+
+			if (insertPos == 0 && preamble.count(opcode) == 0)
+				insertPos = i;
+
+			i += count;
+		}
+
+		if (insertPos == 0)
+			return false;
+
+		// storage buffers are bound to their binding point, uniform buffer members are set by name - only possible with the GLSL code
+		for (const auto& buffer : buffers) {
+			unsigned int type = pointers[buffer.second];
+			while (arrays.count(type))
+				type = arrays[type].first;
+
+			if (uniformBlocks.count(type) && !bufferBlocks.count(type))
+				return false;
+			if (bindings.count(buffer.first) == 0)
+				return false;
+		}
+
+		std::vector<unsigned int> annotations;
+		for (const auto& uniform : uniforms) {
+			unsigned int id = uniform.first;
+			if (names.count(id) == 0)
+				return false;
+
+			const std::string& name = names[id];
+
+			// arrays take multiple locations
+			unsigned int type = pointers[uniform.second];
+			int size = 1;
+			while (arrays.count(type)) {
+				size *= constants[arrays[type].second];
+				type = arrays[type].first;
+			}
+
+			if (separateSamplers.count(type))
+				return false; // OpenGL only has combined image samplers
+
+			if (storageImages.count(type)) {
+				if (bindings.count(id) == 0)
+					return false; // image units are bound by their binding point
+			} else if (samplerTypes.count(type)) {
+				// texture unit == index in the sampler list
+				auto it = std::find(samplers.begin(), samplers.end(), name);
+				if (it == samplers.end())
+					it = samplers.insert(samplers.end(), name);
+
+				unsigned int unit = it - samplers.begin();
+				if (bindings.count(id))
+					spv[bindings[id]] = unit;
+				else
+					annotations.insert(annotations.end(), { (4u << 16) | OpDecorate, id, DecorationBinding, unit });
+			} else {
+				if (located.count(id))
+					return false; // explicit locations could collide with the generated ones
+
+				// same name -> same location in every shader so that the stages link
+				if (locations.count(name) == 0) {
+					locations[name] = nextLocation;
+					nextLocation += size;
+				}
+
+				annotations.insert(annotations.end(), { (4u << 16) | OpDecorate, id, DecorationLocation, (unsigned int)locations[name] });
+			}
+		}
+
+		spv.insert(spv.begin() + insertPos, annotations.begin(), annotations.end());
+
+		return true;
+	}
+	bool ShaderCompiler::IsGLSPIRVSupported()
+	{
+		return Settings::Instance().General.DirectSPIRV && GLEW_ARB_gl_spirv;
+	}
+	bool ShaderCompiler::OptimizeSPIRV(std::vector<unsigned int>& spv)
+	{
+		if (spv.empty())
+			return false;
+
+		// inlining, dead code elimination, constant folding & propagation, loop unrolling, ...
+		spvtools::Optimizer opt(GetSPIRVEnvironment(spv));
+		opt.RegisterPerformancePasses();
+
+		std::vector<unsigned int> optimized;
+		if (!opt.Run(spv.data(), spv.size(), &optimized)) {
+			Logger::Get().Log("Failed to optimize SPIR-V", true);
+			return false;
+		}
+
+		spv = std::move(optimized);
+		return true;
+	}
+	spv_target_env ShaderCompiler::GetSPIRVEnvironment(const std::vector<unsigned int>& spv)
+	{
+		if (spv.size() < 2)
+			return SPV_ENV_UNIVERSAL_1_5;
+
+		switch ((spv[1] >> 8) & 0xFFFF) { // 0x00MMmm00
+		case 0x0100: return SPV_ENV_UNIVERSAL_1_0;
+		case 0x0101: return SPV_ENV_UNIVERSAL_1_1;
+		case 0x0102: return SPV_ENV_UNIVERSAL_1_2;
+		case 0x0103: return SPV_ENV_UNIVERSAL_1_3;
+		case 0x0104: return SPV_ENV_UNIVERSAL_1_4;
+		}
+		return SPV_ENV_UNIVERSAL_1_5;
+	}
+	IPlugin1* ShaderCompiler::GetPluginLanguageFromExtension(int* lang, const std::string& filename, PluginManager* plugins)
 	{
 		std::string ext = filename.substr(filename.find_last_of('.') + 1);
 		std::string langName = "";
@@ -457,7 +680,7 @@ namespace ed {
 				break;
 			}
 
-		for (IPlugin1* pl : pls) {
+		for (IPlugin1* pl : plugins->Plugins()) {
 			int langlen = pl->CustomLanguage_GetCount();
 			for (int i = 0; i < langlen; i++) {
 				if (langName == std::string(pl->CustomLanguage_GetName(i))) {
@@ -4,15 +4,24 @@
 #include <SHADERed/Objects/ShaderLanguage.h>
 #include <SHADERed/Objects/ShaderStage.h>
 #include <SHADERed/Objects/ShaderMacro.h>
+#include <spirv-tools/libspirv.h>
+#include <map>
 #include <string>
+#include <vector>
 
 namespace ed {
 	class ShaderCompiler {
 	public:
 		static bool CompileToSPIRV(std::vector<unsigned int>& spvOut, ShaderLanguage inLang, const std::string& filename, ShaderStage shaderType, const std::string& entry, std::vector<ShaderMacro>& macros, MessageStack* msgs, ProjectParser* project);
-		static bool CompileSourceToSPIRV(std::vector<unsigned int>& spvOut, ShaderLanguage inLang, const std::string& filename, const std::string& source, ShaderStage shaderType, const std::string& entry, std::vector<ShaderMacro>& macros, MessageStack* msgs, ProjectParser* project);
+		static bool CompileSourceToSPIRV(std::vector<unsigned int>& spvOut, ShaderLanguage inLang, const std::string& filename, const std::string& source, ShaderStage shaderType, const std::string& entry, std::vector<ShaderMacro>& macros, MessageStack* msgs, ProjectParser* project, bool glSPIRV = false, const std::vector<std::string>* includePaths = nullptr); // glSPIRV: SPIR-V 1.0 without debug info, for GL_ARB_gl_spirv; includePaths: absolute, replace the project's include directories
+		// GL_ARB_gl_spirv needs explicit uniform locations and sampler bindings: same name -> same location in all stages,
+		// samplers that aren't in the list are appended to it, returns false if the SPIR-V can only be used through SPIRV-Cross
+		static bool PrepareGLSPIRV(std::vector<unsigned int>& spv, std::map<std::string, int>& locations, int& nextLocation, std::vector<std::string>& samplers, std::string& entry);
+		static bool IsGLSPIRVSupported(); // driver exposes GL_ARB_gl_spirv and the user didn't disable it
+		static bool OptimizeSPIRV(std::vector<unsigned int>& spv); // spirv-opt performance passes, spv is left untouched on failure
+		static spv_target_env GetSPIRVEnvironment(const std::vector<unsigned int>& spv); // from the module's version word - 1.0 for GL_ARB_gl_spirv, 1.5 otherwise
 		static std::string ConvertToGLSL(const std::vector<unsigned int>& spvIn, ShaderLanguage inLang, ShaderStage sType, bool gsUsed, MessageStack* msgs);
-		static IPlugin1* GetPluginLanguageFromExtension(int* lang, const std::string& filename, const std::vector<IPlugin1*>& pls);
+		static IPlugin1* GetPluginLanguageFromExtension(int* lang, const std::string& filename, PluginManager* plugins);
 		static ShaderLanguage GetShaderLanguageFromExtension(const std::string& file);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,339 @@
+#include <SHADERed/Objects/ShaderCostModel.h>
+#include <SHADERed/Objects/ObjectManager.h>
+#include <SHADERed/Objects/SPIRVParser.h>
+#include <SHADERed/Objects/SPIRVReflectionCache.h>
+#include <SHADERed/Objects/ShaderCompiler.h>
+#include <SHADERed/Engine/GeometryFactory.h>
+
+#include <spirv-tools/libspirv.h>
+#include <spirv/unified1/spirv.hpp>
+#include <spirv/unified1/GLSL.std.450.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+namespace ed {
+	const float ShaderCostModel::TextureWeight = 8.0f;
+	const float ShaderCostModel::TranscendentalWeight = 4.0f;
+	const float ShaderCostModel::LoopWeight = 8.0f;
+
+	struct CostInstruction {
+		unsigned int Opcode;
+		unsigned int Result, Type;
+		bool GLSLExtension;
+		unsigned int ExtOpcode;
+		std::vector<unsigned int> Ids;		// id operands, without the result & the result type
+		std::vector<unsigned int> Literals; // integer literals
+	};
+	spv_result_t costParseInstruction(void* userData, const spv_parsed_instruction_t* inst)
+	{
+		std::vector<CostInstruction>* insts = (std::vector<CostInstruction>*)userData;
+
+		CostInstruction ret;
+		ret.Opcode = inst->opcode;
+		ret.Result = inst->result_id;
+		ret.Type = inst->type_id;
+		ret.GLSLExtension = inst->ext_inst_type == SPV_EXT_INST_TYPE_GLSL_STD_450;
+		ret.ExtOpcode = 0;
+
+		for (uint16_t i = 0; i < inst->num_operands; i++) {
+			const spv_parsed_operand_t& op = inst->operands[i];
+			if (op.type == SPV_OPERAND_TYPE_ID)
+				ret.Ids.push_back(inst->words[op.offset]);
+			else if (op.type == SPV_OPERAND_TYPE_LITERAL_INTEGER)
+				ret.Literals.push_back(inst->words[op.offset]);
+			else if (op.type == SPV_OPERAND_TYPE_EXTENSION_INSTRUCTION_NUMBER)
+				ret.ExtOpcode = inst->words[op.offset];
+		}
+
+		insts->push_back(ret);
+		return SPV_SUCCESS;
+	}
+	bool costIsTranscendental(unsigned int extOpcode)
+	{
+		switch (extOpcode) {
+		case GLSLstd450Sin: case GLSLstd450Cos: case GLSLstd450Tan:
+		case GLSLstd450Asin: case GLSLstd450Acos: case GLSLstd450Atan:
+		case GLSLstd450Sinh: case GLSLstd450Cosh: case GLSLstd450Tanh:
+		case GLSLstd450Asinh: case GLSLstd450Acosh: case GLSLstd450Atanh:
+		case GLSLstd450Atan2: case GLSLstd450Pow:
+		case GLSLstd450Exp: case GLSLstd450Log:
+		case GLSLstd450Exp2: case GLSLstd450Log2:
+		case GLSLstd450Sqrt: case GLSLstd450InverseSqrt:
+			return true;
+		}
+		return false;
+	}
+
+	ShaderCostModel::Stage::Stage()
+	{
+		ALU = Texture = 0.0f;
+		Loops = Branches = 0;
+		MaxLoopDepth = MaxBranchDepth = 0;
+		MaxLiveValues = 0;
+	}
+
+	ShaderCostModel::Stage ShaderCostModel::AnalyzeStage(const std::vector<unsigned int>& spv)
+	{
+		Stage ret;
+		if (spv.empty())
+			return ret;
+
+		std::vector<CostInstruction> insts;
+		spv_context context = spvContextCreate(ShaderCompiler::GetSPIRVEnvironment(spv));
+		spv_result_t result = spvBinaryParse(context, &insts, spv.data(), spv.size(), nullptr, costParseInstruction, nullptr);
+		spvContextDestroy(context);
+		if (result != SPV_SUCCESS)
+			return ret;
+
+		// scalar components of each type, 0 for types that don't end up in registers
+		std::unordered_map<unsigned int, int> components;
+		std::unordered_map<unsigned int, std::pair<size_t, size_t>> functions; // id -> range of the body
+		unsigned int entry = 0, function = 0;
+		for (size_t p = 0; p < insts.size(); p++) {
+			const CostInstruction& inst = insts[p];
+			switch (inst.Opcode) {
+			case spv::OpTypeBool:
+			case spv::OpTypeInt:
+			case spv::OpTypeFloat:
+				components[inst.Result] = 1;
+				break;
+			case spv::OpTypeVector:
+				components[inst.Result] = inst.Literals.empty() ? 1 : inst.Literals[0];
+				break;
+			case spv::OpTypeMatrix:
+				components[inst.Result] = (inst.Literals.empty() ? 1 : inst.Literals[0]) * (inst.Ids.empty() ? 1 : components[inst.Ids[0]]);
+				break;
+			case spv::OpTypeVoid:
+			case spv::OpTypePointer:
+			case spv::OpTypeFunction:
+				components[inst.Result] = 0;
+				break;
+			case spv::OpEntryPoint:
+				if (entry == 0 && !inst.Ids.empty())
+					entry = inst.Ids[0];
+				break;
+			case spv::OpFunction:
+				function = inst.Result;
+				functions[function] = std::make_pair(p + 1, p + 1);
+				break;
+			case spv::OpFunctionEnd:
+				functions[function].second = p;
+				break;
+			}
+		}
+
+		if (functions.count(entry) == 0)
+			return ret;
+
+		struct FunctionCost {
+			float ALU, Texture;
+			bool Done;
+		};
+		std::unordered_map<unsigned int, FunctionCost> costs;
+
+		std::function<FunctionCost(unsigned int)> analyze = [&](unsigned int id) -> FunctionCost {
+			FunctionCost& cost = costs[id];
+			if (cost.Done || functions.count(id) == 0)
+				return cost; // recursion isn't allowed in shaders, but don't loop forever on broken modules
+			cost.ALU = cost.Texture = 0.0f;
+			cost.Done = true;
+
+			struct Construct {
+				unsigned int Merge;
+				bool Loop;
+				size_t Start;
+			};
+			std::vector<Construct> constructs;
+			std::vector<std::pair<size_t, size_t>> loops; // inner loops come first
+			int loopDepth = 0;
+
+			std::unordered_map<unsigned int, size_t> defined, lastUse;
+
+			size_t start = functions[id].first, end = functions[id].second;
+			for (size_t p = start; p < end; p++) {
+				const CostInstruction& inst = insts[p];
+
+				// structured control flow - a construct ends at its merge block
+				if (inst.Opcode == spv::OpLabel) {
+					for (size_t c = 0; c < constructs.size(); c++) {
+						if (constructs[c].Merge != inst.Result)
+							continue;
+
+						for (size_t k = constructs.size(); k > c; k--)
+							if (constructs[k - 1].Loop)
+								loops.push_back(std::make_pair(constructs[k - 1].Start, p));
+						constructs.resize(c);
+						break;
+					}
+
+					loopDepth = 0;
+					for (const auto& construct : constructs)
+						loopDepth += construct.Loop;
+				}
+
+				float weight = pow(LoopWeight, loopDepth);
+
+				if (inst.Opcode == spv::OpLoopMerge || inst.Opcode == spv::OpSelectionMerge) {
+					bool isLoop = inst.Opcode == spv::OpLoopMerge;
+					constructs.push_back({ inst.Ids.empty() ? 0 : inst.Ids[0], isLoop, p });
+
+					int depth = 0;
+					for (const auto& construct : constructs)
+						depth += construct.Loop == isLoop;
+
+					if (isLoop) {
+						ret.Loops++;
+						ret.MaxLoopDepth = std::max(ret.MaxLoopDepth, depth);
+					} else {
+						ret.Branches++;
+						ret.MaxBranchDepth = std::max(ret.MaxBranchDepth, depth);
+					}
+				} else if (inst.Opcode == spv::OpFunctionCall && !inst.Ids.empty()) {
+					FunctionCost callee = analyze(inst.Ids[0]);
+					cost.ALU += callee.ALU * weight;
+					cost.Texture += callee.Texture * weight;
+				} else if (inst.Opcode == spv::OpExtInst) {
+					if (inst.GLSLExtension)
+						cost.ALU += (costIsTranscendental(inst.ExtOpcode) ? TranscendentalWeight : 1.0f) * weight;
+				} else {
+					switch (SPIRVParser::GetInstructionClass(inst.Opcode)) {
+					case SPIRVParser::InstructionClass::Arithmetic:
+					case SPIRVParser::InstructionClass::Bit:
+					case SPIRVParser::InstructionClass::Logical:
+					case SPIRVParser::InstructionClass::Derivative:
+						cost.ALU += weight;
+						break;
+					case SPIRVParser::InstructionClass::Texture:
+						cost.Texture += TextureWeight * weight;
+						break;
+					case SPIRVParser::InstructionClass::ControlFlow:
+						if (inst.Opcode == spv::OpBranchConditional || inst.Opcode == spv::OpSwitch)
+							cost.ALU += weight;
+						break;
+					default: break;
+					}
+				}
+
+				// live ranges of the SSA values
+				for (unsigned int use : inst.Ids)
+					if (defined.count(use))
+						lastUse[use] = p;
+
+				if (inst.Result != 0 && inst.Type != 0 && inst.Opcode != spv::OpVariable) {
+					auto comp = components.find(inst.Type);
+					if (comp == components.end() || comp->second > 0) {
+						defined[inst.Result] = p;
+						lastUse[inst.Result] = p;
+					}
+				}
+			}
+
+			// values that are used inside of a loop stay alive until the loop ends
+			for (const auto& loop : loops)
+				for (auto& use : lastUse)
+					if (defined[use.first] < loop.first && use.second >= loop.first && use.second < loop.second)
+						use.second = loop.second;
+
+			std::vector<int> delta(end - start + 2, 0);
+			for (const auto& def : defined) {
+				unsigned int type = insts[def.second].Type;
+				int comps = components.count(type) ? components[type] : 1;
+				delta[def.second - start] += comps;
+				delta[lastUse[def.first] - start + 1] -= comps;
+			}
+
+			int live = 0;
+			for (int d : delta) {
+				live += d;
+				ret.MaxLiveValues = std::max(ret.MaxLiveValues, live);
+			}
+
+			return cost;
+		};
+
+		FunctionCost total = analyze(entry);
+		ret.ALU = total.ALU;
+		ret.Texture = total.Texture;
+
+		return ret;
+	}
+
+	ShaderCostModel::Pass ShaderCostModel::EstimatePass(PipelineItem* item, ObjectManager* objects, const glm::ivec2& viewport)
+	{
+		Pass ret;
+		ret.Item = item;
+		ret.Compute = false;
+		ret.Total = 0.0;
+		for (int s = 0; s < 3; s++)
+			ret.Invocations[s] = 0.0;
+
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
+
+			ret.Stages[0] = AnalyzeStage(pass->VSSPV);
+			ret.Stages[1] = AnalyzeStage(pass->PSSPV);
+			if (pass->GSUsed)
+				ret.Stages[2] = AnalyzeStage(pass->GSSPV);
+
+			glm::ivec2 rtSize = viewport;
+			RenderTextureObject* rt = pass->RTCount > 0 ? objects->GetRenderTexture(pass->RenderTextures[0]) : nullptr;
+			if (rt != nullptr)
+				rtSize = rt->CalculateSize(viewport.x, viewport.y);
+			double area = (double)rtSize.x * rtSize.y;
+
+			for (PipelineItem* child : pass->Items) {
+				if (child->Type == PipelineItem::ItemType::Geometry) {
+					pipe::GeometryItem* geo = (pipe::GeometryItem*)child->Data;
+					int instances = geo->Instanced ? geo->InstanceCount : 1;
+
+					// rectangle scale is relative to the render target size
+					double coverage = 1.0;
+					if (geo->Type == pipe::GeometryItem::Rectangle)
+						coverage = std::min(1.0, (double)std::abs(geo->Scale.x * geo->Scale.y));
+
+					ret.Invocations[0] += eng::GeometryFactory::VertexCount[geo->Type] * instances;
+					ret.Invocations[1] += area * coverage * instances;
+				} else if (child->Type == PipelineItem::ItemType::Model) {
+					pipe::Model* model = (pipe::Model*)child->Data;
+					int instances = model->Instanced ? model->InstanceCount : 1;
+
+					if (model->Data != nullptr)
+						for (const auto& mesh : model->Data->Meshes)
+							ret.Invocations[0] += mesh.Vertices.size() * instances;
+					ret.Invocations[1] += area * instances;
+				} else if (child->Type == PipelineItem::ItemType::VertexBuffer) {
+					pipe::VertexBuffer* vb = (pipe::VertexBuffer*)child->Data;
+					BufferObject* buffer = (BufferObject*)vb->Buffer;
+					if (buffer == nullptr)
+						continue;
+
+					int stride = 0;
+					for (const auto& f : objects->ParseBufferFormat(buffer->ViewFormat))
+						stride += ShaderVariable::GetSize(f, true);
+
+					if (stride != 0)
+						ret.Invocations[0] += buffer->Size / stride;
+					ret.Invocations[1] += area;
+				}
+			}
+
+			if (pass->GSUsed)
+				ret.Invocations[2] = ret.Invocations[0] / 3.0;
+		} else if (item->Type == PipelineItem::ItemType::ComputePass) {
+			pipe::ComputePass* pass = (pipe::ComputePass*)item->Data;
+			std::shared_ptr<const SPIRVParser> info = SPIRVReflectionCache::Instance().Get(pass->SPV);
+
+			ret.Compute = true;
+			ret.Stages[0] = AnalyzeStage(pass->SPV);
+			ret.Invocations[0] = (double)pass->WorkX * pass->WorkY * pass->WorkZ * info->LocalSizeX * info->LocalSizeY * info->LocalSizeZ * pass->Iterations; // indirect dispatches use the group size too
+		}
+
+		for (int s = 0; s < 3; s++)
+			ret.Total += ret.Stages[s].GetCost() * ret.Invocations[s];
+
+		return ret;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <SHADERed/Objects/PipelineItem.h>
+
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace ed {
+	class ObjectManager;
+
+	/* static cost estimates - relative units (1 = one simple ALU instruction), meant for ranking the passes and not for predicting the GPU time */
+	class ShaderCostModel {
+	public:
+		static const float TextureWeight;		 // a texture access costs this many ALU instructions
+		static const float TranscendentalWeight; // sin, pow, exp, sqrt...
+		static const float LoopWeight;			 // assumed number of iterations of every loop
+
+		struct Stage {
+			Stage();
+
+			float ALU, Texture; // instructions inside loops are multiplied by LoopWeight per nesting level, function calls by the cost of the function
+			int Loops, Branches;
+			int MaxLoopDepth, MaxBranchDepth;
+			int MaxLiveValues; // scalar components that are alive at the same time - approximates the register pressure
+
+			inline float GetCost() const { return ALU + Texture; }
+		};
+		struct Pass {
+			PipelineItem* Item;
+			bool Compute;
+			Stage Stages[3];		// vertex/compute, pixel, geometry
+			double Invocations[3];	// vertices/compute invocations, covered pixels, primitives
+			double Total;
+		};
+
+		static Stage AnalyzeStage(const std::vector<unsigned int>& spv);
+
+		// covered pixels are exact only for rectangles & screen quads - every other draw counts as a full render target
+		static Pass EstimatePass(PipelineItem* item, ObjectManager* objects, const glm::ivec2& viewport);
+	};
+}
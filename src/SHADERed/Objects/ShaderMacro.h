@@ -1,9 +1,17 @@
 #pragma once
+#include <vector>
 
 namespace ed {
 	struct ShaderMacro {
 		bool Active;
 		char Name[32];
 		char Value[512];
+		bool Specialize = false; // int/bool value lowered to a SPIR-V specialization constant
 	};
-}
\ No newline at end of file
+
+	// macro set that is compiled in the background so that switching to it doesn't need a recompile
+	struct MacroPermutation {
+		char Name[32];
+		std::vector<ShaderMacro> Macros;
+	};
+}
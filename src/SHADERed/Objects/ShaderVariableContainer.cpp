@@ -49,6 +49,23 @@ namespace ed {
 
 		m_uLocs.clear();
 
+		// SPIR-V program -> locations were assigned by the ShaderCompiler::PrepareGLSPIRV and samplers have fixed bindings
+		if (GLEW_ARB_gl_spirv) {
+			GLuint shader = 0;
+			GLsizei shaderCount = 0;
+			glGetAttachedShaders(pass, 1, &shaderCount, &shader);
+
+			GLint isBinary = GL_FALSE;
+			if (shaderCount > 0)
+				glGetShaderiv(shader, GL_SPIR_V_BINARY_ARB, &isBinary);
+
+			if (isBinary) {
+				for (const auto& loc : m_spvLocs)
+					m_uLocs[loc.first] = loc.second;
+				return;
+			}
+		}
+
 		glGetProgramiv(pass, GL_ACTIVE_UNIFORMS, &count);
 		for (GLuint i = 0; i < count; i++) {
 			GLint size;
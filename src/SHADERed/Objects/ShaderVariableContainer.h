@@ -27,6 +27,8 @@ namespace ed {
 		void UpdateUniformInfo(GLuint pass);
 		void UpdateTexture(GLuint pass, GLuint unit);
 		void UpdateTextureList(const std::string& fragShader);
+		inline void SetTextureList(const std::vector<std::string>& samplers) { m_samplers = samplers; }
+		inline void SetUniformLocations(const std::map<std::string, int>& locs) { m_spvLocs = locs; } // GL_ARB_gl_spirv programs don't have uniform names
 		void Bind(void* item = nullptr);
 		inline std::vector<ShaderVariable*>& GetVariables() { return m_vars; }
 		inline const std::vector<std::string>& GetSamplerList() { return m_samplers; }
@@ -34,6 +36,7 @@ namespace ed {
 	private:
 		std::vector<ShaderVariable*> m_vars;
 		std::map<std::string, GLint> m_uLocs;
+		std::map<std::string, int> m_spvLocs;
 		std::vector<std::string> m_samplers;
 	};
 }
\ No newline at end of file
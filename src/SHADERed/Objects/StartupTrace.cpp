@@ -0,0 +1,165 @@
+#include <SHADERed/Objects/Logger.h>
+#include <SHADERed/Objects/StartupTrace.h>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace ed {
+	StartupTrace::StartupTrace()
+	{
+		m_start = std::chrono::steady_clock::now();
+		m_enabled = false;
+		m_finished = false;
+		m_firstFrame = 0.0f;
+	}
+
+	void StartupTrace::Enable(const std::string& outputFile)
+	{
+		m_enabled = true;
+		m_output = outputFile;
+	}
+
+	void StartupTrace::Begin(const std::string& name)
+	{
+		float now = m_now();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_finished)
+			return;
+
+		size_t thread = m_threadID();
+		int depth = 0;
+		for (size_t index : m_open)
+			if (m_phases[index].Thread == thread)
+				depth++;
+
+		m_open.push_back(m_phases.size());
+		m_phases.push_back({ name, depth, false, now, 0.0f, thread });
+	}
+	void StartupTrace::End()
+	{
+		float now = m_now();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_finished)
+			return;
+
+		size_t thread = m_threadID();
+		for (int i = (int)m_open.size() - 1; i >= 0; i--) {
+			Phase& phase = m_phases[m_open[i]];
+			if (phase.Thread == thread) {
+				phase.Duration = now - phase.Start;
+				m_open.erase(m_open.begin() + i);
+				break;
+			}
+		}
+	}
+	void StartupTrace::Mark(const std::string& name)
+	{
+		float now = m_now();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_finished)
+			return;
+
+		size_t thread = m_threadID();
+		int depth = 0;
+		for (size_t index : m_open)
+			if (m_phases[index].Thread == thread)
+				depth++;
+
+		m_phases.push_back({ name, depth, true, now, 0.0f, thread });
+	}
+
+	void StartupTrace::Finish()
+	{
+		if (m_finished)
+			return;
+
+		m_firstFrame = m_now();
+		Mark("first interactive frame");
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_finished = true;
+
+		std::stringstream ttff;
+		ttff << std::fixed << std::setprecision(1) << m_firstFrame;
+		Logger::Get().Log("Time to first interactive frame: " + ttff.str() + "ms");
+
+		if (!m_enabled)
+			return;
+
+		// timeline
+		for (const auto& phase : m_phases) {
+			std::stringstream line;
+			line << std::fixed << std::setprecision(1) << "[startup] " << std::setw(8) << phase.Start << "ms ";
+			if (phase.Instant)
+				line << "          ";
+			else
+				line << std::setw(8) << phase.Duration << "ms";
+			line << " " << std::string(phase.Depth * 2 + (phase.Thread == 0 ? 0 : 2), ' ') << phase.Name;
+			if (phase.Thread != 0)
+				line << " (thread " << phase.Thread << ")";
+
+			Logger::Get().Log(line.str());
+		}
+
+		if (!m_output.empty())
+			m_writeJSON();
+	}
+
+	float StartupTrace::m_now()
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+	}
+	size_t StartupTrace::m_threadID()
+	{
+		std::thread::id id = std::this_thread::get_id();
+		for (size_t i = 0; i < m_threads.size(); i++)
+			if (m_threads[i] == id)
+				return i;
+
+		m_threads.push_back(id);
+		return m_threads.size() - 1;
+	}
+	void StartupTrace::m_writeJSON()
+	{
+		// chrome://tracing (Trace Event Format)
+		std::ofstream out(m_output);
+		if (!out.is_open()) {
+			Logger::Get().Log("Failed to write the startup trace to " + m_output, true);
+			return;
+		}
+
+		auto escape = [](const std::string& str) -> std::string {
+			std::string ret;
+			for (char c : str) {
+				if (c == '"' || c == '\\')
+					ret += '\\';
+				ret += c;
+			}
+			return ret;
+		};
+
+		out << std::fixed << std::setprecision(0);
+		out << "{\n\t\"traceEvents\": [\n";
+		for (size_t i = 0; i < m_phases.size(); i++) {
+			const Phase& phase = m_phases[i];
+
+			out << "\t\t{ \"name\": \"" << escape(phase.Name) << "\", \"pid\": 1, \"tid\": " << phase.Thread << ", \"ts\": " << phase.Start * 1000.0f;
+			if (phase.Instant)
+				out << ", \"ph\": \"i\", \"s\": \"p\" }";
+			else
+				out << ", \"ph\": \"X\", \"dur\": " << phase.Duration * 1000.0f << " }";
+
+			out << (i == m_phases.size() - 1 ? "\n" : ",\n");
+		}
+		out << "\t],\n";
+		out << std::setprecision(3);
+		out << "\t\"otherData\": { \"timeToFirstFrame\": " << m_firstFrame << " }\n";
+		out << "}\n";
+
+		Logger::Get().Log("Startup trace written to " + m_output);
+	}
+}
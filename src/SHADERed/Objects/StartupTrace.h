@@ -0,0 +1,57 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ed {
+	// timeline of the initialization phases - enabled with --trace-startup
+	class StartupTrace {
+	public:
+		StartupTrace();
+
+		static StartupTrace& Instance()
+		{
+			static StartupTrace ret;
+			return ret;
+		}
+
+		// phases are recorded even when the trace is disabled, output is only written when enabled
+		void Enable(const std::string& outputFile);
+		inline bool IsEnabled() { return m_enabled; }
+
+		// phases can be nested and started on any thread
+		void Begin(const std::string& name);
+		void End();
+		void Mark(const std::string& name);
+
+		// called after the first frame that accepts user input - logs the timeline and writes the trace file
+		void Finish();
+		inline bool IsFinished() { return m_finished; }
+		inline float GetTimeToFirstFrame() { return m_firstFrame; }
+
+	private:
+		struct Phase {
+			std::string Name;
+			int Depth;
+			bool Instant;
+			float Start, Duration; // in milliseconds
+			size_t Thread;
+		};
+
+		float m_now();
+		size_t m_threadID(); // must be called with m_mutex locked
+		void m_writeJSON();
+
+		std::chrono::time_point<std::chrono::steady_clock> m_start;
+		std::mutex m_mutex;
+		std::vector<Phase> m_phases;
+		std::vector<size_t> m_open; // indices of the phases that weren't ended yet
+		std::vector<std::thread::id> m_threads;
+
+		bool m_enabled, m_finished;
+		std::string m_output;
+		float m_firstFrame;
+	};
+}
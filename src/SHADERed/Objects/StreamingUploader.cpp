@@ -0,0 +1,230 @@
+#include <SHADERed/Objects/Logger.h>
+#include <SHADERed/Objects/StreamingUploader.h>
+
+#include <string.h>
+
+namespace ed {
+	const size_t StreamingUploader::RingSize = 8 * 1024 * 1024;
+	const size_t StreamingUploader::Alignment = 256;
+
+	size_t StreamingUploader::GetPixelSize(GLenum format, GLenum type)
+	{
+		size_t components = 0;
+		switch (format) {
+		case GL_RED:
+		case GL_RED_INTEGER: components = 1; break;
+		case GL_RG:
+		case GL_RG_INTEGER: components = 2; break;
+		case GL_RGB:
+		case GL_BGR:
+		case GL_RGB_INTEGER: components = 3; break;
+		case GL_RGBA:
+		case GL_BGRA:
+		case GL_RGBA_INTEGER: components = 4; break;
+		}
+
+		switch (type) {
+		case GL_BYTE:
+		case GL_UNSIGNED_BYTE: return components;
+		case GL_SHORT:
+		case GL_UNSIGNED_SHORT:
+		case GL_HALF_FLOAT: return components * 2;
+		case GL_INT:
+		case GL_UNSIGNED_INT:
+		case GL_FLOAT: return components * 4;
+		}
+
+		return 0;
+	}
+
+	StreamingUploader::StreamingUploader()
+			: m_allocator(RingSize, Alignment)
+	{
+		m_initialized = false;
+		m_ring = 0;
+		m_map = nullptr;
+
+		m_allocator.Poll = [&](void* fence, bool wait) -> bool {
+			return m_poll((GLsync)fence, wait);
+		};
+		m_allocator.Release = [](void* fence) {
+			glDeleteSync((GLsync)fence);
+		};
+
+		m_uploads = 0;
+		m_totalBytes = 0;
+		m_fallbacks = 0;
+		m_stalls = 0;
+		m_stallTime = 0.0f;
+
+		m_rateBytes = 0;
+		m_rate = 0.0f;
+	}
+
+	void StreamingUploader::UploadBuffer(GLuint buffer, size_t offset, size_t size, const void* data)
+	{
+		if (buffer == 0 || size == 0 || data == nullptr)
+			return;
+
+		m_count(size);
+
+		size_t ringOffset = 0;
+		char* dest = nullptr;
+		if (size <= RingSize && m_init())
+			dest = m_allocate(size, ringOffset);
+
+		if (dest == nullptr) {
+			m_fallbacks++;
+
+			glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+			glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			return;
+		}
+
+		memcpy(dest, data, size);
+
+		glBindBuffer(GL_COPY_READ_BUFFER, m_ring);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, ringOffset, offset, size);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+		m_fence(ringOffset, size);
+	}
+	void StreamingUploader::UploadTexture(GLuint texture, int x, int y, int width, int height, GLenum format, GLenum type, const void* data)
+	{
+		if (texture == 0 || width <= 0 || height <= 0 || data == nullptr)
+			return;
+
+		size_t pixelSize = GetPixelSize(format, type);
+		size_t size = pixelSize * width * height;
+
+		m_count(size);
+
+		size_t ringOffset = 0;
+		char* dest = nullptr;
+		if (size != 0 && size <= RingSize && m_init())
+			dest = m_allocate(size, ringOffset);
+
+		GLint alignment = 4;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		glBindTexture(GL_TEXTURE_2D, texture);
+		if (dest == nullptr) {
+			m_fallbacks++;
+			glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, format, type, data);
+		} else {
+			memcpy(dest, data, size);
+
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_ring);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, format, type, (const void*)ringOffset);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+			m_fence(ringOffset, size);
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+	}
+	void StreamingUploader::Release()
+	{
+		m_allocator.Clear();
+
+		if (m_ring != 0) {
+			if (m_map != nullptr) {
+				glBindBuffer(GL_COPY_WRITE_BUFFER, m_ring);
+				glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			}
+			glDeleteBuffers(1, &m_ring);
+		}
+
+		m_ring = 0;
+		m_map = nullptr;
+		m_initialized = false;
+	}
+	float StreamingUploader::GetBytesPerSecond()
+	{
+		m_count(0);
+		return m_rate;
+	}
+
+	bool StreamingUploader::m_init()
+	{
+		if (m_initialized)
+			return m_map != nullptr;
+		m_initialized = true;
+
+		if (!GLEW_ARB_buffer_storage) {
+			Logger::Get().Log("Persistently mapped buffers aren't supported - uploading the data directly");
+			return false;
+		}
+
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glGenBuffers(1, &m_ring);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_ring);
+		glBufferStorage(GL_COPY_WRITE_BUFFER, RingSize, nullptr, flags);
+		m_map = (char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, RingSize, flags);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		if (m_map == nullptr) {
+			Logger::Get().Log("Failed to map the upload ring buffer - uploading the data directly", true);
+			glDeleteBuffers(1, &m_ring);
+			m_ring = 0;
+			return false;
+		}
+
+		Logger::Get().Log("Created a " + std::to_string(RingSize / (1024 * 1024)) + " MB upload ring buffer");
+
+		return true;
+	}
+	char* StreamingUploader::m_allocate(size_t size, size_t& offset)
+	{
+		if (!m_allocator.Allocate(size, offset))
+			return nullptr;
+		return m_map + offset;
+	}
+	void StreamingUploader::m_fence(size_t offset, size_t size)
+	{
+		m_allocator.Submit(offset, size, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+	}
+	bool StreamingUploader::m_poll(GLsync fence, bool wait)
+	{
+		GLenum status = glClientWaitSync(fence, 0, 0);
+		if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+			return true;
+		if (!wait)
+			return false;
+
+		// the GPU hasn't copied the old data yet
+		eng::Timer stallTimer;
+		GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		do {
+			status = glClientWaitSync(fence, waitFlags, 1000000000);
+			waitFlags = 0;
+		} while (status == GL_TIMEOUT_EXPIRED);
+
+		m_stalls++;
+		m_stallTime += stallTimer.GetElapsedTime() * 1000.0f;
+
+		return status != GL_WAIT_FAILED;
+	}
+	void StreamingUploader::m_count(size_t size)
+	{
+		if (size != 0) {
+			m_uploads++;
+			m_totalBytes += size;
+			m_rateBytes += size;
+		}
+
+		float elapsed = m_rateTimer.GetElapsedTime();
+		if (elapsed >= 1.0f) {
+			m_rate = m_rateBytes / elapsed;
+			m_rateBytes = 0;
+			m_rateTimer.Restart();
+		}
+	}
+}
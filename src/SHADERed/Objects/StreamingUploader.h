@@ -0,0 +1,62 @@
+#pragma once
+#include <SHADERed/Engine/Timer.h>
+#include <SHADERed/Objects/RingAllocator.h>
+
+#include <GL/glew.h>
+
+namespace ed {
+	// CPU -> GPU uploads (buffer edits, keyboard & audio textures, images...) are written into a
+	// persistently mapped ring buffer and copied from there on the GPU - every region of the ring
+	// is guarded by a fence so that it isn't overwritten while a copy still reads it
+	class StreamingUploader {
+	public:
+		StreamingUploader();
+
+		static StreamingUploader& Instance()
+		{
+			static StreamingUploader ret;
+			return ret;
+		}
+
+		static const size_t RingSize;  // bigger uploads skip the ring
+		static const size_t Alignment; // start of every region in the ring
+
+		static size_t GetPixelSize(GLenum format, GLenum type); // 0 for packed/compressed formats - those are uploaded directly
+
+		// the buffer must already have at least offset+size bytes of storage
+		void UploadBuffer(GLuint buffer, size_t offset, size_t size, const void* data);
+
+		// tightly packed rows, the texture must already have storage (glTexImage2D/glTexStorage2D)
+		void UploadTexture(GLuint texture, int x, int y, int width, int height, GLenum format, GLenum type, const void* data);
+
+		void Release();
+
+		inline bool IsPersistent() { return m_map != nullptr; }
+
+		inline size_t GetUploadCount() { return m_uploads; }
+		inline size_t GetTotalBytes() { return m_totalBytes; }
+		inline size_t GetFallbackCount() { return m_fallbacks; } // uploads that didn't go through the ring
+		inline size_t GetStallCount() { return m_stalls; }		  // waits for a region that the GPU was still reading
+		inline float GetStallTime() { return m_stallTime; }		  // ms, total
+		float GetBytesPerSecond();
+
+	private:
+		bool m_init();
+		char* m_allocate(size_t size, size_t& offset);
+		void m_fence(size_t offset, size_t size);
+		bool m_poll(GLsync fence, bool wait);
+		void m_count(size_t size);
+
+		bool m_initialized;
+		GLuint m_ring;
+		char* m_map;
+		RingAllocator m_allocator;
+
+		size_t m_uploads, m_totalBytes, m_fallbacks, m_stalls;
+		float m_stallTime;
+
+		eng::Timer m_rateTimer;
+		size_t m_rateBytes;
+		float m_rate;
+	};
+}
@@ -0,0 +1,91 @@
+#include <SHADERed/Objects/ThreadPool.h>
+
+#include <algorithm>
+
+namespace ed {
+	ThreadPool::ThreadPool()
+			: m_idleRunning(0)
+			, m_stop(false)
+	{
+	}
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_cv.notify_all();
+
+		for (auto& thread : m_threads)
+			thread.join();
+	}
+	void ThreadPool::Submit(const std::function<void()>& job)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_threads.empty())
+				m_start();
+			m_jobs.push(job);
+		}
+		m_cv.notify_one();
+	}
+	void ThreadPool::SubmitIdle(const std::function<void()>& job)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_threads.empty())
+				m_start();
+			m_idleJobs.push(job);
+		}
+		m_cv.notify_one();
+	}
+	int ThreadPool::GetThreadCount()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_threads.empty())
+			m_start();
+		return m_threads.size();
+	}
+
+	void ThreadPool::m_start()
+	{
+		// leave one core for the UI/GL thread
+		int count = std::max<int>(1, (int)std::thread::hardware_concurrency() - 1);
+		for (int i = 0; i < count; i++)
+			m_threads.push_back(std::thread(&ThreadPool::m_worker, this));
+	}
+	void ThreadPool::m_worker()
+	{
+		while (true) {
+			std::function<void()> job;
+			bool isIdle = false;
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				int maxIdle = std::max<int>(1, m_threads.size() / 2);
+				m_cv.wait(lock, [&]() { return m_stop || !m_jobs.empty() || (!m_idleJobs.empty() && m_idleRunning < maxIdle); });
+
+				if (m_stop)
+					return;
+
+				isIdle = m_jobs.empty();
+				std::queue<std::function<void()>>& queue = isIdle ? m_idleJobs : m_jobs;
+				job = std::move(queue.front());
+				queue.pop();
+
+				if (isIdle)
+					m_idleRunning++;
+			}
+
+			job();
+
+			if (isIdle) {
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_idleRunning--;
+				}
+				m_cv.notify_one();
+			}
+		}
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace ed {
+	// shared pool of worker threads, threads are only started once the first job is submitted
+	class ThreadPool {
+	public:
+		ThreadPool();
+		~ThreadPool();
+
+		static ThreadPool& Instance()
+		{
+			static ThreadPool ret;
+			return ret;
+		}
+
+		void Submit(const std::function<void()>& job);
+		void SubmitIdle(const std::function<void()>& job); // low priority - only picked up when no Submit()-ed job is waiting
+
+		int GetThreadCount();
+
+	private:
+		void m_start();
+		void m_worker();
+
+		std::vector<std::thread> m_threads;
+		std::queue<std::function<void()>> m_jobs;
+		std::queue<std::function<void()>> m_idleJobs;
+		int m_idleRunning; // at most half of the threads run idle jobs so that new jobs don't have to wait
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		bool m_stop;
+	};
+}
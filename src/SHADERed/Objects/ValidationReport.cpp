@@ -0,0 +1,135 @@
+#include <SHADERed/Objects/ThreadPool.h>
+#include <SHADERed/Objects/ValidationReport.h>
+
+namespace ed {
+	static const char* stageName(ShaderStage stage)
+	{
+		switch (stage) {
+		case ShaderStage::Vertex: return "vertex";
+		case ShaderStage::Pixel: return "pixel";
+		case ShaderStage::Geometry: return "geometry";
+		case ShaderStage::Compute: return "compute";
+		case ShaderStage::Audio: return "audio";
+		default: return "plugin";
+		}
+	}
+	static const char* languageName(ShaderLanguage lang)
+	{
+		switch (lang) {
+		case ShaderLanguage::HLSL: return "hlsl";
+		case ShaderLanguage::VulkanGLSL: return "vulkan_glsl";
+		case ShaderLanguage::Plugin: return "plugin";
+		default: return "glsl";
+		}
+	}
+
+	ValidationReport::ValidationReport()
+	{
+		Time = 0.0f;
+	}
+
+	int ValidationReport::GetFailedCount()
+	{
+		int ret = 0;
+		for (const auto& proj : Projects)
+			ret += IsFailed(proj);
+		return ret;
+	}
+	int ValidationReport::GetExitCode()
+	{
+		return GetFailedCount() > 0 ? 1 : 0;
+	}
+	std::string ValidationReport::ToJSON()
+	{
+		int stageCount = 0, errorCount = 0;
+
+		std::string ret = "{\n";
+		ret += "\t\"projects\": [\n";
+		for (int p = 0; p < Projects.size(); p++) {
+			const Project& proj = Projects[p];
+
+			ret += "\t\t{\n";
+			ret += "\t\t\t\"path\": \"" + m_escape(proj.Path) + "\",\n";
+			ret += "\t\t\t\"passed\": " + std::string(IsFailed(proj) ? "false" : "true") + ",\n";
+			ret += "\t\t\t\"time\": " + std::to_string(proj.Time) + ",\n";
+			if (!proj.Error.empty()) {
+				ret += "\t\t\t\"error\": \"" + m_escape(proj.Error) + "\",\n";
+				errorCount++;
+			}
+
+			ret += "\t\t\t\"passes\": [\n";
+			for (int i = 0; i < proj.Passes.size(); i++) {
+				const Pass& pass = proj.Passes[i];
+
+				ret += "\t\t\t\t{ \"name\": \"" + m_escape(pass.Name) + "\", \"type\": \"" + pass.Type + "\", \"stages\": [\n";
+				for (int j = 0; j < pass.Stages.size(); j++) {
+					const Stage& stage = pass.Stages[j];
+					stageCount++;
+
+					ret += "\t\t\t\t\t{ \"stage\": \"" + std::string(stageName(stage.Type)) + "\", \"path\": \"" + m_escape(stage.Path) + "\", \"entry\": \"" + m_escape(stage.Entry) + "\", \"language\": \"" + languageName(stage.Language) + "\", ";
+					if (!stage.Skipped.empty())
+						ret += "\"status\": \"skipped\", \"reason\": \"" + m_escape(stage.Skipped) + "\", ";
+					else
+						ret += "\"status\": \"" + std::string(stage.Passed ? "passed" : "failed") + "\", ";
+
+					ret += "\"diagnostics\": [";
+					for (int k = 0; k < stage.Messages.size(); k++) {
+						const MessageStack::Message& msg = stage.Messages[k];
+						const char* type = msg.MType == MessageStack::Type::Error ? "error" : (msg.MType == MessageStack::Type::Warning ? "warning" : "message");
+						if (msg.MType == MessageStack::Type::Error)
+							errorCount++;
+
+						ret += "\n\t\t\t\t\t\t{ \"type\": \"" + std::string(type) + "\", \"line\": " + std::to_string(msg.Line) + ", \"message\": \"" + m_escape(msg.Text) + "\" }";
+						ret += (k == stage.Messages.size() - 1) ? "\n\t\t\t\t\t" : ",";
+					}
+					ret += "] }";
+					ret += (j == pass.Stages.size() - 1) ? "\n" : ",\n";
+				}
+				ret += "\t\t\t\t] }";
+				ret += (i == proj.Passes.size() - 1) ? "\n" : ",\n";
+			}
+			ret += "\t\t\t]\n";
+
+			ret += "\t\t}";
+			ret += (p == Projects.size() - 1) ? "\n" : ",\n";
+		}
+		ret += "\t],\n";
+
+		ret += "\t\"summary\": { \"projects\": " + std::to_string(Projects.size()) + ", \"failed\": " + std::to_string(GetFailedCount()) + ", \"stages\": " + std::to_string(stageCount) + ", \"errors\": " + std::to_string(errorCount) + ", \"threads\": " + std::to_string(ThreadPool::Instance().GetThreadCount()) + ", \"time\": " + std::to_string(Time) + " }\n";
+		ret += "}\n";
+
+		return ret;
+	}
+
+	bool ValidationReport::IsFailed(const Project& proj)
+	{
+		if (!proj.Error.empty())
+			return true;
+
+		for (const Pass& pass : proj.Passes)
+			for (const Stage& stage : pass.Stages)
+				if (stage.Skipped.empty() && !stage.Passed)
+					return true;
+
+		return false;
+	}
+
+	std::string ValidationReport::m_escape(const std::string& str)
+	{
+		std::string ret;
+		for (char c : str) {
+			if (c == '"' || c == '\\')
+				ret += '\\';
+
+			if (c == '\n')
+				ret += "\\n";
+			else if (c == '\t')
+				ret += "\\t";
+			else if ((unsigned char)c < 0x20)
+				continue;
+			else
+				ret += c;
+		}
+		return ret;
+	}
+}
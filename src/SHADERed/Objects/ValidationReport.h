@@ -0,0 +1,51 @@
+#pragma once
+#include <SHADERed/Objects/MessageStack.h>
+#include <SHADERed/Objects/ShaderLanguage.h>
+#include <SHADERed/Objects/ShaderMacro.h>
+#include <SHADERed/Objects/ShaderStage.h>
+
+#include <string>
+#include <vector>
+
+namespace ed {
+	/* results of --validate - filled by ProjectValidator, kept apart from it so that the
+		report & the exit code don't depend on glslang */
+	class ValidationReport {
+	public:
+		ValidationReport();
+
+		struct Stage {
+			ShaderStage Type;
+			ShaderLanguage Language;
+			std::string Path, Entry;
+			std::string Skipped; // reason, empty if the stage was compiled
+			bool Passed;
+			std::vector<MessageStack::Message> Messages;
+		};
+		struct Pass {
+			std::string Name;
+			std::string Type; // shader, compute, audio, plugin
+			std::vector<ShaderMacro> Macros;
+			std::vector<Stage> Stages;
+		};
+		struct Project {
+			std::string Path;
+			std::string Error; // empty if the project file could be read
+			std::vector<std::string> IncludePaths; // absolute
+			std::vector<Pass> Passes;
+			float Time; // in seconds
+		};
+
+		std::vector<Project> Projects;
+		float Time; // in seconds
+
+		static bool IsFailed(const Project& proj); // the project couldn't be read or a stage that wasn't skipped failed
+
+		int GetFailedCount(); // projects with at least one error
+		int GetExitCode();	  // 0 - every project passed, 1 - at least one failed
+		std::string ToJSON();
+
+	private:
+		std::string m_escape(const std::string& str);
+	};
+}
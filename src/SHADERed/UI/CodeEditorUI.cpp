@@ -1,6 +1,8 @@
+#include <SHADERed/Objects/FileCache.h>
 #include <SHADERed/Objects/KeyboardShortcuts.h>
 #include <SHADERed/Objects/Logger.h>
 #include <SHADERed/Objects/Names.h>
+#include <SHADERed/Objects/SPIRVReflectionCache.h>
 #include <SHADERed/Objects/Settings.h>
 #include <SHADERed/Objects/ShaderCompiler.h>
 #include <SHADERed/Objects/ThemeContainer.h>
@@ -267,11 +269,11 @@ namespace ed {
 					} else {
 						if (m_editor[i]) {
 							// add error markers if needed
-							auto msgs = m_data->Messages.GetMessages();
+							const auto& msgs = m_data->Messages.GetMessages();
 							int groupMsg = 0;
 							TextEditor::ErrorMarkers groupErrs;
 							for (int j = 0; j < msgs.size(); j++) {
-								ed::MessageStack::Message* msg = &msgs[j];
+								const ed::MessageStack::Message* msg = &msgs[j];
 
 								if (groupErrs.count(msg->Line))
 									continue;
@@ -483,11 +485,11 @@ namespace ed {
 								ps = m_editor[j]->GetText();
 							else if (m_shaderStage[j] == ShaderStage::Geometry)
 								gs = m_editor[j]->GetText();
-							m_data->Renderer.RecompileFromSource(m_items[j]->Name, vs, ps, gs);
+							m_data->Renderer.RecompileFromSourceAsync(m_items[j]->Name, vs, ps, gs);
 						} else if (m_items[j]->Type == PipelineItem::ItemType::ComputePass)
-							m_data->Renderer.RecompileFromSource(m_items[j]->Name, m_editor[j]->GetText());
+							m_data->Renderer.RecompileFromSourceAsync(m_items[j]->Name, m_editor[j]->GetText());
 						else if (m_items[j]->Type == PipelineItem::ItemType::AudioPass)
-							m_data->Renderer.RecompileFromSource(m_items[j]->Name, m_editor[j]->GetText());
+							m_data->Renderer.RecompileFromSourceAsync(m_items[j]->Name, m_editor[j]->GetText());
 						else if (m_items[j]->Type == PipelineItem::ItemType::PluginItem) {
 							std::string pluginCode = m_editor[j]->GetText();
 							((pipe::PluginItemData*)m_items[j]->Data)->Owner->HandleRecompileFromSource(m_items[j]->Name, (int)m_shaderStage[j], pluginCode.c_str(), pluginCode.size());
@@ -518,11 +520,11 @@ namespace ed {
 								ps = std::string(tempText, contentLength);
 							else if (m_shaderStage[j] == ShaderStage::Geometry)
 								gs = std::string(tempText, contentLength);
-							m_data->Renderer.RecompileFromSource(m_items[j]->Name, vs, ps, gs);
+							m_data->Renderer.RecompileFromSourceAsync(m_items[j]->Name, vs, ps, gs);
 						} else if (m_items[j]->Type == PipelineItem::ItemType::ComputePass)
-							m_data->Renderer.RecompileFromSource(m_items[j]->Name, std::string(tempText, contentLength));
+							m_data->Renderer.RecompileFromSourceAsync(m_items[j]->Name, std::string(tempText, contentLength));
 						else if (m_items[j]->Type == PipelineItem::ItemType::AudioPass)
-							m_data->Renderer.RecompileFromSource(m_items[j]->Name, std::string(tempText, contentLength));
+							m_data->Renderer.RecompileFromSourceAsync(m_items[j]->Name, std::string(tempText, contentLength));
 						else if (m_items[j]->Type == PipelineItem::ItemType::PluginItem) {
 							std::string pluginCode = std::string(tempText, contentLength);
 							((pipe::PluginItemData*)m_items[j]->Data)->Owner->HandleRecompileFromSource(m_items[j]->Name, (int)m_shaderStage[j], pluginCode.c_str(), pluginCode.size());
@@ -722,25 +724,26 @@ namespace ed {
 		std::string shaderPath = "";
 		std::string shaderContent = "";
 		bool externalEditor = Settings::Instance().General.UseExternalEditor;
-		SPIRVParser spvData;
+		std::vector<unsigned int> emptySPV;
+		const std::vector<unsigned int>* spv = &emptySPV;
 
 		if (item->Type == PipelineItem::ItemType::ShaderPass) {
 			ed::pipe::ShaderPass* shader = reinterpret_cast<ed::pipe::ShaderPass*>(item->Data);
 
 			if (stage == ShaderStage::Vertex) {
 				shaderPath = shader->VSPath;
-				if (!externalEditor) spvData.Parse(shader->VSSPV);
+				spv = &shader->VSSPV;
 			} else if (stage == ShaderStage::Pixel) {
 				shaderPath = shader->PSPath;
-				if (!externalEditor) spvData.Parse(shader->PSSPV);
+				spv = &shader->PSSPV;
 			} else if (stage == ShaderStage::Geometry) {
 				shaderPath = shader->GSPath;
-				if (!externalEditor) spvData.Parse(shader->PSSPV);
+				spv = &shader->GSSPV;
 			}
 		} else if (item->Type == PipelineItem::ItemType::ComputePass) {
 			ed::pipe::ComputePass* shader = reinterpret_cast<ed::pipe::ComputePass*>(item->Data);
 			shaderPath = shader->Path;
-			if (!externalEditor) spvData.Parse(shader->SPV);
+			spv = &shader->SPV;
 		} else if (item->Type == PipelineItem::ItemType::AudioPass) {
 			ed::pipe::AudioPass* shader = reinterpret_cast<ed::pipe::AudioPass*>(item->Data);
 			shaderPath = shader->Path;
@@ -767,7 +770,7 @@ namespace ed {
 		IPlugin1* plugin = nullptr;
 		ShaderLanguage sLang = ShaderCompiler::GetShaderLanguageFromExtension(shaderPath);
 		if (sLang == ShaderLanguage::Plugin)
-			plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, shaderPath, m_data->Plugins.Plugins());
+			plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, shaderPath, &m_data->Plugins);
 
 		shaderContent = m_data->Parser.LoadFile(shaderPath);
 
@@ -829,7 +832,7 @@ namespace ed {
 			editor->SetText(shaderContent);
 			editor->ResetTextChanged();
 
-			FillAutocomplete(editor, spvData, false);
+			FillAutocomplete(editor, *SPIRVReflectionCache::Instance().Get(*spv), false);
 		} else {
 			int idMax = -1;
 			for (int i = 0; i < m_pluginEditor.size(); i++)
@@ -878,7 +881,7 @@ namespace ed {
 		IPlugin1* plugin = nullptr;
 		ShaderLanguage sLang = ShaderCompiler::GetShaderLanguageFromExtension(filepath);
 		if (sLang == ShaderLanguage::Plugin)
-			plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, filepath, m_data->Plugins.Plugins());
+			plugin = ShaderCompiler::GetPluginLanguageFromExtension(&langID, filepath, &m_data->Plugins);
 
 		m_items.push_back(item);
 		m_editorOpen.push_back(true);
@@ -932,9 +935,7 @@ namespace ed {
 				unsigned int* spv = shader->Owner->PipelineItem_GetSPIRV(shader->Type, shader->PluginData, (plugin::ShaderStage)shaderStage);
 				std::vector<unsigned int> spvVec(spv, spv + spvSize);
 
-				SPIRVParser spvData;
-				spvData.Parse(spvVec);
-				FillAutocomplete(editor, spvData, false);
+				FillAutocomplete(editor, *SPIRVReflectionCache::Instance().Get(spvVec), false);
 			}
 
 			// apply breakpoints
@@ -1417,6 +1418,7 @@ namespace ed {
 
 							std::lock_guard<std::mutex> lock(m_trackFilesMutex);
 							std::string updatedFile(paths[pathIndex] + filename);
+							FileCache::Instance().Invalidate(updatedFile);
 
 							for (int i = 0; i < allFiles.size(); i++)
 								if (allFiles[i] == updatedFile) {
@@ -1484,6 +1486,7 @@ namespace ed {
 						std::lock_guard<std::mutex> lock(m_trackFilesMutex);
 
 						std::string updatedFile(paths[dwWaitStatus - WAIT_OBJECT_0] + std::string(filename));
+						FileCache::Instance().Invalidate(updatedFile);
 
 						for (int i = 0; i < allFiles.size(); i++)
 							if (allFiles[i] == updatedFile) {
@@ -1,4 +1,8 @@
+#include <SHADERed/Objects/FileCache.h>
+#include <SHADERed/Objects/Logger.h>
+#include <SHADERed/Objects/SPIRVReflectionCache.h>
 #include <SHADERed/Objects/Settings.h>
+#include <SHADERed/Objects/StreamingUploader.h>
 #include <SHADERed/Objects/ThemeContainer.h>
 #include <SHADERed/Options.h>
 #include <SHADERed/UI/MessageOutputUI.h>
@@ -13,67 +17,109 @@ namespace ed {
 	{
 		const std::vector<MessageStack::Message>& msgs = m_data->Messages.GetMessages();
 
-		if (ImGui::BeginTable("##msg_table", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollFreezeTopRow | ImGuiTableFlags_ScrollY)) {
-			ImGui::TableSetupColumn("Shader Pass", ImGuiTableColumnFlags_WidthFixed, 120.0f);
-			ImGui::TableSetupColumn("Source", ImGuiTableColumnFlags_WidthFixed, 120.0f);
-			ImGui::TableSetupColumn("Line", ImGuiTableColumnFlags_WidthFixed, 120.0f);
-			ImGui::TableSetupColumn("Message", ImGuiTableColumnFlags_WidthStretch);
-			ImGui::TableAutoHeaders();
+		if (!ImGui::BeginTabBar("##msg_tabs"))
+			return;
 
-			int rowIndex = 0;
-			const ed::CustomColors& clrs = ThemeContainer::Instance().GetCustomStyle(Settings::Instance().Theme);
+		if (ImGui::BeginTabItem("Messages##msg_messages")) {
+			if (ImGui::BeginTable("##msg_table", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollFreezeTopRow | ImGuiTableFlags_ScrollY)) {
+				ImGui::TableSetupColumn("Shader Pass", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+				ImGui::TableSetupColumn("Source", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+				ImGui::TableSetupColumn("Line", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+				ImGui::TableSetupColumn("Message", ImGuiTableColumnFlags_WidthStretch);
+				ImGui::TableAutoHeaders();
 
-			for (int i = 0; i < msgs.size(); i++) {
-				ImGui::TableNextRow();
-
-				const MessageStack::Message* m = &msgs[i];
-
-				ImVec4 color = clrs.InfoMessage;
-				if (m->MType == MessageStack::Type::Error)
-					color = clrs.ErrorMessage;
-				else if (m->MType == MessageStack::Type::Warning)
-					color = clrs.WarningMessage;
-
-				ImGui::TableSetColumnIndex(0);
-				ImGui::PushID(i);
-				if (ImGui::Selectable(m->Group.c_str(), false, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick)) {
-					if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
-						ed::PipelineItem* pass = m_data->Pipeline.Get(m->Group.c_str());
-
-						if (pass != nullptr) {
-							CodeEditorUI* codeUI = (reinterpret_cast<CodeEditorUI*>(m_ui->Get(ViewID::Code)));
-							if (pass->Type == PipelineItem::ItemType::ShaderPass && m->Shader != ShaderStage::Count)
-								codeUI->Open(pass, m->Shader);
-							else if (pass->Type == PipelineItem::ItemType::ComputePass && m->Shader != ShaderStage::Count)
-								codeUI->Open(pass, m->Shader);
-							else if (pass->Type == PipelineItem::ItemType::AudioPass && m->Shader != ShaderStage::Count)
-								codeUI->Open(pass, m->Shader);
-							else if (pass->Type == PipelineItem::ItemType::PluginItem) {
-								pipe::PluginItemData* plData = ((pipe::PluginItemData*)pass->Data);
-								plData->Owner->PipelineItem_OpenInEditor(plData->Type, plData->PluginData);
-							}
+				int rowIndex = 0;
+				const ed::CustomColors& clrs = ThemeContainer::Instance().GetCustomStyle(Settings::Instance().Theme);
+
+				for (int i = 0; i < msgs.size(); i++) {
+					ImGui::TableNextRow();
+
+					const MessageStack::Message* m = &msgs[i];
+
+					ImVec4 color = clrs.InfoMessage;
+					if (m->MType == MessageStack::Type::Error)
+						color = clrs.ErrorMessage;
+					else if (m->MType == MessageStack::Type::Warning)
+						color = clrs.WarningMessage;
 
-							TextEditor* editor = codeUI->Get(pass, m->Shader);
-							if (editor != nullptr && m->Line != -1)
-								editor->SetCursorPosition(TextEditor::Coordinates(std::max<int>(0, m->Line - 1), 0));
+					ImGui::TableSetColumnIndex(0);
+					ImGui::PushID(i);
+					if (ImGui::Selectable(m->Group.c_str(), false, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick)) {
+						if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+							ed::PipelineItem* pass = m_data->Pipeline.Get(m->Group.c_str());
+
+							if (pass != nullptr) {
+								CodeEditorUI* codeUI = (reinterpret_cast<CodeEditorUI*>(m_ui->Get(ViewID::Code)));
+								if (pass->Type == PipelineItem::ItemType::ShaderPass && m->Shader != ShaderStage::Count)
+									codeUI->Open(pass, m->Shader);
+								else if (pass->Type == PipelineItem::ItemType::ComputePass && m->Shader != ShaderStage::Count)
+									codeUI->Open(pass, m->Shader);
+								else if (pass->Type == PipelineItem::ItemType::AudioPass && m->Shader != ShaderStage::Count)
+									codeUI->Open(pass, m->Shader);
+								else if (pass->Type == PipelineItem::ItemType::PluginItem) {
+									pipe::PluginItemData* plData = ((pipe::PluginItemData*)pass->Data);
+									plData->Owner->PipelineItem_OpenInEditor(plData->Type, plData->PluginData);
+								}
+
+								TextEditor* editor = codeUI->Get(pass, m->Shader);
+								if (editor != nullptr && m->Line != -1)
+									editor->SetCursorPosition(TextEditor::Coordinates(std::max<int>(0, m->Line - 1), 0));
+							}
 						}
 					}
+					ImGui::PopID();
+
+					ImGui::TableSetColumnIndex(1);
+					if (m->Shader != ShaderStage::Count) // TODO: array? duh
+						ImGui::Text(m->Shader == ShaderStage::Vertex ? "VS" : (m->Shader == ShaderStage::Pixel ? "PS" : (m->Shader == ShaderStage::Geometry ? "GS" : "CS")));
+
+					ImGui::TableSetColumnIndex(2);
+					if (m->Line != -1)
+						ImGui::Text(std::to_string(m->Line).c_str());
+
+					ImGui::TableSetColumnIndex(3);
+					if (m->Repeat > 1)
+						ImGui::TextColored(color, "%s (x%d)", m->Text.c_str(), m->Repeat);
+					else
+						ImGui::TextColored(color, m->Text.c_str());
 				}
-				ImGui::PopID();
 
-				ImGui::TableSetColumnIndex(1);
-				if (m->Shader != ShaderStage::Count) // TODO: array? duh
-					ImGui::Text(m->Shader == ShaderStage::Vertex ? "VS" : (m->Shader == ShaderStage::Pixel ? "PS" : (m->Shader == ShaderStage::Geometry ? "GS" : "CS")));
+				ImGui::EndTable();
+			}
 
-				ImGui::TableSetColumnIndex(2);
-				if (m->Line != -1)
-					ImGui::Text(std::to_string(m->Line).c_str());
+			ImGui::EndTabItem();
+		}
+
+		// application log (in-memory tail, doesn't read log.txt)
+		if (ImGui::BeginTabItem("Log##msg_log")) {
+			const ed::CustomColors& clrs = ThemeContainer::Instance().GetCustomStyle(Settings::Instance().Theme);
 
-				ImGui::TableSetColumnIndex(3);
-				ImGui::TextColored(color, m->Text.c_str());
+			FileCache& cache = FileCache::Instance();
+			ImGui::TextDisabled("File cache: %d file(s), %.1f KB, %.1f%% hit rate (%d hits, %d misses)", (int)cache.GetFileCount(), cache.GetTotalSize() / 1024.0f, cache.GetHitRate() * 100.0f, (int)cache.GetHitCount(), (int)cache.GetMissCount());
+
+			SPIRVReflectionCache& reflection = SPIRVReflectionCache::Instance();
+			ImGui::TextDisabled("SPIR-V reflection cache: %d module(s) (%d hits, %d misses)", (int)reflection.GetEntryCount(), (int)reflection.GetHitCount(), (int)reflection.GetMissCount());
+
+			StreamingUploader& uploader = StreamingUploader::Instance();
+			ImGui::TextDisabled("Uploads: %d (%.1f MB total, %.1f KB/s), %d direct, %d stall(s) - %.2f ms%s", (int)uploader.GetUploadCount(), uploader.GetTotalBytes() / (1024.0f * 1024.0f), uploader.GetBytesPerSecond() / 1024.0f, (int)uploader.GetFallbackCount(), (int)uploader.GetStallCount(), uploader.GetStallTime(), uploader.IsPersistent() ? "" : " (no persistent mapping)");
+
+			std::deque<std::string> tail = Logger::Get().GetTail();
+			ImGui::BeginChild("##msg_log_lines");
+			for (const auto& line : tail) {
+				if (line.find("(ERROR)") != std::string::npos)
+					ImGui::TextColored(clrs.ErrorMessage, "%s", line.c_str());
+				else if (line.find("(WARNING)") != std::string::npos)
+					ImGui::TextColored(clrs.WarningMessage, "%s", line.c_str());
+				else
+					ImGui::TextUnformatted(line.c_str());
 			}
+			if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+				ImGui::SetScrollHereY(1.0f);
+			ImGui::EndChild();
 
-			ImGui::EndTable();
+			ImGui::EndTabItem();
 		}
+
+		ImGui::EndTabBar();
 	}
 }
\ No newline at end of file
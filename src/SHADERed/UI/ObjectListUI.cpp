@@ -221,6 +221,11 @@ namespace ed {
 					if (isBuf) {
 						auto& passes = m_data->Pipeline.GetList();
 						for (int j = 0; j < passes.size(); j++) {
+							if (passes[j]->Type == PipelineItem::ItemType::ComputePass) {
+								pipe::ComputePass* cdata = (pipe::ComputePass*)passes[j]->Data;
+								if (cdata->IndirectBuffer == m_data->Objects.GetBuffer(items[i]))
+									cdata->IndirectBuffer = nullptr;
+							}
 							if (passes[j]->Type != PipelineItem::ItemType::ShaderPass)
 								continue;
 
@@ -28,6 +28,12 @@ namespace ed {
 		i.Buffer = buffer;
 		i.CachedFormat.clear();
 		i.CachedSize = 0;
+		i.RefreshRate = 0.350f;
+		i.RefreshTimer = i.RefreshRate;
+		i.Staging = 0;
+		i.StagingSize = 0;
+		i.Fence = nullptr;
+		i.ReadOffset = i.ReadSize = 0;
 		i.Plugin = plugin;
 
 		if (buffer != nullptr) {
@@ -42,6 +48,8 @@ namespace ed {
 		m_zoomDepth.push_back(0);
 		m_zoomFBO.push_back(0);
 		m_lastRTSize.push_back(glm::vec2(0.0f, 0.0f));
+
+		m_updateObserved();
 	}
 	void ObjectPreviewUI::OnEvent(const SDL_Event& e)
 	{
@@ -142,6 +150,7 @@ namespace ed {
 					} 
 					else if (item->Buffer != nullptr) {
 						BufferObject* buf = (BufferObject*)item->Buffer;
+						m_data->Objects.RequireBufferData(buf);
 
 						ImGui::Text("Format:");
 						ImGui::SameLine();
@@ -164,6 +173,8 @@ namespace ed {
 						ImGui::PopItemWidth();
 						ImGui::SameLine();
 						if (ImGui::Button("APPLY##objprev_applysize")) {
+							m_cancelReadback(*item);
+
 							int oldSize = buf->Size;
 							
 							buf->Size = item->CachedSize;
@@ -173,10 +184,9 @@ namespace ed {
 							memcpy(newData, buf->Data, std::min<int>(oldSize, buf->Size));
 							free(buf->Data);
 							buf->Data = newData;
+							buf->Dirty = true;
 
-							glBindBuffer(GL_UNIFORM_BUFFER, buf->ID);
-							glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // resize
-							glBindBuffer(GL_UNIFORM_BUFFER, 0);
+							m_data->Objects.UploadBuffer(buf); // resize
 
 							m_data->Parser.ModifyProject();
 						}
@@ -185,11 +195,11 @@ namespace ed {
 						ImGui::Text("Controls: ");
 
 						if (ImGui::Button("CLEAR##objprev_clearbuf")) {
+							m_cancelReadback(*item);
 							memset(buf->Data, 0, buf->Size);
+							buf->Dirty = true;
 
-							glBindBuffer(GL_UNIFORM_BUFFER, buf->ID);
-							glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // upload data
-							glBindBuffer(GL_UNIFORM_BUFFER, 0);
+							m_data->Objects.UploadBuffer(buf);
 
 							m_data->Parser.ModifyProject();
 						}
@@ -220,6 +230,7 @@ namespace ed {
 							if (igfd::ImGuiFileDialog::Instance()->IsOk) {
 								std::string file = igfd::ImGuiFileDialog::Instance()->GetFilepathName();
 
+								m_cancelReadback(*item);
 								if (m_dialogActionType == 0)
 									m_data->Objects.LoadBufferFromTexture(buf, file);
 								else if (m_dialogActionType == 1)
@@ -234,14 +245,20 @@ namespace ed {
 
 						ImGui::Separator();
 
-						// update buffer data every 350ms
-						ImGui::Text(buf->PreviewPaused ? "Buffer view is paused" : "Buffer view is updated every 350ms");
-						if (!buf->PreviewPaused && m_bufUpdateClock.GetElapsedTime() > 0.350f) {
-							glBindBuffer(GL_SHADER_STORAGE_BUFFER, buf->ID);
-							glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, buf->Size, buf->Data);
-							glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-							m_bufUpdateClock.Restart();
+						// only the visible rows are read back, without waiting for the GPU
+						if (buf->PreviewPaused)
+							ImGui::Text("Buffer view is paused");
+						else {
+							int refreshMs = item->RefreshRate * 1000.0f;
+							ImGui::Text("Update the visible rows every");
+							ImGui::SameLine();
+							ImGui::PushItemWidth(Settings::Instance().CalculateSize(120));
+							if (ImGui::InputInt("ms##objprev_refresh", &refreshMs, 50, 250))
+								item->RefreshRate = std::max<int>(0, refreshMs) / 1000.0f;
+							ImGui::PopItemWidth();
 						}
+						m_finishReadback(*item);
+						item->RefreshTimer += delta;
 
 						if (perRow != 0) {
 							ImGui::Separator();
@@ -271,6 +288,11 @@ namespace ed {
 							int rowMax = std::max<int>(0, std::min<int>((int)rows, rowNo + (int)floor((scrollY + contentSize.y + offsetY) / yAdvance) + 10));
 							float cursorY = ImGui::GetCursorPosY();
 
+							if (!buf->PreviewPaused && item->Fence == nullptr && item->RefreshTimer >= item->RefreshRate && rowMax > rowNo) {
+								m_requestReadback(*item, rowNo * perRow, (rowMax - rowNo) * perRow);
+								item->RefreshTimer = 0.0f;
+							}
+
 							for (int i = rowNo; i < rowMax; i++) {
 								ImGui::SetCursorPosY(cursorY + i * yAdvance);
 								ImGui::Text("%d", i+1);
@@ -281,9 +303,11 @@ namespace ed {
 
 									int dOffset = i * perRow + curColOffset;
 									if (m_drawBufferElement(i, j, (void*)(((char*)buf->Data) + dOffset), item->CachedFormat[j])) {
-										glBindBuffer(GL_UNIFORM_BUFFER, buf->ID);
-										glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // allocate 0 bytes of memory
-										glBindBuffer(GL_UNIFORM_BUFFER, 0);
+										buf->Dirty = true;
+										m_cancelReadback(*item);
+
+										// rows that aren't visible might be out of date - upload only the edited element
+										m_data->Objects.UploadBuffer(buf, dOffset, ShaderVariable::GetSize(item->CachedFormat[j], true));
 
 										m_data->Parser.ModifyProject();
 									}
@@ -417,6 +441,7 @@ namespace ed {
 			ImGui::End();
 
 			if (!item->IsOpen) {
+				m_releaseReadback(*item);
 				m_items.erase(m_items.begin() + i);
 				m_zoom.erase(m_zoom.begin() + i);
 				m_zoomColor.erase(m_zoomColor.begin() + i);
@@ -424,6 +449,8 @@ namespace ed {
 				m_zoomFBO.erase(m_zoomFBO.begin() + i);
 				m_lastRTSize.erase(m_lastRTSize.begin() + i);
 				i--;
+
+				m_updateObserved();
 			}
 		}
 
@@ -530,9 +557,96 @@ namespace ed {
 	{
 		for (int i = 0; i < m_items.size(); i++) {
 			if (m_items[i].Name == name) {
+				m_releaseReadback(m_items[i]);
 				m_items.erase(m_items.begin() + i);
 				i--;
 			}
 		}
+
+		m_updateObserved();
+	}
+	void ObjectPreviewUI::SyncBuffers()
+	{
+		for (auto& item : m_items) {
+			BufferObject* buf = (BufferObject*)item.Buffer;
+			if (buf == nullptr || buf->PreviewPaused)
+				continue;
+
+			m_cancelReadback(item);
+			m_data->Objects.RequireBufferData(buf);
+
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, buf->ID);
+			glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, buf->Size, buf->Data);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			buf->Dirty = true;
+		}
+	}
+	void ObjectPreviewUI::m_requestReadback(mItem& item, int offset, int size)
+	{
+		BufferObject* buf = (BufferObject*)item.Buffer;
+		size = std::min<int>(size, buf->Size - offset);
+		if (size <= 0)
+			return;
+
+		if (item.Staging == 0)
+			glGenBuffers(1, &item.Staging);
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, item.Staging);
+		if (item.StagingSize < size) {
+			glBufferData(GL_COPY_WRITE_BUFFER, size, NULL, GL_STREAM_READ);
+			item.StagingSize = size;
+		}
+		glBindBuffer(GL_COPY_READ_BUFFER, buf->ID);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, 0, size);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		item.ReadOffset = offset;
+		item.ReadSize = size;
+		item.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+	void ObjectPreviewUI::m_finishReadback(mItem& item)
+	{
+		if (item.Fence == nullptr)
+			return;
+
+		GLenum status = glClientWaitSync(item.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+			return; // show the last snapshot until the copy finishes
+
+		glDeleteSync(item.Fence);
+		item.Fence = nullptr;
+
+		BufferObject* buf = (BufferObject*)item.Buffer;
+		if (status == GL_WAIT_FAILED || item.ReadOffset + item.ReadSize > buf->Size)
+			return;
+
+		m_data->Objects.RequireBufferData(buf);
+		glBindBuffer(GL_COPY_READ_BUFFER, item.Staging);
+		glGetBufferSubData(GL_COPY_READ_BUFFER, 0, item.ReadSize, ((char*)buf->Data) + item.ReadOffset);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		buf->Dirty = true; // shaders might have written to the buffer
+	}
+	void ObjectPreviewUI::m_cancelReadback(mItem& item)
+	{
+		if (item.Fence != nullptr) {
+			glDeleteSync(item.Fence);
+			item.Fence = nullptr;
+		}
+	}
+	void ObjectPreviewUI::m_releaseReadback(mItem& item)
+	{
+		m_cancelReadback(item);
+		if (item.Staging != 0)
+			glDeleteBuffers(1, &item.Staging);
+		item.Staging = 0;
+		item.StagingSize = 0;
+	}
+	void ObjectPreviewUI::m_updateObserved()
+	{
+		std::vector<std::string> names;
+		for (const auto& item : m_items)
+			names.push_back(item.Name);
+		m_data->Renderer.SetObservedObjects(names);
 	}
 }
\ No newline at end of file
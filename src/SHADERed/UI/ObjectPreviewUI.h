@@ -23,9 +23,17 @@ namespace ed {
 		void Open(const std::string& name, float w, float h, unsigned int item, bool isCube = false, void* rt = nullptr, void* audio = nullptr, void* buffer = nullptr, void* plugin = nullptr);
 
 		inline bool ShouldRun() { return m_items.size() > 0; }
-		inline void CloseAll() { m_items.clear(); }
+		inline void CloseAll()
+		{
+			for (auto& item : m_items)
+				m_releaseReadback(item);
+			m_items.clear();
+			m_updateObserved();
+		}
 		void Close(const std::string& name);
 
+		void SyncBuffers(); // reads the whole buffers that are shown (and not paused) - called before saving the project
+
 	protected:
 		struct mItem {
 			std::string Name;
@@ -41,14 +49,25 @@ namespace ed {
 			void* Buffer;
 			std::vector<ShaderVariable::ValueType> CachedFormat;
 			int CachedSize;
+			float RefreshRate; // seconds between two readbacks of the visible rows
+			float RefreshTimer;
+			GLuint Staging; // visible rows are copied here on the GPU and read once the fence is signaled
+			int StagingSize;
+			GLsync Fence;
+			int ReadOffset, ReadSize;
 
 			void* Plugin;
 		};
 
 	private:
-		eng::Timer m_bufUpdateClock;
 		bool m_drawBufferElement(int row, int col, void* data, ShaderVariable::ValueType type);
 		std::vector<mItem> m_items;
+		void m_updateObserved(); // passes that write to the opened objects can't be culled
+
+		void m_requestReadback(mItem& item, int offset, int size);
+		void m_finishReadback(mItem& item);
+		void m_cancelReadback(mItem& item); // the pending result would overwrite the data that was changed on the CPU
+		void m_releaseReadback(mItem& item);
 		ed::AudioAnalyzer m_audioAnalyzer;
 		float m_samples[512], m_fft[512];
 
@@ -311,6 +311,16 @@ namespace ed {
 		ImGui::SameLine();
 		ImGui::Checkbox("##optg_autorecompile", &settings->General.AutoRecompile);
 
+		/* ARCHIVE ASSETS: */
+		ImGui::Text("Pack textures, models and audio files into .sprjz projects: ");
+		ImGui::SameLine();
+		ImGui::Checkbox("##optg_archiveassets", &settings->General.ArchiveAssets);
+
+		/* DIRECT SPIR-V: */
+		ImGui::Text("Load SPIR-V directly (GL_ARB_gl_spirv): ");
+		ImGui::SameLine();
+		ImGui::Checkbox("##optg_directspirv", &settings->General.DirectSPIRV);
+
 		/* AUTO UNIFORMS: */
 		ImGui::Text("Automatically detect and add uniforms to variable manager: ");
 		ImGui::SameLine();
@@ -584,6 +594,14 @@ namespace ed {
 		ImGui::SameLine();
 		ImGui::Checkbox("##optg_terminallogs", &settings->General.PipeLogsToTerminal);
 
+		/* LOG LEVEL: */
+		ImGui::Text("Log level: ");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(settings->CalculateSize(150));
+		if (ImGui::Combo("##optg_loglevel", &settings->General.LogLevel, " Debug\0 Info\0 Warning\0 Error\0"))
+			Logger::Get().SetLevel((Logger::Level)settings->General.LogLevel);
+		ImGui::PopItemWidth();
+
 		if (!settings->General.Log) {
 			ImGui::PopStyleVar();
 			ImGui::PopItemFlag();
@@ -859,6 +877,13 @@ namespace ed {
 		ImGui::SameLine();
 		ImGui::Checkbox("##optp_prop_pick", &settings->Preview.PropertyPick);
 
+		/* CULL PASSES: */
+		ImGui::Text("Skip passes with unused outputs: ");
+		ImGui::SameLine();
+		ImGui::Checkbox("##optp_cull_passes", &settings->Preview.CullPasses);
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Passes whose render textures, buffers and images aren't read by other passes,\nshown in the preview or in an open object preview window aren't rendered");
+
 		/* FPS LIMIT: */
 		ImGui::Text("FPS limit: ");
 		ImGui::SameLine();
@@ -937,6 +962,22 @@ namespace ed {
 		if (m_pluginRequiresRestart)
 			ImGui::Text("** restart SHADERed **");
 
+		// plugins with a manifest
+		if (m_pluginLoadedLB < m_pluginsLoaded.size()) {
+			const PluginManager::Manifest* manifest = m_data->Plugins.GetManifest(m_pluginsLoaded[m_pluginLoadedLB]);
+			if (manifest != nullptr) {
+				std::string provides = "";
+				for (const auto& lang : manifest->Languages)
+					provides += (provides.empty() ? "" : ", ") + lang.first;
+				for (const auto& item : manifest->Items)
+					provides += (provides.empty() ? "" : ", ") + item;
+				for (const auto& obj : manifest->Objects)
+					provides += (provides.empty() ? "" : ", ") + obj;
+
+				ImGui::TextWrapped("%s will be loaded when it's needed%s%s", manifest->Name.c_str(), provides.empty() ? "" : " - provides: ", provides.c_str());
+			}
+		}
+
 		ImGui::Separator();
 		ImGui::NewLine();
 		ImGui::Text("Search: ");
@@ -970,6 +1011,13 @@ namespace ed {
 		ImGui::Text("Primitive outline: ");
 		ImGui::SameLine();
 		ImGui::Checkbox("##optdbg_primitiveoutline", &settings->Debug.PrimitiveOutline);
+
+		/* VALIDATE BARRIERS: */
+		ImGui::Text("Validate memory barriers: ");
+		ImGui::SameLine();
+		ImGui::Checkbox("##optdbg_validatebarriers", &settings->Debug.ValidateBarriers);
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Every few frames, render the frame again with GL_ALL_BARRIER_BITS after each dispatch and log the objects that differ");
 	}
 	void OptionsUI::m_renderProject()
 	{
@@ -989,6 +1037,18 @@ namespace ed {
 			m_data->Parser.ModifyProject();
 		}
 
+		/* OPTIMIZE SPIR-V: */
+		ImGui::Text("Optimize SPIR-V: ");
+		ImGui::SameLine();
+		if (ImGui::Checkbox("##optpr_optspv", &settings->Project.OptimizeSPIRV)) {
+			std::vector<PipelineItem*> passes = m_data->Pipeline.GetList();
+			for (PipelineItem*& pass : passes)
+				m_data->Renderer.Recompile(pass->Name);
+			m_data->Parser.ModifyProject();
+		}
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Run spirv-opt performance passes (inlining, dead code elimination, constant folding, loop unrolling)\non the SPIR-V before it is translated to GLSL or passed to the driver. The debugger still uses the unoptimized code.");
+
 		/* CLEAR COLOR: */
 		ImGui::Text("Preview window clear color: ");
 		ImGui::SameLine();
@@ -2,6 +2,7 @@
 #include <SHADERed/Engine/GeometryFactory.h>
 #include <SHADERed/GUIManager.h>
 #include <SHADERed/Objects/Names.h>
+#include <SHADERed/Objects/SPIRVReflectionCache.h>
 #include <SHADERed/Objects/ShaderCompiler.h>
 #include <SHADERed/Objects/SystemVariableManager.h>
 #include <SHADERed/Objects/ThemeContainer.h>
@@ -190,6 +191,7 @@ namespace ed {
 				codeUI->Open(m_modalItem, ShaderStage::Compute);
 				TextEditor* editor = codeUI->Get(m_modalItem, ShaderStage::Compute);
 
+				m_data->Renderer.RequireSPIRV(m_modalItem);
 				m_data->Debugger.PrepareComputeShader(m_modalItem, m_thread[0], m_thread[1], m_thread[2]);
 				((PixelInspectUI*)m_ui->Get(ViewID::PixelInspect))->StartDebugging(editor, nullptr);
 
@@ -509,13 +511,13 @@ namespace ed {
 					m_thread[0] = m_thread[1] = m_thread[2] = 0;
 					m_computeLang = ed::ShaderCompiler::GetShaderLanguageFromExtension(pass->Path);
 
+					m_data->Renderer.RequireSPIRV(items[index]);
 					if (pass->SPV.size() > 0) {
-						SPIRVParser parser;
-						parser.Parse(pass->SPV);
+						std::shared_ptr<const SPIRVParser> parser = SPIRVReflectionCache::Instance().Get(pass->SPV);
 
-						m_localSizeX = parser.LocalSizeX;
-						m_localSizeY = parser.LocalSizeY;
-						m_localSizeZ = parser.LocalSizeZ;
+						m_localSizeX = parser->LocalSizeX;
+						m_localSizeY = parser->LocalSizeY;
+						m_localSizeZ = parser->LocalSizeZ;
 					}
 				}
 				if (!m_data->Renderer.IsPaused()) {
@@ -1411,8 +1413,11 @@ namespace ed {
 
 		ImGui::TextWrapped("Add or remove shader macros.");
 
+		bool isCompute = m_modalItem->Type == PipelineItem::ItemType::ComputePass;
+		bool isAudio = m_modalItem->Type == PipelineItem::ItemType::AudioPass;
+
 		ImGui::BeginChild("##pui_macro_table", ImVec2(0, Settings::Instance().CalculateSize(-25)));
-		ImGui::Columns(4);
+		ImGui::Columns(isAudio ? 4 : 5);
 
 		ImGui::Text("Controls");
 		ImGui::NextColumn();
@@ -1422,14 +1427,18 @@ namespace ed {
 		ImGui::NextColumn();
 		ImGui::Text("Value");
 		ImGui::NextColumn();
+		if (!isAudio) {
+			ImGui::Text("Spec. constant");
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("Lower an int/bool macro to a specialization constant (HLSL and Vulkan GLSL).\nChanging its value won't recompile the whole shader and programs\nbuilt for the previous values are reused. Can't be used in #if/#ifdef.\nInactive macros have the value 0/false.");
+			ImGui::NextColumn();
+		}
 
 		ImGui::Separator();
 
 		ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0, 0, 0, 0));
 
 		int id = 0;
-		bool isCompute = m_modalItem->Type == PipelineItem::ItemType::ComputePass;
-		bool isAudio = m_modalItem->Type == PipelineItem::ItemType::AudioPass;
 		std::vector<ShaderMacro>& els = isCompute ? ((ed::pipe::ComputePass*)m_modalItem->Data)->Macros : (isAudio ? ((ed::pipe::AudioPass*)m_modalItem->Data)->Macros : ((ed::pipe::ShaderPass*)m_modalItem->Data)->Macros);
 
 		/* EXISTING VARIABLES */
@@ -1463,8 +1472,11 @@ namespace ed {
 
 			/* ACTIVE */
 			ImGui::PushItemWidth(-ImGui::GetStyle().FramePadding.x);
-			if (ImGui::Checkbox(("##pui_mcr_act" + std::to_string(id)).c_str(), &el.Active))
+			if (ImGui::Checkbox(("##pui_mcr_act" + std::to_string(id)).c_str(), &el.Active)) {
 				m_data->Parser.ModifyProject();
+				if (el.Specialize)
+					m_data->Renderer.UpdateSpecializationConstants(m_modalItem->Name);
+			}
 			ImGui::NextColumn();
 
 			/* NAME */
@@ -1477,8 +1489,19 @@ namespace ed {
 			ImGui::PushItemWidth(-ImGui::GetStyle().FramePadding.x);
 			if (ImGui::InputText(("##mcrVal" + std::to_string(id)).c_str(), el.Value, 512))
 				m_data->Parser.ModifyProject();
+			if (el.Specialize && ImGui::IsItemDeactivatedAfterEdit())
+				m_data->Renderer.UpdateSpecializationConstants(m_modalItem->Name);
 			ImGui::NextColumn();
 
+			/* SPECIALIZE */
+			if (!isAudio) {
+				if (ImGui::Checkbox(("##pui_mcr_spec" + std::to_string(id)).c_str(), &el.Specialize)) {
+					m_data->Parser.ModifyProject();
+					m_data->Renderer.UpdateSpecializationConstants(m_modalItem->Name);
+				}
+				ImGui::NextColumn();
+			}
+
 			id++;
 		}
 
@@ -1521,11 +1544,73 @@ namespace ed {
 		ImGui::InputText(("##mcrValAdd" + std::to_string(id)).c_str(), addMacro.Value, 512);
 		ImGui::NextColumn();
 
+		/* SPECIALIZE */
+		if (!isAudio) {
+			ImGui::Checkbox(("##pui_mcrSpecAdd" + std::to_string(id)).c_str(), &addMacro.Specialize);
+			ImGui::NextColumn();
+		}
+
 		if (scrollToBottom) {
 			ImGui::SetScrollHere();
 			scrollToBottom = false;
 		}
 
+		/* PERMUTATIONS */
+		if (!isAudio) {
+			std::vector<MacroPermutation>& perms = isCompute ? ((ed::pipe::ComputePass*)m_modalItem->Data)->Permutations : ((ed::pipe::ShaderPass*)m_modalItem->Data)->Permutations;
+
+			ImGui::Columns(1);
+			ImGui::Separator();
+			ImGui::Text("Permutations");
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("Macro sets that are compiled in the background.\nApplying a compiled permutation doesn't need a recompile.");
+
+			for (int p = 0; p < perms.size(); p++) {
+				ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
+				if (ImGui::Button((UI_ICON_DELETE "##pui_perm_del" + std::to_string(p)).c_str())) {
+					perms.erase(perms.begin() + p);
+					m_data->Renderer.WarmPermutations(m_modalItem);
+					m_data->Parser.ModifyProject();
+					ImGui::PopStyleColor();
+					break;
+				}
+				ImGui::PopStyleColor();
+				ImGui::SameLine();
+				if (ImGui::Button(("Apply##pui_perm_apply" + std::to_string(p)).c_str())) {
+					m_data->Renderer.ApplyPermutation(m_modalItem, p);
+					m_data->Parser.ModifyProject();
+				}
+				ImGui::SameLine();
+				ImGui::PushItemWidth(Settings::Instance().CalculateSize(150));
+				if (ImGui::InputText(("##pui_perm_name" + std::to_string(p)).c_str(), perms[p].Name, 32))
+					m_data->Parser.ModifyProject();
+				ImGui::PopItemWidth();
+				ImGui::SameLine();
+
+				RenderEngine::PermutationState state = m_data->Renderer.GetPermutationState(m_modalItem, p);
+				if (state == RenderEngine::PermutationState::Active)
+					ImGui::Text("active");
+				else if (state == RenderEngine::PermutationState::Cached)
+					ImGui::Text("compiled");
+				else if (state == RenderEngine::PermutationState::Compiling)
+					ImGui::Text("compiling...");
+				else
+					ImGui::TextDisabled("not compiled");
+			}
+
+			if (ImGui::Button("Add current macros##pui_perm_add")) {
+				MacroPermutation perm;
+				strcpy(perm.Name, ("Permutation " + std::to_string(perms.size() + 1)).c_str());
+				perm.Macros = els;
+				perms.push_back(perm);
+
+				m_data->Renderer.WarmPermutations(m_modalItem);
+				m_data->Parser.ModifyProject();
+			}
+
+			ImGui::Text("Resident programs (all passes): %d, %.2f MB", (int)m_data->Renderer.GetPermutationCount(), m_data->Renderer.GetPermutationMemory() / (1024.0f * 1024.0f));
+		}
+
 		ImGui::EndChild();
 		ImGui::Columns(1);
 	}
@@ -1566,7 +1651,8 @@ namespace ed {
 		if (ewCount > 0)
 			ImGui::PushStyleColor(ImGuiCol_Text, ThemeContainer::Instance().GetTextEditorStyle(Settings::Instance().Theme)[(int)TextEditor::PaletteIndex::ErrorMessage]);
 
-		if (!data->Active)
+		bool culled = m_data->Renderer.IsCulled(item);
+		if (!data->Active || culled)
 			ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
 
 		ImGui::Indent(PIPELINE_SHADER_PASS_INDENT);
@@ -1593,6 +1679,8 @@ namespace ed {
 					props->Open(item);
 				}
 			}
+		if (culled && ImGui::IsItemHovered())
+			ImGui::SetTooltip("Skipped - nothing uses the outputs of this pass");
 
 		if (ImGui::BeginDragDropTarget()) {
 			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("PipelineItemPayload")) {
@@ -1746,7 +1834,7 @@ namespace ed {
 
 		ImGui::Unindent(PIPELINE_SHADER_PASS_INDENT);
 
-		if (!data->Active)
+		if (!data->Active || culled)
 			ImGui::PopStyleVar();
 
 		if (ewCount > 0)
@@ -1769,7 +1857,8 @@ namespace ed {
 			ImGui::PushStyleColor(ImGuiCol_Text, ThemeContainer::Instance().GetTextEditorStyle(Settings::Instance().Theme)[(int)TextEditor::PaletteIndex::ErrorMessage]);
 		else
 			ImGui::PushStyleColor(ImGuiCol_Text, ThemeContainer::Instance().GetCustomStyle(Settings::Instance().Theme).ComputePass);
-		if (!data->Active)
+		bool culled = m_data->Renderer.IsCulled(item);
+		if (!data->Active || culled)
 			ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
 
 
@@ -1791,10 +1880,12 @@ namespace ed {
 					props->Open(item);
 				}
 			}
+		if (culled && ImGui::IsItemHovered())
+			ImGui::SetTooltip("Skipped - nothing uses the outputs of this pass");
 		ImGui::Unindent(PIPELINE_SHADER_PASS_INDENT);
 
 
-		if (!data->Active)
+		if (!data->Active || culled)
 			ImGui::PopStyleVar();
 		ImGui::PopStyleColor();
 	}
@@ -2,6 +2,7 @@
 #include <SHADERed/Objects/Settings.h>
 #include <SHADERed/Objects/ShaderCompiler.h>
 #include <SHADERed/Objects/ArcBallCamera.h>
+#include <SHADERed/Objects/SPIRVReflectionCache.h>
 #include <SHADERed/Objects/SystemVariableManager.h>
 #include <SHADERed/UI/CodeEditorUI.h>
 #include <SHADERed/UI/Debug/FunctionStackUI.h>
@@ -91,6 +92,7 @@ namespace ed {
 					if (editor == nullptr && pixel.Pass->Type == PipelineItem::ItemType::PluginItem)
 						editor = codeUI->Get(pixel.Pass, ShaderStage::Vertex);
 
+					m_data->Renderer.RequireSPIRV(pixel.Pass);
 					m_data->Debugger.PreparePixelShader(pixel.Pass, pixel.Object);
 					m_data->Debugger.SetPixelShaderInput(pixel);
 					requestCompile = true;
@@ -129,6 +131,7 @@ namespace ed {
 						}
 						editor = codeUI->Get(pixel.Pass, ShaderStage::Vertex);
 
+						m_data->Renderer.RequireSPIRV(pixel.Pass);
 						m_data->Debugger.PrepareVertexShader(pixel.Pass, pixel.Object);
 						m_data->Debugger.SetVertexShaderInput(pixel.Pass, pixel.Vertex[i], pixel.VertexID + i, pixel.InstanceID, (BufferObject*)pixel.InstanceBuffer);
 						
@@ -175,10 +178,11 @@ namespace ed {
 					ed::ShaderLanguage lang = ed::ShaderCompiler::GetShaderLanguageFromExtension(pass->Path);
 
 					if (suggestion.WorkgroupSize.x == 0) {
-						SPIRVParser parser;
-						parser.Parse(pass->SPV);
+						m_data->Renderer.RequireSPIRV(suggestion.Item);
 
-						suggestion.WorkgroupSize = glm::ivec3(parser.LocalSizeX, parser.LocalSizeY, parser.LocalSizeZ);
+						std::shared_ptr<const SPIRVParser> parser = SPIRVReflectionCache::Instance().Get(pass->SPV);
+
+						suggestion.WorkgroupSize = glm::ivec3(parser->LocalSizeX, parser->LocalSizeY, parser->LocalSizeZ);
 					}
 
 					if (ImGui::Button(((UI_ICON_PLAY "##debug_compute_") + std::to_string(sugId)).c_str(), ImVec2(ICON_BUTTON_WIDTH, BUTTON_SIZE))) {
@@ -191,6 +195,7 @@ namespace ed {
 						codeUI->Open(suggestion.Item, ShaderStage::Compute);
 						TextEditor* editor = codeUI->Get(suggestion.Item, ShaderStage::Compute);
 
+						m_data->Renderer.RequireSPIRV(suggestion.Item);
 						m_data->Debugger.PrepareComputeShader(suggestion.Item, suggestion.Thread.x, suggestion.Thread.y, suggestion.Thread.z);
 						((PixelInspectUI*)m_ui->Get(ViewID::PixelInspect))->StartDebugging(editor, nullptr);
 					}
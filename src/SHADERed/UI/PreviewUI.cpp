@@ -878,6 +878,15 @@ namespace ed {
 			ImGui::SameLine();
 		}
 
+		int culled = m_data->Renderer.GetCulledCount();
+		if (culled > 0 && isItemListVisible) {
+			ImGui::SameLine(0, Settings::Instance().CalculateSize(20));
+			ImGui::TextDisabled("Culled: %d", culled);
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("Passes skipped in this frame because nothing uses their outputs");
+			ImGui::SameLine();
+		}
+
 		float pauseStartX = (width - ((ICON_BUTTON_WIDTH * 2) + (BUTTON_INDENT * 1))) / 2;
 		if (ImGui::GetCursorPosX() >= pauseStartX - 100)
 			ImGui::SameLine();
@@ -362,6 +362,99 @@ namespace ed {
 
 						m_data->Parser.ModifyProject();
 					}
+					ImGui::NextColumn();
+					ImGui::Separator();
+
+					/* iterations */
+					ImGui::Text("Iterations:");
+					ImGui::NextColumn();
+					ImGui::PushItemWidth(-1);
+					if (ImGui::InputInt("##pui_csiterations", &item->Iterations)) {
+						item->Iterations = std::max<int>(item->Iterations, 1);
+						m_data->Parser.ModifyProject();
+					}
+					ImGui::PopItemWidth();
+					if (ImGui::IsItemHovered())
+						ImGui::SetTooltip("Number of dispatches per frame - ping-pong pairs are swapped after each one");
+					ImGui::NextColumn();
+					ImGui::Separator();
+
+					/* indirect dispatch */
+					ImGui::Text("Indirect buffer:");
+					ImGui::NextColumn();
+
+					const auto& bufList = m_data->Objects.GetItemDataList();
+					auto& objNames = m_data->Objects.GetObjects();
+					ImGui::PushItemWidth(-1);
+					if (ImGui::BeginCombo("##pui_csindirect", ((item->IndirectBuffer == nullptr) ? "NULL" : (m_data->Objects.GetBufferNameByID(((BufferObject*)item->IndirectBuffer)->ID).c_str())))) {
+						// null element -> group size
+						if (ImGui::Selectable("NULL", item->IndirectBuffer == nullptr)) {
+							item->IndirectBuffer = nullptr;
+							m_data->Parser.ModifyProject();
+						}
+
+						for (int i = 0; i < bufList.size(); i++) {
+							if (bufList[i]->Buffer == nullptr)
+								continue;
+
+							if (ImGui::Selectable(objNames[i].c_str(), bufList[i]->Buffer == item->IndirectBuffer)) {
+								item->IndirectBuffer = bufList[i]->Buffer;
+								m_data->Parser.ModifyProject();
+							}
+						}
+
+						ImGui::EndCombo();
+					}
+					ImGui::PopItemWidth();
+					if (ImGui::IsItemHovered())
+						ImGui::SetTooltip("The number of groups is read from the first three uints of this buffer instead of the group size");
+					ImGui::NextColumn();
+					ImGui::Separator();
+
+					/* ping-pong pairs */
+					ImGui::Text("Ping-pong pairs:");
+					ImGui::NextColumn();
+
+					std::vector<std::string> storage;
+					for (const auto& name : objNames)
+						if ((m_data->Objects.IsBuffer(name) || m_data->Objects.IsImage(name) || m_data->Objects.IsImage3D(name)) && m_data->Objects.IsUniformBound(name, m_current) != -1)
+							storage.push_back(name);
+
+					int removePair = -1;
+					for (int p = 0; p < item->PingPong.size(); p++) {
+						std::string* names[2] = { &item->PingPong[p].first, &item->PingPong[p].second };
+						for (int n = 0; n < 2; n++) {
+							ImGui::PushID(p * 2 + n);
+							ImGui::PushItemWidth((ImGui::GetContentRegionAvail().x - (n == 0 ? 0 : Settings::Instance().CalculateSize(25))) / (2 - n));
+							if (ImGui::BeginCombo("##pui_cspingpong", names[n]->c_str())) {
+								for (const auto& name : storage)
+									if (ImGui::Selectable(name.c_str(), name == *names[n])) {
+										*names[n] = name;
+										m_data->Parser.ModifyProject();
+									}
+								ImGui::EndCombo();
+							}
+							ImGui::PopItemWidth();
+							ImGui::PopID();
+							ImGui::SameLine();
+						}
+
+						ImGui::PushID(p);
+						if (ImGui::Button("X##pui_csremovepair", ImVec2(-1, 0)))
+							removePair = p;
+						ImGui::PopID();
+					}
+					if (removePair != -1) {
+						item->PingPong.erase(item->PingPong.begin() + removePair);
+						m_data->Parser.ModifyProject();
+					}
+
+					if (ImGui::Button("Add pair##pui_csaddpair", ImVec2(-1, 0))) {
+						item->PingPong.push_back(std::make_pair(storage.size() > 0 ? storage[0] : "", storage.size() > 1 ? storage[1] : ""));
+						m_data->Parser.ModifyProject();
+					}
+					if (ImGui::IsItemHovered())
+						ImGui::SetTooltip("Bound buffers/images that swap their binding slots after every iteration");
 				} else if (m_current->Type == ed::PipelineItem::ItemType::AudioPass) {
 					ed::pipe::AudioPass* item = reinterpret_cast<ed::pipe::AudioPass*>(m_current->Data);
 
@@ -1,24 +1,97 @@
 #include <SHADERed/UI/Tools/StatsPage.h>
+#include <SHADERed/UI/CodeEditorUI.h>
+#include <SHADERed/GUIManager.h>
+#include <SHADERed/Objects/Logger.h>
+#include <SHADERed/Objects/ShaderCompiler.h>
 #include <SHADERed/Objects/ThemeContainer.h>
 #include <SHADERed/Objects/Settings.h>
 #include <imgui/imgui.h>
 #include <spirv-tools/libspirv.h>
 #include <spirv-tools/optimizer.hpp>
+#include <algorithm>
 
 namespace ed {
+	const int ProfileSamples = 120; // GPU time samples per variant
+
 	void StatsPage::OnEvent(const SDL_Event& e) { }
 	void StatsPage::Update(float delta)
 	{
-		ImGui::Text("Arithmetic instruction count: %d", m_info.ArithmeticInstCount);
-		ImGui::Text("Bit instruction count: %d", m_info.BitInstCount);
-		ImGui::Text("Logical instruction count: %d", m_info.LogicalInstCount);
-		ImGui::Text("Texture instruction count: %d", m_info.TextureInstCount);
-		ImGui::Text("Derivative instruction count: %d", m_info.DerivativeInstCount);
-		ImGui::Text("Control flow instruction count: %d", m_info.ControlFlowInstCount);
+		const char* classNames[] = { "Arithmetic", "Bit", "Logical", "Texture", "Derivative", "Control flow" };
+		int counts[2][6] = {
+			{ m_info->ArithmeticInstCount, m_info->BitInstCount, m_info->LogicalInstCount, m_info->TextureInstCount, m_info->DerivativeInstCount, m_info->ControlFlowInstCount },
+			{ m_infoOpt->ArithmeticInstCount, m_infoOpt->BitInstCount, m_infoOpt->LogicalInstCount, m_infoOpt->TextureInstCount, m_infoOpt->DerivativeInstCount, m_infoOpt->ControlFlowInstCount }
+		};
+		bool hasOptimized = !m_spvOpt.empty();
+
+		if (ImGui::BeginTable("##stats_table", 4, ImGuiTableFlags_Resizable)) {
+			ImGui::TableSetupColumn("Instructions", ImGuiTableColumnFlags_WidthFixed, 150.0f);
+			ImGui::TableSetupColumn("Original", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+			ImGui::TableSetupColumn("Optimized", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+			ImGui::TableSetupColumn("Change", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableAutoHeaders();
+
+			for (int i = 0; i < 6; i++) {
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::Text("%s", classNames[i]);
+				ImGui::TableSetColumnIndex(1);
+				ImGui::Text("%d", counts[0][i]);
+				ImGui::TableSetColumnIndex(2);
+				if (hasOptimized)
+					ImGui::Text("%d", counts[1][i]);
+				else
+					ImGui::TextDisabled("-");
+				ImGui::TableSetColumnIndex(3);
+				if (hasOptimized)
+					ImGui::Text("%+d", counts[1][i] - counts[0][i]);
+			}
+
+			ImGui::EndTable();
+		}
 
 		ImGui::NewLine();
 
+		m_renderCost();
+		ImGui::NewLine();
+
+		// GPU time with and without the optimizer
+		bool canProfile = m_item != nullptr && (m_item->Type == PipelineItem::ItemType::ShaderPass || m_item->Type == PipelineItem::ItemType::ComputePass);
+		if (canProfile) {
+			if (m_profileStep == 0) {
+				if (ImGui::Button("Profile"))
+					m_startProfiling();
+				if (ImGui::IsItemHovered())
+					ImGui::SetTooltip("Measure the GPU time of this pass with the SPIR-V optimizer turned off and on");
+			} else {
+				m_updateProfiling();
+
+				ImGui::Text("Profiling (%s)... %d/%d", m_profileStep == 1 ? "original" : "optimized", m_data->Renderer.GetGPUTimeSampleCount(m_item), ProfileSamples);
+				ImGui::SameLine();
+				if (ImGui::Button("Cancel"))
+					m_stopProfiling();
+				if (m_data->Renderer.IsPaused())
+					ImGui::TextDisabled("The preview is paused - the pass isn't being rendered.");
+			}
+
+			if (m_profileTime[0] >= 0.0f && m_profileTime[1] >= 0.0f) {
+				ImGui::Text("GPU time - original: %.4f ms, optimized: %.4f ms (%+.1f%%)", m_profileTime[0], m_profileTime[1], (m_profileTime[1] - m_profileTime[0]) / std::max(m_profileTime[0], 1e-6f) * 100.0f);
+			}
+
+			ImGui::NewLine();
+		}
+
+		// timing & output of two versions of this stage
+		if (m_item != nullptr && m_item->Type == PipelineItem::ItemType::ShaderPass) {
+			m_renderComparison();
+			ImGui::NewLine();
+		}
+
 		ImGui::Text("SPIR-V: ");
+		if (hasOptimized) {
+			ImGui::SameLine();
+			if (ImGui::Checkbox("Show optimized##stats_showopt", &m_showOptimized))
+				m_setDisassembly();
+		}
 		ImGui::Separator();
 		m_spirv.Render("stats");
 		ImGui::Separator();					
@@ -26,53 +99,276 @@ namespace ed {
 
 	void StatsPage::Refresh(PipelineItem* item, ShaderStage stage)
 	{
+		if (m_profileStep != 0)
+			m_stopProfiling();
+		if (m_item != item)
+			m_profileTime[0] = m_profileTime[1] = -1.0f;
+
+		m_item = item;
+		m_stage = stage;
 		m_spv.clear();
+		m_spvOpt.clear();
+		m_data->Renderer.RequireSPIRV(item);
 
 		if (item->Type == PipelineItem::ItemType::ShaderPass) {
 			pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
 
-			spvtools::SpirvTools core(SPV_ENV_UNIVERSAL_1_3);
-			std::string disassembly;
-
 			m_spv = pass->VSSPV;
 			if (stage == ShaderStage::Pixel)
 				m_spv = pass->PSSPV;
 			else if (stage == ShaderStage::Geometry)
 				m_spv = pass->GSSPV;
-
-			core.Disassemble(m_spv, &disassembly, SPV_BINARY_TO_TEXT_OPTION_INDENT | SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES);
-
-			m_spirv.SetPalette(ThemeContainer::Instance().GetTextEditorStyle(Settings::Instance().Theme));
-			m_spirv.SetText(disassembly);
 		}
 		else if (item->Type == PipelineItem::ItemType::ComputePass) {
 			pipe::ComputePass* pass = (pipe::ComputePass*)item->Data;
 
-			spvtools::SpirvTools core(SPV_ENV_UNIVERSAL_1_3);
-			std::string disassembly;
-
 			m_spv = pass->SPV;
-			core.Disassemble(m_spv, &disassembly, SPV_BINARY_TO_TEXT_OPTION_INDENT | SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES);
-
-			m_spirv.SetPalette(ThemeContainer::Instance().GetTextEditorStyle(Settings::Instance().Theme));
-			m_spirv.SetText(disassembly);
 		} else if (item->Type == PipelineItem::ItemType::PluginItem) {
 			pipe::PluginItemData* pass = (pipe::PluginItemData*)item->Data;
 
-			spvtools::SpirvTools core(SPV_ENV_UNIVERSAL_1_3);
-			std::string disassembly;
-
 			unsigned int spvSize = pass->Owner->PipelineItem_GetSPIRVSize(pass->Type, pass->PluginData, (ed::plugin::ShaderStage)stage);
 			unsigned int* spv = pass->Owner->PipelineItem_GetSPIRV(pass->Type, pass->PluginData, (ed::plugin::ShaderStage)stage); 
 
 			m_spv = std::vector<unsigned int>(spv, spv + spvSize);
-			core.Disassemble(m_spv, &disassembly, SPV_BINARY_TO_TEXT_OPTION_INDENT | SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES);
+		}
+
+		spvtools::SpirvTools core(ShaderCompiler::GetSPIRVEnvironment(m_spv));
+		m_disassembly.clear();
+		m_disassemblyOpt.clear();
+
+		m_info = m_infoOpt = SPIRVReflectionCache::Instance().Get(m_spv);
+		m_cost = ShaderCostModel::AnalyzeStage(m_spv);
 
-			m_spirv.SetPalette(ThemeContainer::Instance().GetTextEditorStyle(Settings::Instance().Theme));
-			m_spirv.SetText(disassembly);
+		if (!m_spv.empty()) {
+			core.Disassemble(m_spv, &m_disassembly, SPV_BINARY_TO_TEXT_OPTION_INDENT | SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES);
+
+			// always computed so that both versions can be compared
+			m_spvOpt = m_spv;
+			if (ShaderCompiler::OptimizeSPIRV(m_spvOpt)) {
+				core.Disassemble(m_spvOpt, &m_disassemblyOpt, SPV_BINARY_TO_TEXT_OPTION_INDENT | SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES);
+				m_infoOpt = SPIRVReflectionCache::Instance().Get(m_spvOpt);
+			} else
+				m_spvOpt.clear();
 		}
 
-		if (!m_spv.empty())
-			m_info.Parse(m_spv);
+		m_setDisassembly();
+		m_rankPasses();
+	}
+	void StatsPage::m_setDisassembly()
+	{
+		m_spirv.SetPalette(ThemeContainer::Instance().GetTextEditorStyle(Settings::Instance().Theme));
+		m_spirv.SetText((m_showOptimized && !m_spvOpt.empty()) ? m_disassemblyOpt : m_disassembly);
+	}
+
+	void StatsPage::m_renderCost()
+	{
+		ImGui::Text("Estimated cost per invocation: %.0f (ALU: %.0f, texture: %.0f)", m_cost.GetCost(), m_cost.ALU, m_cost.Texture);
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Relative units - a texture access counts as %.0f ALU instructions, sin/pow/sqrt/... as %.0f and every loop is assumed to run %.0f times", ShaderCostModel::TextureWeight, ShaderCostModel::TranscendentalWeight, ShaderCostModel::LoopWeight);
+		ImGui::Text("Loops: %d (max. nesting %d), branches: %d (max. nesting %d)", m_cost.Loops, m_cost.MaxLoopDepth, m_cost.Branches, m_cost.MaxBranchDepth);
+		ImGui::Text("Max. live values: %d", m_cost.MaxLiveValues);
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Scalar components that are alive at the same time - approximates the register pressure");
+
+		ImGui::NewLine();
+		ImGui::Text("Pass ranking:");
+		ImGui::SameLine();
+		if (ImGui::Button("Refresh##stats_rank"))
+			m_rankPasses();
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Stage cost x vertices/covered pixels/primitives - every draw other than a rectangle or a screen quad counts as a full render target");
+
+		if (ImGui::BeginTable("##stats_rank_table", 6, ImGuiTableFlags_Resizable | ImGuiTableFlags_BordersInner)) {
+			ImGui::TableSetupColumn("Pass", ImGuiTableColumnFlags_WidthFixed, 150.0f);
+			ImGui::TableSetupColumn("VS/CS cost", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+			ImGui::TableSetupColumn("PS/GS cost", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+			ImGui::TableSetupColumn("Invocations", ImGuiTableColumnFlags_WidthFixed, 150.0f);
+			ImGui::TableSetupColumn("Total", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+			ImGui::TableSetupColumn("Share", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableAutoHeaders();
+
+			for (const auto& ranked : m_ranking) {
+				const ShaderCostModel::Pass& pass = ranked.Cost;
+
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::Text("%s", ranked.Name.c_str());
+				ImGui::TableSetColumnIndex(1);
+				ImGui::Text("%.0f", pass.Stages[0].GetCost());
+				ImGui::TableSetColumnIndex(2);
+				if (pass.Compute)
+					ImGui::TextDisabled("-");
+				else
+					ImGui::Text("%.0f", pass.Stages[1].GetCost() + pass.Stages[2].GetCost());
+				ImGui::TableSetColumnIndex(3);
+				if (pass.Compute)
+					ImGui::Text("%.0f", pass.Invocations[0]);
+				else
+					ImGui::Text("%.0f / %.0f px", pass.Invocations[0], pass.Invocations[1]);
+				ImGui::TableSetColumnIndex(4);
+				ImGui::Text("%.3g", pass.Total);
+				ImGui::TableSetColumnIndex(5);
+				ImGui::Text("%.1f%%", m_rankingTotal > 0.0 ? pass.Total / m_rankingTotal * 100.0 : 0.0);
+			}
+
+			ImGui::EndTable();
+		}
+	}
+	void StatsPage::m_rankPasses()
+	{
+		m_ranking.clear();
+		m_rankingTotal = 0.0;
+
+		glm::ivec2 viewport = m_data->Renderer.GetLastRenderSize();
+		for (PipelineItem* item : m_data->Pipeline.GetList()) {
+			if (item->Type != PipelineItem::ItemType::ShaderPass && item->Type != PipelineItem::ItemType::ComputePass)
+				continue;
+
+			m_data->Renderer.RequireSPIRV(item);
+
+			RankedPass ranked;
+			ranked.Name = item->Name;
+			ranked.Cost = ShaderCostModel::EstimatePass(item, &m_data->Objects, viewport);
+			m_rankingTotal += ranked.Cost.Total;
+			m_ranking.push_back(ranked);
+		}
+
+		std::stable_sort(m_ranking.begin(), m_ranking.end(), [](const RankedPass& a, const RankedPass& b) {
+			return a.Cost.Total > b.Cost.Total;
+		});
+	}
+	void StatsPage::m_startProfiling()
+	{
+		m_profileOptimize = Settings::Instance().Project.OptimizeSPIRV;
+		m_profileTimers = m_data->Renderer.AreGPUTimersEnabled();
+		m_profileTime[0] = m_profileTime[1] = -1.0f;
+		m_profileStep = 1;
+
+		m_data->Renderer.EnableGPUTimers(true);
+		Settings::Instance().Project.OptimizeSPIRV = false;
+		m_data->Renderer.Recompile(m_item->Name);
+		m_data->Renderer.ResetGPUTimer(m_item);
+	}
+	void StatsPage::m_updateProfiling()
+	{
+		if (m_data->Renderer.GetGPUTimeSampleCount(m_item) < ProfileSamples)
+			return;
+
+		m_profileTime[m_profileStep - 1] = m_data->Renderer.GetGPUTime(m_item);
+
+		if (m_profileStep == 1) {
+			m_profileStep = 2;
+			Settings::Instance().Project.OptimizeSPIRV = true;
+			m_data->Renderer.Recompile(m_item->Name);
+			m_data->Renderer.ResetGPUTimer(m_item);
+		} else
+			m_stopProfiling();
+	}
+	void StatsPage::m_stopProfiling()
+	{
+		m_profileStep = 0;
+
+		Settings::Instance().Project.OptimizeSPIRV = m_profileOptimize;
+		m_data->Renderer.EnableGPUTimers(m_profileTimers);
+		m_data->Renderer.Recompile(m_item->Name);
+	}
+	void StatsPage::m_startComparison()
+	{
+		std::string source;
+		if (m_compareMode == 0) {
+			TextEditor* editor = ((CodeEditorUI*)m_ui->Get(ViewID::Code))->Get(m_item, m_stage);
+			if (editor != nullptr)
+				source = editor->GetText();
+		} else
+			source = m_data->Parser.LoadProjectFile(m_comparePath);
+
+		if (source.empty()) {
+			Logger::Get().Log("Nothing to compare with - the shader code is empty or the file couldn't be opened", true);
+			return;
+		}
+
+		m_data->Renderer.StartComparison(m_item, m_stage, "", source);
+	}
+	void StatsPage::m_renderComparison()
+	{
+		RenderEngine& renderer = m_data->Renderer;
+
+		if (renderer.GetComparisonItem() != m_item) {
+			ImGui::Text("A/B comparison - A: saved file, B:");
+			ImGui::SameLine();
+			ImGui::RadioButton("editor##stats_cmp_editor", &m_compareMode, 0);
+			ImGui::SameLine();
+			ImGui::RadioButton("other file##stats_cmp_file", &m_compareMode, 1);
+			if (m_compareMode == 1) {
+				ImGui::SameLine();
+				ImGui::PushItemWidth(-1);
+				ImGui::InputText("##stats_cmp_path", m_comparePath, SHADERED_MAX_PATH);
+				ImGui::PopItemWidth();
+			}
+
+			if (ImGui::Button("Compare##stats_cmp_start"))
+				m_startComparison();
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("Render both versions of this pass on alternating frames and compare their GPU time");
+			return;
+		}
+
+		RenderEngine::ComparisonResult result = renderer.GetComparisonResult();
+
+		if (result.Finished)
+			ImGui::Text("A/B comparison - done");
+		else
+			ImGui::Text("A/B comparison - measuring... A: %d, B: %d samples", result.Samples[0], result.Samples[1]);
+		ImGui::SameLine();
+		if (ImGui::Button("Stop##stats_cmp_stop")) {
+			renderer.StopComparison();
+			return;
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Check output##stats_cmp_check"))
+			renderer.RequestComparisonCheck();
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Render both versions once with the time stopped and compare the first render texture");
+
+		if (renderer.IsPaused() && !result.Finished)
+			ImGui::TextDisabled("The preview is paused - the pass is still rendered but the time doesn't change.");
+
+		if (ImGui::BeginTable("##stats_cmp_table", 3, ImGuiTableFlags_Resizable)) {
+			ImGui::TableSetupColumn("GPU time", ImGuiTableColumnFlags_WidthFixed, 150.0f);
+			ImGui::TableSetupColumn("A", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+			ImGui::TableSetupColumn("B", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableAutoHeaders();
+
+			const char* rowNames[] = { "Mean (ms)", "Median (ms)", "Std. deviation (ms)" };
+			for (int r = 0; r < 3; r++) {
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::Text("%s", rowNames[r]);
+				for (int v = 0; v < 2; v++) {
+					float value = r == 0 ? result.Mean[v] : (r == 1 ? result.Median[v] : sqrt(result.Variance[v]));
+					ImGui::TableSetColumnIndex(v + 1);
+					ImGui::Text("%.4f", value);
+				}
+			}
+
+			ImGui::EndTable();
+		}
+
+		// the difference only counts if the confidence interval doesn't contain zero
+		if (result.Samples[0] > 1 && result.Samples[1] > 1) {
+			float percent = result.Difference / std::max(result.Mean[0], 1e-6f) * 100.0f;
+			ImGui::Text("B - A: %+.4f ms (%+.1f%%), 95%% interval: [%+.4f, %+.4f] ms", result.Difference, percent, result.Difference - result.Confidence, result.Difference + result.Confidence);
+			if (std::abs(result.Difference) <= result.Confidence)
+				ImGui::Text("No significant difference");
+			else
+				ImGui::Text("B is %s", result.Difference < 0.0f ? "faster" : "slower");
+		}
+
+		if (result.Checked) {
+			if (result.DifferentPixels == 0)
+				ImGui::Text("Output: identical");
+			else
+				ImGui::Text("Output: %d pixels differ, max error: %.6f", result.DifferentPixels, result.MaxError);
+		}
 	}
-}
\ No newline at end of file
+}
@@ -1,7 +1,8 @@
 #pragma once
 #include <SHADERed/InterfaceManager.h>
 #include <SHADERed/UI/UIView.h>
-#include <SHADERed/Objects/SPIRVParser.h>
+#include <SHADERed/Objects/SPIRVReflectionCache.h>
+#include <SHADERed/Objects/ShaderCostModel.h>
 #include <ImGuiColorTextEdit/TextEditor.h>
 
 namespace ed {
@@ -11,6 +12,17 @@ namespace ed {
 				: UIView(ui, objects, name, visible)
 		{
 			m_spirv.SetReadOnly(true);
+			m_info = m_infoOpt = SPIRVReflectionCache::Instance().Get(std::vector<unsigned int>());
+			m_item = nullptr;
+			m_stage = ShaderStage::Vertex;
+			m_compareMode = 0;
+			m_comparePath[0] = 0;
+			m_rankingTotal = 0.0;
+			m_showOptimized = false;
+			m_profileStep = 0;
+			m_profileOptimize = false;
+			m_profileTimers = false;
+			m_profileTime[0] = m_profileTime[1] = -1.0f;
 		}
 
 		virtual void OnEvent(const SDL_Event& e);
@@ -19,9 +31,39 @@ namespace ed {
 		void Refresh(PipelineItem* item, ShaderStage stage);
 
 	private:
-		SPIRVParser m_info;
+		std::shared_ptr<const SPIRVParser> m_info, m_infoOpt; // original & optimized SPIR-V
 		TextEditor m_spirv;
 
-		std::vector<unsigned int> m_spv;
+		PipelineItem* m_item;
+		ShaderStage m_stage;
+		std::vector<unsigned int> m_spv, m_spvOpt;
+		std::string m_disassembly, m_disassemblyOpt;
+		bool m_showOptimized;
+		void m_setDisassembly();
+
+		// static cost estimates of the selected stage & of every pass
+		struct RankedPass {
+			std::string Name;
+			ShaderCostModel::Pass Cost;
+		};
+		ShaderCostModel::Stage m_cost;
+		std::vector<RankedPass> m_ranking;
+		double m_rankingTotal;
+		void m_renderCost();
+		void m_rankPasses();
+
+		// GPU time of the pass with the optimizer turned off (0) and on (1)
+		int m_profileStep; // 0 -> not profiling, 1 -> unoptimized, 2 -> optimized
+		bool m_profileOptimize, m_profileTimers; // values to restore
+		float m_profileTime[2];
+		void m_startProfiling();
+		void m_updateProfiling();
+		void m_stopProfiling();
+
+		// A/B comparison of the saved file and the editor buffer (0) or another file (1)
+		int m_compareMode;
+		char m_comparePath[SHADERED_MAX_PATH];
+		void m_startComparison();
+		void m_renderComparison();
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,83 @@
+#include <SHADERed/Objects/MessageStack.h>
+#include <TestHelper.h>
+
+using namespace ed;
+
+static void testSingleRepeat()
+{
+	MessageStack msgs;
+	msgs.Add(MessageStack::Type::Error, "Simple", "undeclared identifier", 4, ShaderStage::Pixel);
+	msgs.Add(MessageStack::Type::Error, "Simple", "undeclared identifier", 4, ShaderStage::Pixel);
+	msgs.Add(MessageStack::Type::Error, "Simple", "undeclared identifier", 5, ShaderStage::Pixel);
+
+	TEST_CHECK(msgs.GetMessages().size() == 2);
+	TEST_CHECK(msgs.GetMessages()[0].Repeat == 2);
+	TEST_CHECK(msgs.GetMessages()[1].Repeat == 1);
+	TEST_CHECK(msgs.GetGroupErrorAndWarningMsgCount("Simple") == 2);
+}
+static void testBatchRepeat()
+{
+	// messages collected on a worker thread are already merged
+	MessageStack worker;
+	for (int i = 0; i < 3; i++)
+		worker.Add(MessageStack::Type::Warning, "Simple", "implicit truncation", 10, ShaderStage::Vertex);
+	TEST_CHECK(worker.GetMessages().size() == 1);
+	TEST_CHECK(worker.GetMessages()[0].Repeat == 3);
+
+	MessageStack msgs;
+	msgs.Add(MessageStack::Type::Warning, "Simple", "implicit truncation", 10, ShaderStage::Vertex);
+	msgs.Add(worker.GetMessages());
+
+	TEST_CHECK(msgs.GetMessages().size() == 1);
+	TEST_CHECK(msgs.GetMessages()[0].Repeat == 4);
+	TEST_CHECK(msgs.GetGroupWarningMsgCount("Simple") == 1);
+
+	// into an empty stack
+	MessageStack copy;
+	copy.Add(worker.GetMessages());
+	TEST_CHECK(copy.GetMessages().size() == 1);
+	TEST_CHECK(copy.GetMessages()[0].Repeat == 3);
+}
+static void testGroupCap()
+{
+	MessageStack msgs;
+	for (int i = 0; i < MessageStack::MaxGroupMessages + 10; i++)
+		msgs.Add(MessageStack::Type::Error, "Include", "syntax error", i);
+
+	// stored messages + the summary
+	TEST_CHECK(msgs.GetMessages().size() == MessageStack::MaxGroupMessages + 1);
+	TEST_CHECK(msgs.GetMessages().back().MType == MessageStack::Type::Message);
+	TEST_CHECK(msgs.GetGroupErrorAndWarningMsgCount("Include") == MessageStack::MaxGroupMessages + 10);
+	TEST_CHECK(!msgs.CanRenderPreview());
+
+	msgs.ClearGroup("Include");
+	TEST_CHECK(msgs.GetMessages().empty());
+	TEST_CHECK(msgs.CanRenderPreview());
+}
+static void testClearType()
+{
+	MessageStack msgs;
+	msgs.Add(MessageStack::Type::Error, "A", "error");
+	msgs.Add(MessageStack::Type::Warning, "A", "warning");
+	msgs.Add(MessageStack::Type::Error, "B", "error");
+
+	msgs.ClearGroup("A", (int)MessageStack::Type::Error);
+	TEST_CHECK(msgs.GetMessages().size() == 2);
+	TEST_CHECK(msgs.GetGroupWarningMsgCount("A") == 1);
+	TEST_CHECK(msgs.GetErrorAndWarningMsgCount() == 2);
+
+	// lookup still works after the messages were moved
+	msgs.Add(MessageStack::Type::Error, "B", "error");
+	TEST_CHECK(msgs.GetMessages().size() == 2);
+	TEST_CHECK(msgs.GetMessages()[1].Repeat == 2);
+}
+
+int main()
+{
+	testSingleRepeat();
+	testBatchRepeat();
+	testGroupCap();
+	testClearType();
+
+	return TEST_RESULT();
+}
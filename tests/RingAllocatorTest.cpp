@@ -0,0 +1,127 @@
+#include <SHADERed/Objects/RingAllocator.h>
+#include <TestHelper.h>
+
+#include <set>
+#include <vector>
+
+using namespace ed;
+
+static const size_t MB = 1024 * 1024;
+
+// fences are numbers, the GPU finishes them when the test says so
+struct FakeGPU {
+	std::set<size_t> Signaled;
+	std::vector<size_t> Waits;
+	std::vector<size_t> Released;
+	bool FailWaits = false;
+
+	void Attach(RingAllocator& ring)
+	{
+		ring.Poll = [&](void* fence, bool wait) -> bool {
+			size_t id = (size_t)fence;
+			if (Signaled.count(id))
+				return true;
+			if (!wait)
+				return false;
+
+			Waits.push_back(id);
+			if (FailWaits)
+				return false;
+			Signaled.insert(id);
+			return true;
+		};
+		ring.Release = [&](void* fence) {
+			Released.push_back((size_t)fence);
+		};
+	}
+};
+
+static void testAlignment()
+{
+	RingAllocator ring(8 * MB, 256);
+	FakeGPU gpu;
+	gpu.Attach(ring);
+
+	size_t a = 1, b = 1;
+	TEST_CHECK(ring.Allocate(100, a) && a == 0);
+	ring.Submit(a, 100, (void*)1);
+	TEST_CHECK(ring.Allocate(300, b) && b == 256);
+	ring.Submit(b, 300, (void*)2);
+	TEST_CHECK(ring.GetHead() == 768);
+
+	size_t c = 0;
+	TEST_CHECK(!ring.Allocate(0, c));
+	TEST_CHECK(!ring.Allocate(8 * MB + 1, c));
+	TEST_CHECK(gpu.Waits.empty());
+}
+static void testRetire()
+{
+	// finished regions are released on the next allocation, live ones that don't overlap are kept
+	RingAllocator ring(8 * MB, 256);
+	FakeGPU gpu;
+	gpu.Attach(ring);
+
+	size_t offset = 0;
+	ring.Allocate(MB, offset);
+	ring.Submit(offset, MB, (void*)1);
+	ring.Allocate(MB, offset);
+	ring.Submit(offset, MB, (void*)2);
+
+	gpu.Signaled.insert(1);
+	ring.Allocate(MB, offset);
+	TEST_CHECK(offset == 2 * MB);
+	TEST_CHECK(gpu.Released.size() == 1 && gpu.Released[0] == 1);
+	TEST_CHECK(ring.GetRegionCount() == 1);
+	TEST_CHECK(gpu.Waits.empty());
+}
+static void testWrapWaitsOnOverlap()
+{
+	// X = [6, 7) MB is still in flight, a 5 MB upload wraps to [0, 5) = Y - then a 3.5 MB upload
+	// wraps again and has to wait for Y even though X (submitted before Y) is still in flight
+	RingAllocator ring(8 * MB, 256);
+	FakeGPU gpu;
+	gpu.Attach(ring);
+
+	size_t offset = 0;
+	TEST_CHECK(ring.Allocate(6 * MB, offset) && offset == 0);
+	ring.Submit(offset, 6 * MB, (void*)1);
+	TEST_CHECK(ring.Allocate(MB, offset) && offset == 6 * MB);
+	ring.Submit(offset, MB, (void*)2); // X
+	gpu.Signaled.insert(1);
+
+	TEST_CHECK(ring.Allocate(5 * MB, offset) && offset == 0);
+	ring.Submit(offset, 5 * MB, (void*)3); // Y
+	TEST_CHECK(gpu.Waits.empty());
+
+	TEST_CHECK(ring.Allocate(7 * MB / 2, offset) && offset == 0);
+	TEST_CHECK(gpu.Waits.size() == 1 && gpu.Waits[0] == 3);
+	TEST_CHECK(ring.GetRegionCount() == 1); // X
+}
+static void testFailedWait()
+{
+	RingAllocator ring(8 * MB, 256);
+	FakeGPU gpu;
+	gpu.Attach(ring);
+
+	size_t offset = 0;
+	ring.Allocate(6 * MB, offset);
+	ring.Submit(offset, 6 * MB, (void*)1);
+
+	gpu.FailWaits = true;
+	TEST_CHECK(!ring.Allocate(4 * MB, offset));
+	TEST_CHECK(gpu.Released.size() == 1);
+	TEST_CHECK(ring.GetRegionCount() == 0);
+
+	ring.Clear();
+	TEST_CHECK(ring.GetHead() == 0);
+}
+
+int main()
+{
+	testAlignment();
+	testRetire();
+	testWrapWaitsOnOverlap();
+	testFailedWait();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,108 @@
+#include <SHADERed/Objects/SPIRVSpecialization.h>
+#include <TestHelper.h>
+
+#include <cstring>
+
+using namespace ed;
+
+static ShaderMacro makeMacro(const char* name, const char* value, bool active = true, bool specialize = true)
+{
+	ShaderMacro ret;
+	ret.Active = active;
+	strcpy(ret.Name, name);
+	strcpy(ret.Value, value);
+	ret.Specialize = specialize;
+	return ret;
+}
+
+static unsigned int op(unsigned int opcode, unsigned int count) { return (count << 16) | opcode; }
+
+/* %2 = bool type, %3 = int type
+	OpDecorate %10 SpecId 0 ; OpDecorate %11 SpecId 1 ; OpDecorate %12 SpecId 2
+	%10 = OpSpecConstant %3 7 ; %11 = OpSpecConstantTrue %2 ; %12 = OpSpecConstantFalse %2 */
+static std::vector<unsigned int> makeModule()
+{
+	return {
+		0x07230203, 0x00010500, 0, 20, 0,
+		op(71, 4), 10, 1, 0,
+		op(71, 4), 11, 1, 1,
+		op(71, 4), 12, 1, 2,
+		op(50, 4), 3, 10, 7,
+		op(48, 3), 2, 11,
+		op(49, 3), 2, 12
+	};
+}
+
+static void testIsSpecializable()
+{
+	TEST_CHECK(SPIRVSpecialization::IsSpecializable(makeMacro("A", "12")));
+	TEST_CHECK(SPIRVSpecialization::IsSpecializable(makeMacro("A", "-3")));
+	TEST_CHECK(SPIRVSpecialization::IsSpecializable(makeMacro("A", "true")));
+	TEST_CHECK(!SPIRVSpecialization::IsSpecializable(makeMacro("A", "1.5")));
+	TEST_CHECK(!SPIRVSpecialization::IsSpecializable(makeMacro("A", "-")));
+	TEST_CHECK(!SPIRVSpecialization::IsSpecializable(makeMacro("A", "")));
+	TEST_CHECK(!SPIRVSpecialization::IsSpecializable(makeMacro("A", "12", true, false)));
+}
+static void testDeclare()
+{
+	std::vector<ShaderMacro> macros = {
+		makeMacro("COUNT", "4"),
+		makeMacro("NAME", "x", true, false), // regular #define, doesn't take a SpecId
+		makeMacro("USE_FOG", "true", false)
+	};
+
+	TEST_CHECK(SPIRVSpecialization::Declare(macros, false) == "layout(constant_id = 0) const int COUNT = 4;\nlayout(constant_id = 1) const bool USE_FOG = false;\n");
+	TEST_CHECK(SPIRVSpecialization::Declare(macros, true) == "[[vk::constant_id(0)]] const int COUNT = 4;\n[[vk::constant_id(1)]] const bool USE_FOG = false;\n");
+}
+static void testApply()
+{
+	std::vector<ShaderMacro> macros = {
+		makeMacro("COUNT", "-2"),
+		makeMacro("NAME", "x", true, false),
+		makeMacro("USE_FOG", "false"),
+		makeMacro("USE_SHADOWS", "true")
+	};
+
+	std::vector<unsigned int> spv = makeModule();
+	SPIRVSpecialization::Apply(spv, macros);
+	TEST_CHECK(spv.size() == makeModule().size());
+	TEST_CHECK(spv[20] == (unsigned int)-2);
+	TEST_CHECK(spv[21] == op(49, 3));
+	TEST_CHECK(spv[24] == op(48, 3));
+
+	// inactive macros can't be undefined - they become 0/false
+	macros[0].Active = false;
+	macros[3].Active = false;
+	macros[2] = makeMacro("USE_FOG", "true");
+	SPIRVSpecialization::Apply(spv, macros);
+	TEST_CHECK(spv[20] == 0);
+	TEST_CHECK(spv[21] == op(48, 3));
+	TEST_CHECK(spv[24] == op(49, 3));
+}
+static void testMalformed()
+{
+	std::vector<ShaderMacro> macros = { makeMacro("COUNT", "5") };
+
+	// truncated instruction - the module is left as it is
+	std::vector<unsigned int> spv = makeModule();
+	spv.resize(20);
+	std::vector<unsigned int> copy = spv;
+	SPIRVSpecialization::Apply(spv, macros);
+	TEST_CHECK(spv == copy);
+
+	// SpecId without a macro
+	spv = makeModule();
+	SPIRVSpecialization::Apply(spv, macros);
+	TEST_CHECK(spv[20] == 5);
+	TEST_CHECK(spv[21] == op(48, 3));
+}
+
+int main()
+{
+	testIsSpecializable();
+	testDeclare();
+	testApply();
+	testMalformed();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdio>
+
+// minimal checks - a failed check is printed and the test returns a non-zero exit code
+static int testFailures = 0;
+
+#define TEST_CHECK(cond)                                                         \
+	do {                                                                         \
+		if (!(cond)) {                                                           \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);       \
+			testFailures++;                                                      \
+		}                                                                        \
+	} while (0)
+
+#define TEST_RESULT() (testFailures == 0 ? 0 : 1)
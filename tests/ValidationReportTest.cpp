@@ -0,0 +1,94 @@
+#include <SHADERed/Objects/ValidationReport.h>
+#include <TestHelper.h>
+
+using namespace ed;
+
+static ValidationReport::Stage makeStage(bool passed, const std::string& skipped = "")
+{
+	ValidationReport::Stage ret;
+	ret.Type = ShaderStage::Pixel;
+	ret.Language = ShaderLanguage::HLSL;
+	ret.Path = "shaders/Simple.hlsl";
+	ret.Entry = "main";
+	ret.Skipped = skipped;
+	ret.Passed = passed;
+	return ret;
+}
+static ValidationReport::Project makeProject(const std::string& path, const std::vector<ValidationReport::Stage>& stages)
+{
+	ValidationReport::Pass pass;
+	pass.Name = "Simple";
+	pass.Type = "shader";
+	pass.Stages = stages;
+
+	ValidationReport::Project ret;
+	ret.Path = path;
+	ret.Passes.push_back(pass);
+	ret.Time = 0.0f;
+	return ret;
+}
+
+static void testEmpty()
+{
+	ValidationReport report;
+	TEST_CHECK(report.GetFailedCount() == 0);
+	TEST_CHECK(report.GetExitCode() == 0);
+	TEST_CHECK(report.ToJSON().find("\"projects\": 0, \"failed\": 0") != std::string::npos);
+}
+static void testPassed()
+{
+	// skipped stages (plugins, audio) don't fail the project
+	ValidationReport report;
+	report.Projects.push_back(makeProject("a.sprj", { makeStage(true), makeStage(false, "audio shaders are compiled by the audio stream") }));
+
+	TEST_CHECK(!ValidationReport::IsFailed(report.Projects[0]));
+	TEST_CHECK(report.GetExitCode() == 0);
+	TEST_CHECK(report.ToJSON().find("\"status\": \"skipped\"") != std::string::npos);
+}
+static void testFailedStage()
+{
+	ValidationReport report;
+	report.Projects.push_back(makeProject("a.sprj", { makeStage(true) }));
+	report.Projects.push_back(makeProject("b.sprj", { makeStage(true), makeStage(false) }));
+	report.Projects.push_back(makeProject("c.sprj", { makeStage(false), makeStage(false) }));
+
+	TEST_CHECK(report.GetFailedCount() == 2);
+	TEST_CHECK(report.GetExitCode() == 1);
+}
+static void testUnreadableProject()
+{
+	ValidationReport report;
+	report.Projects.push_back(makeProject("a.sprj", {}));
+	report.Projects[0].Error = "Failed to parse the project file: \"no document element\"";
+
+	TEST_CHECK(ValidationReport::IsFailed(report.Projects[0]));
+	TEST_CHECK(report.GetExitCode() == 1);
+	TEST_CHECK(report.ToJSON().find("\"error\": \"Failed to parse the project file: \\\"no document element\\\"\"") != std::string::npos);
+}
+static void testDiagnostics()
+{
+	ValidationReport::Stage stage = makeStage(false);
+	MessageStack::Message msg;
+	msg.MType = MessageStack::Type::Error;
+	msg.Line = 12;
+	msg.Text = "'x' : undeclared identifier\n\tnear \"return\"";
+	stage.Messages.push_back(msg);
+
+	ValidationReport report;
+	report.Projects.push_back(makeProject("a.sprj", { stage }));
+
+	std::string json = report.ToJSON();
+	TEST_CHECK(json.find("{ \"type\": \"error\", \"line\": 12, \"message\": \"'x' : undeclared identifier\\n\\tnear \\\"return\\\"\" }") != std::string::npos);
+	TEST_CHECK(json.find("\"errors\": 1") != std::string::npos);
+}
+
+int main()
+{
+	testEmpty();
+	testPassed();
+	testFailedStage();
+	testUnreadableProject();
+	testDiagnostics();
+
+	return TEST_RESULT();
+}